@@ -0,0 +1,88 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file merge_partials.cc
+ * \brief Program executable for merging the partial aggregates of time shards
+ *
+ * Combines the partial aggregates written by `process_logs --partial` -- e.g.
+ * by several processes, each handling a different time shard of the same log
+ * -- into the exact maximum number of visitors and the corresponding time
+ * intervals for the log as a whole.
+ */
+
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <DateTime.h>
+#include <IntervalSet.h>
+#include <PartialAggregate.h>
+
+//______________________________________________________________________________
+//                                                                    show_usage
+
+/*!
+ * \brief Show help with usage instructions
+ * \param name -- Name of/path to the programm executable.
+ */
+void show_usage (std::string name)
+{
+    std::cerr << std::endl;
+    std::cerr << "Usage: " <<std::endl;
+    std::cerr << "\t" << name << " <partial> [<partial> ...]" << std::endl;
+    std::cerr << std::endl;
+    std::cerr << "The partial aggregates are required to cover adjacent time"
+              << " shards; they may be listed in any order." << std::endl;
+    std::cerr << std::endl;
+}
+
+//______________________________________________________________________________
+//                                                                          main
+
+/// Program main function
+int main (int argc, char *argv[])
+{
+    if (argc < 2) {
+        show_usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<cgi::PartialAggregate> shards;
+
+    try {
+        for (int n=1; n<argc; ++n) {
+            std::ifstream infile (argv[n]);
+            if (!infile.is_open()) {
+                std::cerr << "Error opening: " << argv[n] << "\n";
+                return 1;
+            }
+            shards.push_back(cgi::PartialAggregate::read(infile));
+        }
+
+        cgi::PartialAggregate result = cgi::PartialAggregate::merge(shards);
+        cgi::IntervalSet<std::int64_t,int> intervals = result.maxIntervals();
+
+        std::cout << "--> Merged " << shards.size() << " partial aggregates" << std::endl;
+
+        std::cout << "\n Maximum number of visitors:" << std::endl;
+
+        for (auto it=intervals.begin(); it!=intervals.end(); ++it) {
+            std::cout << cgi::DateTime(std::time_t(it->begin())).asString("%H:%M")
+                      << " ... "
+                      << cgi::DateTime(std::time_t(it->end())).asString("%H:%M")
+                      << "  =>  "
+                      << it->value()
+                      << std::endl;
+        }
+    } catch (const char* message) {
+        std::cerr << message << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#-------------------------------------------------------------------------------
+# (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.
+# This software is distributed under the BSD 2-clause license.
+#-------------------------------------------------------------------------------
+
+# Split the log into time shards, process each shard in a separate process and
+# check that merging the partial aggregates reproduces the maximum number of
+# visitors reported for the log as a whole.
+#
+# Variables: PROCESS_LOGS, MERGE_PARTIALS (executables), LOGFILE (input log),
+# WORKDIR (directory for the partial aggregates).
+
+set (shards "--to=10:00" "--from=10:00|--to=12:00" "--from=12:00")
+get_filename_component (logname ${LOGFILE} NAME_WE)
+set (partials)
+set (n 0)
+
+foreach (shard ${shards})
+    set (partial ${WORKDIR}/${logname}-partial-${n}.txt)
+    string (REPLACE "|" ";" shard_args "${shard}")
+    execute_process (
+      COMMAND ${PROCESS_LOGS} ${shard_args} --partial ${partial} ${LOGFILE}
+      RESULT_VARIABLE status
+      )
+    if (NOT status EQUAL 0)
+        message (FATAL_ERROR "process_logs failed for shard ${shard}")
+    endif ()
+    list (APPEND partials ${partial})
+    math (EXPR n "${n}+1")
+endforeach ()
+
+execute_process (
+  COMMAND ${MERGE_PARTIALS} ${partials}
+  OUTPUT_VARIABLE merged
+  RESULT_VARIABLE status
+  )
+if (NOT status EQUAL 0)
+    message (FATAL_ERROR "merge_partials failed")
+endif ()
+
+execute_process (
+  COMMAND ${PROCESS_LOGS} ${LOGFILE}
+  OUTPUT_VARIABLE expected
+  RESULT_VARIABLE status
+  )
+
+# Compare the section with the maximum number of visitors
+foreach (var merged expected)
+    string (FIND "${${var}}" "Maximum number of visitors:" pos)
+    if (pos LESS 0)
+        message (FATAL_ERROR "No maximum reported in output:\n${${var}}")
+    endif ()
+    string (SUBSTRING "${${var}}" ${pos} -1 ${var})
+endforeach ()
+
+if (NOT merged STREQUAL expected)
+    message (FATAL_ERROR "Merged partials differ:\n${merged}\nexpected:\n${expected}")
+endif ()
+
+message (STATUS "${merged}")
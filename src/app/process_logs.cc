@@ -12,17 +12,39 @@
  */
 
 #include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <sstream>
 #include <set>
 #include <string>
 #include <vector>
+#include <fcntl.h>
 #include <getopt.h>
+#include <unistd.h>
 
+#include <ExternalSort.h>
+#include <GroupOccupancy.h>
 #include <LogData.h>
+#include <LogEntryView.h>
+#include <OccupancyBins.h>
+#include <OccupancyDiff.h>
+#include <OccupancySweep.h>
+#include <PartialAggregate.h>
+#include <QueryServer.h>
+#include <ResultCache.h>
+#include <ThreadPool.h>
+#include <TimelineWriter.h>
+#include <TimeIndex.h>
 #include <TimePoint.h>
+#include <TimeWindow.h>
 #include <Interval.h>
+#include <IntervalSet.h>
 
 //______________________________________________________________________________
 //                                                                    show_usage
@@ -43,7 +65,42 @@ void show_usage (std::string name)
     std::cerr << "\t" << name << " [options] <path-to-logfile>" << std::endl;
     std::cerr << std::endl;
     std::cerr << "Options:" << std::endl;
-    std::cerr << "\t-H,--help\t= Print usage information and exit." << std::endl;
+    std::cerr << "\t-H,--help\t\t= Print usage information and exit." << std::endl;
+    std::cerr << "\t-q,--queries <file>\t= Report the number of visitors at the"
+              << " times listed in <file> (one per line)." << std::endl;
+    std::cerr << "\t-d,--diff <file>\t= Compare the occupancy against the log"
+              << " in <file>." << std::endl;
+    std::cerr << "\t-x,--external\t\t= Sort events out-of-core, for logs larger"
+              << " than memory." << std::endl;
+    std::cerr << "\t-m,--memory <MiB>\t= Memory budget for --external"
+              << " (default: 64)." << std::endl;
+    std::cerr << "\t-g,--group <n>\t\t= Report the maximum number of visitors"
+              << " per category of the n-th additional column." << std::endl;
+    std::cerr << "\t-f,--from <time>\t= Only consider visits after <time>"
+              << " (HH:MM[:SS] or ISO 8601)." << std::endl;
+    std::cerr << "\t-t,--to <time>\t\t= Only consider visits before <time>"
+              << " (HH:MM[:SS] or ISO 8601)." << std::endl;
+    std::cerr << "\t-i,--index\t\t= Build (if out of date) and use a sparse"
+              << " time index next to the log, to speed up --from/--to." << std::endl;
+    std::cerr << "\t-p,--partial <file>\t= Write the partial aggregate for the"
+              << " --from/--to shard to <file>, see merge_partials." << std::endl;
+    std::cerr << "\t-s,--serve <socket>\t= Keep the log in memory and answer"
+              << " queries (MAX, AT, RANGE, INFO) on a Unix socket." << std::endl;
+    std::cerr << "\t-S,--snapshot <file>\t= With --serve, start from the snapshot"
+              << " in <file> if up to date, else save one there." << std::endl;
+    std::cerr << "\t-j,--threads <n>\t= Number of threads to use (default: number"
+              << " of hardware threads)." << std::endl;
+    std::cerr << "\t-c,--cache <dir>\t= Keep results in <dir>, skipping the"
+              << " processing of logs seen before." << std::endl;
+    std::cerr << "\t-C,--cache-size <MiB>\t= Size limit for --cache"
+              << " (default: 256)." << std::endl;
+    std::cerr << "\t-b,--bin <duration>\t= Report the minimum, mean and maximum"
+              << " number of visitors per time bin (e.g. 60, 15m, 1h)." << std::endl;
+    std::cerr << "\t-F,--format <format>\t= Format of the statistics: challenge"
+              << " (default), csv, json or binary; progress messages then go"
+              << " to the standard error." << std::endl;
+    std::cerr << "\t-o,--output <file>\t= Write the statistics to <file> instead"
+              << " of the standard output." << std::endl;
     std::cerr << std::endl;
 }
 
@@ -54,44 +111,169 @@ void show_usage (std::string name)
  * \brief Show visitor statistics, i.e. nof. visitors per time interval
  * \param visitorsPerTime -- Array of time-points, storing the number of visitor
  *                           at a given point in time.
- * \param visitorsMax     -- Array of intervals, storing the time-intervals during
+ * \param visitorsMax     -- Set of intervals, storing the time-intervals during
  *                           which there was the maximum number of visitors (keep
  *                           in mind that we might have multiple maxima).
+ * \param format          -- Output format.
+ * \param fd              -- File descriptor to write to.
  * \param timeformat      -- Format specification for the time information.
+ * \return `true` if all output has been written successfully.
  */
-void show_statistics (const std::vector<cgi::TimePoint>& visitorsPerTime,
-                      const std::vector<cgi::Interval<cgi::DateTime,int> > visitorsMax,
+bool show_statistics (const std::vector<cgi::TimePoint>& visitorsPerTime,
+                      const cgi::IntervalSet<cgi::DateTime,int>& visitorsMax,
+                      const cgi::TimelineWriter::Format& format=cgi::TimelineWriter::Challenge,
+                      const int& fd=STDOUT_FILENO,
                       const std::string& timeformat="%H:%M")
 {
-    /* ------------------------------------------------------------ */
-    /*  Output 1 : Number of visitors per time interval             */
+    /* Anything written to std::cout so far goes first */
+    std::cout.flush();
 
-    std::cout << "\n Visitors per time interval:" << std::endl;
+    cgi::OutputBuffer output (fd);
+    cgi::TimelineWriter writer (output, format, timeformat);
 
-    for (auto it = visitorsPerTime.begin(), next=visitorsPerTime.begin()+1;
-         it!=visitorsPerTime.end()-1;
-         ++it, ++next) {
-        std::cout << "\t" << it->time().asString(timeformat)
-                  << "-"  << next->time().asString(timeformat)
-                  << ";"  << it->count()
-                  << std::endl;
+    writer.write(visitorsPerTime, visitorsMax);
+    output.flush();
+
+    return output.good();
+}
+
+//______________________________________________________________________________
+//                                                                     show_bins
+
+/*!
+ * \brief Show visitor statistics, downsampled to time bins
+ * \param bins        -- Minimum, mean and maximum number of visitors per bin.
+ * \param visitorsMax -- Set of intervals, storing the time-intervals during
+ *                       which there was the maximum number of visitors.
+ * \param format      -- Output format.
+ * \param fd          -- File descriptor to write to.
+ * \return `true` if all output has been written successfully.
+ */
+bool show_bins (const cgi::OccupancyBins& bins,
+                const cgi::IntervalSet<cgi::DateTime,int>& visitorsMax,
+                const cgi::TimelineWriter::Format& format,
+                const int& fd)
+{
+    /* Anything written to std::cout so far goes first */
+    std::cout.flush();
+
+    cgi::OutputBuffer output (fd);
+    cgi::TimelineWriter writer (output, format);
+
+    writer.write(bins, visitorsMax);
+    output.flush();
+
+    return output.good();
+}
+
+//______________________________________________________________________________
+//                                                                 clip_timeline
+
+/*!
+ * \brief Restrict the number of visitors per point in time to a time window
+ * \param visitorsPerTime -- Array of time-points, storing the number of visitor
+ *                           at a given point in time.
+ * \param window          -- Time window to restrict the time-points to.
+ * \return Time-points within the window; if bounded, the edges of the window
+ *         are included as time-points.
+ */
+std::vector<cgi::TimePoint> clip_timeline (const std::vector<cgi::TimePoint>& visitorsPerTime,
+                                           const cgi::TimeWindow& window)
+{
+    std::vector<cgi::TimePoint> result;
+    auto it = visitorsPerTime.begin();
+
+    if (window.hasBegin()) {
+        cgi::DateTime from (std::time_t(window.begin()));
+        int current = 0;
+        for (; it!=visitorsPerTime.end() && !(from < it->time()); ++it) {
+            current = it->count();
+        }
+        result.push_back(cgi::TimePoint(from, current));
+    }
+
+    cgi::DateTime to (std::time_t(window.end()));
+    for (; it!=visitorsPerTime.end() && (!window.hasEnd() || it->time() < to); ++it) {
+        result.push_back(*it);
     }
 
-    /* ------------------------------------------------------------ */
-    /*  Output 2 : maximum number of visitors and corresponding     */
-    /*             time interval(s)                                 */
+    if (window.hasEnd()) {
+        result.push_back(cgi::TimePoint(to, 0));
+    }
+
+    return result;
+}
 
-    std::cout << "\n Maximum number of visitors:" << std::endl;
+//______________________________________________________________________________
+//                                                                    show_range
 
-    for (auto n: visitorsMax) {
-        std::cout << n.begin().asString("%H:%M")
-                  << " ... "
-                  << n.end().asString("%H:%M")
-                  << "  =>  "
-                  << n.value()
+/*!
+ * \brief Show the range of times covered by a sweep along the events
+ * \param sweep -- Outcome of the sweep.
+ */
+void show_range (const cgi::OccupancySweep& sweep)
+{
+    if (!sweep.timeline().empty()) {
+        std::cout << "--> Range of times = "
+                  << sweep.timeline().front().time() << " ... "
+                  << sweep.timeline().back().time()
                   << std::endl;
     }
+}
+
+//______________________________________________________________________________
+//                                                                    show_sweep
+
+/*!
+ * \brief Show visitor statistics from a sweep along the events
+ * \param sweep  -- Outcome of the sweep.
+ * \param window -- Time window to which to restrict the statistics.
+ * \param format -- Output format.
+ * \param fd     -- File descriptor to write to.
+ * \param bins   -- Time bins filled along with the sweep, if downsampling.
+ * \return `true` if all output has been written successfully.
+ */
+bool show_sweep (const cgi::OccupancySweep& sweep,
+                 const cgi::TimeWindow& window,
+                 const cgi::TimelineWriter::Format& format,
+                 const int& fd,
+                 const cgi::OccupancyBins* bins=NULL)
+{
+    cgi::IntervalSet<cgi::DateTime,int> visitorsMax
+        = sweep.maxIntervals().clip(cgi::DateTime(std::time_t(window.begin())),
+                                    cgi::DateTime(std::time_t(window.end())));
+
+    if (bins != NULL) {
+        return show_bins(*bins, visitorsMax, format, fd);
+    } else {
+        return show_statistics(clip_timeline(sweep.timeline(), window), visitorsMax, format, fd);
+    }
+}
+
+//______________________________________________________________________________
+//                                                                  close_output
+
+/*!
+ * \brief Close the output of the plain statistics, reporting any failure
+ * \param fd     -- File descriptor written to.
+ * \param output -- Name of the output file; empty for the standard output.
+ * \param good   -- Has all output been written successfully?
+ * \return Exit status of the program.
+ */
+int close_output (const int& fd,
+                  const std::string& output,
+                  bool good)
+{
+    if (fd != STDOUT_FILENO && close(fd) != 0) {
+        good = false;
+    }
+
+    if (!good) {
+        std::cerr << "Error writing: " << (output.empty() ? "standard output" : output) << "\n";
+        return 1;
+    }
 
+    return 0;
 }
 
 //______________________________________________________________________________
@@ -100,50 +282,330 @@ void show_statistics (const std::vector<cgi::TimePoint>& visitorsPerTime,
 /*!
  * \brief Process visitor log to extra statistics
  * \param data -- Set (i.e. ordered list) of log entries to process.
+ * \param bins -- Time bins to fill in the same pass, if downsampling.
+ * \return Outcome of the sweep along the events, see show_sweep().
  */
-void process_logs (const cgi::LogData& data)
+cgi::OccupancySweep process_logs (const cgi::LogData& data,
+                                  cgi::OccupancyBins* bins=NULL)
 {
-    auto map_tp = data.entranceTimepoints ();
-    int count   = 0;
-    std::vector<cgi::TimePoint> result;
+    const cgi::LogData::EventArray& events = data.sortedEvents();
+    cgi::OccupancySweep sweep;
+    sweep.setBins(bins);
+
+    /* Sum up events (entries vs. exits) per point in time, keeping track of
+       the time interval(s) with the maximum number of visitors. */
+    for (auto it=events.begin(); it!=events.end(); ++it) {
+        sweep.add(*it);
+    }
+    sweep.finish();
+
+    return sweep;
+}
+
+//______________________________________________________________________________
+//                                                         process_logs_external
+
+/*!
+ * \brief Process visitor log to extract statistics, using out-of-core sorting
+ * \param filename     -- Name of the input file with the visitor log.
+ * \param memoryBudget -- Memory budget (in bytes) for sorting the events.
+ * \param window       -- Time window to which to restrict the statistics.
+ * \param bins         -- Time bins to fill in the same pass, if downsampling.
+ * \return Outcome of the sweep along the events, see show_sweep().
+ *
+ * Produces the same results as process_logs(), but without the need to keep
+ * the full visitor log in memory.
+ */
+cgi::OccupancySweep process_logs_external (const std::string& filename,
+                                           const std::size_t& memoryBudget,
+                                           const cgi::TimeWindow& window=cgi::TimeWindow(),
+                                           cgi::OccupancyBins* bins=NULL)
+{
+    cgi::ExternalSort sort (memoryBudget);
+    cgi::OccupancySweep sweep;
+    sweep.setBins(bins);
+
+    sort.setTimeWindow(window);
+
+    sort.readData(filename);
+    sort.merge([&sweep] (const cgi::Event& event) {
+            sweep.add(event);
+        });
+    sweep.finish();
+
+    show_range(sweep);
+
+    return sweep;
+}
+
+//______________________________________________________________________________
+//                                                                    parse_time
+
+/// Parse command line argument as point in time (HH:MM[:SS] or ISO 8601)
+bool parse_time (const char* arg,
+                 std::int64_t& result)
+{
+    const char* end = arg + std::strlen(arg);
+    if (!cgi::LogEntryView::isTime(arg, end)) {
+        return false;
+    }
+
+    result = cgi::LogEntryView::parseTime(arg, end, cgi::LogEntryView::startOfDay());
+
+    return true;
+}
+
+//______________________________________________________________________________
+//                                                               process_queries
 
-    /* Sum up events (entries vs. exists) per point in time. */
-    for (auto it = map_tp.begin();
-         it != map_tp.end();
-         it=map_tp.upper_bound(it->first))
-    {
-        for (auto iter = map_tp.lower_bound(it->first);
-             iter != map_tp.upper_bound(it->first);
-             ++iter)
-        {
-            count += iter->second;
+/*!
+ * \brief Report the number of visitors for a batch of points in time
+ * \param data       -- Set (i.e. ordered list) of log entries to process.
+ * \param filename   -- Name of the file with the points in time to evaluate,
+ *                      one per line (HH:MM[:SS] or ISO 8601).
+ * \return Status of the operation; returns non-zero in case of an error,
+ *         including lines which cannot be parsed as point in time.
+ *
+ * The results are written in the same order as the points in time are listed
+ * in the input file.
+ */
+int process_queries (const cgi::LogData& data,
+                     const std::string& filename)
+{
+    std::ifstream infile (filename);
+
+    if (!infile.is_open()) {
+        std::cerr << "Error opening: " << filename << "\n";
+        return 1;
+    }
+
+    std::vector<std::string> lines;
+    std::vector<cgi::DateTime> probes;
+    std::string line;
+    std::int64_t time = 0;
+    bool valid        = true;
+
+    while (std::getline(infile, line)) {
+        if (!line.empty() && line[line.size()-1] == '\r') {
+            line.resize(line.size()-1);
+        }
+        if (line.empty()) {
+            continue;
         }
-        result.push_back(cgi::TimePoint(it->first, count));
-        count = 0;
-    }
-
-    /* Determine max nof. visitors and visitors per time interval. */
-    std::vector<cgi::Interval<cgi::DateTime,int> > max;
-	int current_vistors = 0;
-    int visitors_max    = data.maxNofVisitors();
-    auto it_begin       = result.begin();
-    auto it_end         = result.begin();
-
-    for (auto it=result.begin(); it!=result.end(); ++it) {
-        current_vistors += it->count();
-        it->setCount(current_vistors);
-        // keep track of the maximum
-        if (current_vistors == visitors_max) {
-            it_end       = it;
-            it_begin     = it_end++;
-            max.push_back(cgi::Interval<cgi::DateTime,int>(it_begin->time(),
-                                                           it_end->time(),
-                                                           current_vistors));
+        if (!parse_time(line.c_str(), time)) {
+            std::cerr << "Invalid time: " << line << "\n";
+            valid = false;
+            continue;
         }
+        lines.push_back(line);
+        probes.push_back(cgi::DateTime(std::time_t(time)));
     }
 
-    /* Show visitor statistics */
-    show_statistics (result, max);
+    if (!valid) {
+        return 1;
+    }
+
+    std::vector<int> visitors = data.nofVisitors(probes);
+
+    std::cout << "\n Visitors at requested times:" << std::endl;
+
+    for (std::size_t n=0; n<visitors.size(); ++n) {
+        std::cout << "\t" << lines[n] << ";" << visitors[n] << "\n";
+    }
+    std::cout << std::flush;
+
+    return 0;
+}
+
+//______________________________________________________________________________
+//                                                                  process_diff
+
+/*!
+ * \brief Report the differences in occupancy between two visitor logs
+ * \param data       -- Set (i.e. ordered list) of log entries to process.
+ * \param other      -- Set of log entries to compare against.
+ * \param timeformat -- Format specification for the time information.
+ */
+void process_diff (const cgi::LogData& data,
+                   const cgi::LogData& other,
+                   const std::string& timeformat="%H:%M")
+{
+    cgi::OccupancyDiff diff (data, other);
+
+    std::cout << "\n Occupancy differences:" << std::endl;
+
+    for (auto it=diff.intervals().begin(); it!=diff.intervals().end(); ++it) {
+        std::cout << "\t" << it->begin().asString(timeformat)
+                  << "-"  << it->end().asString(timeformat)
+                  << ";"  << std::showpos << it->value() << std::noshowpos
+                  << "\n";
+    }
+
+    std::cout << "\n Summary:\n" << diff << std::flush;
+}
+
+//______________________________________________________________________________
+//                                                                 process_group
+
+/*!
+ * \brief Report the maximum number of visitors per category
+ * \param data       -- Set (i.e. ordered list) of log entries to process.
+ * \param column     -- Index of the additional column by which to group,
+ *                      counting from 1.
+ * \param window     -- Time window to which to restrict the statistics.
+ * \param timeformat -- Format specification for the time information.
+ * \return Status of the operation; returns non-zero in case of an error.
+ */
+int process_group (const cgi::LogData& data,
+                   const std::size_t& column,
+                   const cgi::TimeWindow& window=cgi::TimeWindow(),
+                   const std::string& timeformat="%H:%M")
+{
+    if (column < 1 || column > data.nofColumns()) {
+        std::cerr << "Invalid column: " << column
+                  << " (log has " << data.nofColumns() << " additional columns)\n";
+        return 1;
+    }
+
+    cgi::GroupOccupancy groups (data, column-1);
+
+    std::cout << "\n Maximum number of visitors per group:" << std::endl;
+
+    for (std::size_t n=0; n<groups.nofGroups(); ++n) {
+        cgi::IntervalSet<cgi::DateTime,int> intervals
+            = groups.maxIntervals(n).clip(cgi::DateTime(std::time_t(window.begin())),
+                                          cgi::DateTime(std::time_t(window.end())));
+        for (auto it=intervals.begin(); it!=intervals.end(); ++it) {
+            std::cout << "\t" << groups.name(n)
+                      << ";"  << it->begin().asString(timeformat)
+                      << "-"  << it->end().asString(timeformat)
+                      << ";"  << it->value()
+                      << "\n";
+        }
+    }
+    std::cout << std::flush;
+
+    return 0;
+}
+
+//______________________________________________________________________________
+//                                                               process_partial
+
+/*!
+ * \brief Write the partial aggregate for a time shard
+ * \param data     -- Set (i.e. ordered list) of log entries to process.
+ * \param filename -- Name of the output file for the partial aggregate.
+ * \param window   -- Time shard for which to compute the aggregate.
+ * \return Status of the operation; returns non-zero in case of an error.
+ */
+int process_partial (const cgi::LogData& data,
+                     const std::string& filename,
+                     const cgi::TimeWindow& window=cgi::TimeWindow())
+{
+    std::ofstream outfile (filename);
+
+    if (!outfile.is_open()) {
+        std::cerr << "Error opening: " << filename << "\n";
+        return 1;
+    }
+
+    cgi::PartialAggregate partial = data.partialAggregate(window);
+    partial.write(outfile);
+
+    std::cout << "--> Partial aggregate " << partial << std::endl;
+
+    return 0;
+}
+
+//______________________________________________________________________________
+//                                                                 process_serve
+
+/// Server to stop upon SIGINT/SIGTERM
+static cgi::QueryServer* server_running = NULL;
+
+/// Signal handler, stopping the server
+extern "C" void stop_server (int)
+{
+    if (server_running != NULL) {
+        server_running->stop();
+    }
+}
+
+/*!
+ * \brief Serve occupancy queries for the visitor log, until interrupted
+ * \param filename -- Name of the input file with the visitor log.
+ * \param path     -- Path of the Unix domain socket to serve on.
+ * \param window   -- Time window to which to restrict the log data.
+ * \param snapshot -- Name of the snapshot file to start from; empty if none.
+ * \return Status of the operation; returns non-zero in case of an error.
+ */
+int process_serve (const std::string& filename,
+                   const std::string& path,
+                   const cgi::TimeWindow& window=cgi::TimeWindow(),
+                   const std::string& snapshot="")
+{
+    cgi::QueryServer server (filename, window, 1000, snapshot);
+
+    server_running = &server;
+    std::signal(SIGINT, stop_server);
+    std::signal(SIGTERM, stop_server);
+
+    std::cout << "--> Serving queries on " << path << std::endl;
+    int status = server.serve(path);
+
+    server_running = NULL;
+
+    return status;
+}
+
+//______________________________________________________________________________
+//                                                                parse_duration
+
+/// Parse command line argument as duration in seconds, with optional unit (s, m, h)
+std::int64_t parse_duration (const char* arg)
+{
+    char* unit            = NULL;
+    std::int64_t duration = std::strtoll(arg, &unit, 10);
+
+    // The unit, if any, has to be the last character
+    if (unit == arg || (*unit != '\0' && unit[1] != '\0')) {
+        return 0;
+    }
+
+    switch (*unit) {
+    case 'h':
+        return duration*3600;
+    case 'm':
+        return duration*60;
+    case 's':
+    case '\0':
+        return duration;
+    default:
+        return 0;
+    };
+}
+
+//______________________________________________________________________________
+//                                                                 cache_options
+
+/*!
+ * \brief Describe the options affecting the outcome of processing a log
+ * \param window -- Time window to which to restrict the statistics.
+ * \return Description, to be combined with the contents of the log into the
+ *         key for a cgi::ResultCache.
+ *
+ * Besides the time window this includes the start of the day to which times
+ * of day are referring, as the same log yields different points in time on
+ * different days, and the resolution of the clock.
+ */
+std::string cache_options (const cgi::TimeWindow& window)
+{
+    std::ostringstream os;
+    os << "from=" << window.begin()
+       << " to=" << window.end()
+       << " day=" << cgi::LogEntryView::startOfDay()
+       << " ticks=" << cgi::LogData::clock_type::ticksPerSecond;
+    return os.str();
 }
 
 //______________________________________________________________________________
@@ -152,14 +614,228 @@ void process_logs (const cgi::LogData& data)
 /// Program main function
 int main (int argc, char *argv[])
 {
+    std::string queries;
+    std::string diff;
+    bool external            = false;
+    std::size_t memoryBudget = 64;
+    std::size_t group        = 0;
+    cgi::TimeWindow window;
+    bool index               = false;
+    std::string partial;
+    std::string serve;
+    std::string snapshot;
+    std::string cacheDirectory;
+    std::size_t cacheSize    = 256;
+    cgi::TimelineWriter::Format format = cgi::TimelineWriter::Challenge;
+    std::string output;
+    std::int64_t binWidth    = 0;
+    std::int64_t time        = 0;
+
+    // Parse command line options
+    static struct option long_options[] = {
+        {"help",     no_argument,       0, 'H'},
+        {"queries",  required_argument, 0, 'q'},
+        {"diff",     required_argument, 0, 'd'},
+        {"external", no_argument,       0, 'x'},
+        {"memory",   required_argument, 0, 'm'},
+        {"group",    required_argument, 0, 'g'},
+        {"from",     required_argument, 0, 'f'},
+        {"to",       required_argument, 0, 't'},
+        {"index",    no_argument,       0, 'i'},
+        {"partial",  required_argument, 0, 'p'},
+        {"serve",    required_argument, 0, 's'},
+        {"snapshot", required_argument, 0, 'S'},
+        {"threads",  required_argument, 0, 'j'},
+        {"cache",    required_argument, 0, 'c'},
+        {"cache-size", required_argument, 0, 'C'},
+        {"bin",      required_argument, 0, 'b'},
+        {"format",   required_argument, 0, 'F'},
+        {"output",   required_argument, 0, 'o'},
+        {0, 0, 0, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "Hq:d:xm:g:f:t:ip:s:S:j:c:C:b:F:o:", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 'H':
+            show_usage(argv[0]);
+            return 0;
+        case 'q':
+            queries = optarg;
+            break;
+        case 'd':
+            diff = optarg;
+            break;
+        case 'x':
+            external = true;
+            break;
+        case 'm':
+            memoryBudget = std::strtoul(optarg, NULL, 10);
+            break;
+        case 'g':
+            group = std::strtoul(optarg, NULL, 10);
+            break;
+        case 'f':
+        case 't':
+            if (!parse_time(optarg, time)) {
+                std::cerr << "Invalid time: " << optarg << "\n";
+                return 1;
+            }
+            if (opt == 'f') {
+                window.setBegin(time);
+            } else {
+                window.setEnd(time);
+            }
+            break;
+        case 'i':
+            index = true;
+            break;
+        case 'p':
+            partial = optarg;
+            break;
+        case 's':
+            serve = optarg;
+            break;
+        case 'S':
+            snapshot = optarg;
+            break;
+        case 'j':
+            cgi::ThreadPool::setNofThreads(std::strtoul(optarg, NULL, 10));
+            break;
+        case 'c':
+            cacheDirectory = optarg;
+            break;
+        case 'C':
+            cacheSize = std::strtoul(optarg, NULL, 10);
+            break;
+        case 'b':
+            binWidth = parse_duration(optarg);
+            if (binWidth <= 0) {
+                std::cerr << "Invalid bin width: " << optarg << "\n";
+                return 1;
+            }
+            break;
+        case 'F':
+            if (!cgi::TimelineWriter::parseFormat(optarg, format)) {
+                std::cerr << "Unknown output format: " << optarg << "\n";
+                return 1;
+            }
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        default:
+            show_usage(argv[0]);
+            return 1;
+        }
+    }
+
     // Check for command line arguments
-    if (argc < 2) {
+    if (optind >= argc) {
         show_usage(argv[0]);
         return 1;
     }
 
+    if (index && !cgi::TimeIndex::update(argv[optind])) {
+        std::cerr << "Unable to update time index for: " << argv[optind] << "\n";
+    }
+
+    if (!serve.empty()) {
+        return process_serve(argv[optind], serve, window, snapshot);
+    }
+
+    /* The plain statistics go to the standard output, or the output file */
+    bool plain = partial.empty() && queries.empty() && group == 0 && diff.empty();
+    int fd = STDOUT_FILENO;
+    if (!output.empty() && (plain || external)) {
+        fd = open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            std::cerr << "Error opening: " << output << "\n";
+            return 1;
+        }
+    }
+
+    /* Keep progress messages out of machine-readable output */
+    std::streambuf* coutBuffer = std::cout.rdbuf();
+    if (fd == STDOUT_FILENO && format != cgi::TimelineWriter::Challenge && (plain || external)) {
+        std::cout.rdbuf(std::cerr.rdbuf());
+    }
+
+    /* Downsampling to time bins, aligned to the start of the day */
+    cgi::OccupancyBins binned (binWidth, cgi::LogEntryView::startOfDay(), window);
+    cgi::OccupancyBins* bins = binWidth > 0 ? &binned : NULL;
+
+    /* Results of the plain statistics are looked up in the cache first */
+    bool cached = !cacheDirectory.empty() && plain;
+    cgi::ResultCache cache (cacheDirectory, std::uint64_t(cacheSize)*1024*1024);
+    std::string cacheKey = cached ? cgi::ResultCache::key(argv[optind], cache_options(window)) : "";
+    std::string cacheValue;
+    if (cached && cacheKey.empty()) {
+        std::cerr << "--> Not caching results for " << argv[optind] << std::endl;
+    }
+
+    if (!cacheKey.empty() && cache.load(cacheKey, cacheValue)) {
+        try {
+            std::istringstream is (cacheValue);
+            cgi::OccupancySweep sweep = cgi::OccupancySweep::read(is);
+            std::cerr << "--> Using cached result " << cacheKey << std::endl;
+            show_range(sweep);
+            if (bins != NULL) {
+                bins->add(sweep.timeline());
+            }
+            bool good = show_sweep(sweep, window, format, fd, bins);
+            std::cout.rdbuf(coutBuffer);
+            return close_output(fd, output, good);
+        } catch (const char* message) {
+            std::cerr << message << std::endl;
+            cache.remove(cacheKey);
+        } catch (const std::exception& error) {
+            std::cerr << "ERROR [process_logs] Corrupted cache entry: " << error.what() << std::endl;
+            cache.remove(cacheKey);
+        }
+    }
+
+    if (external) {
+        cgi::OccupancySweep sweep = process_logs_external(argv[optind], memoryBudget*1024*1024,
+                                                          window, bins);
+        bool good = show_sweep(sweep, window, format, fd, bins);
+        if (!cacheKey.empty() && !sweep.timeline().empty()) {
+            std::ostringstream os;
+            sweep.write(os);
+            cache.store(cacheKey, os.str());
+        }
+        std::cout.rdbuf(coutBuffer);
+        return close_output(fd, output, good);
+    }
+
     // Read data from input file
-    cgi::LogData logdata = cgi::LogData(argv[1]);
+    cgi::LogData logdata;
+    if (partial.empty()) {
+        logdata.setTimeWindow(window);
+    } else {
+        logdata.setTimeWindow(cgi::PartialAggregate::inputWindow(window));
+    }
+    logdata.readData(argv[optind]);
+
+    if (!partial.empty()) {
+        return process_partial(logdata, partial, window);
+    }
+
+    if (!queries.empty()) {
+        return process_queries(logdata, queries);
+    }
+
+    if (group > 0) {
+        return process_group(logdata, group, window);
+    }
+
+    if (!diff.empty()) {
+        cgi::LogData other;
+        other.setTimeWindow(window);
+        other.readData(diff);
+        process_diff(logdata, other);
+        return 0;
+    }
 
     std::pair<cgi::DateTime,cgi::DateTime> time_range = logdata.rangeOfTimes();
 
@@ -167,7 +843,16 @@ int main (int argc, char *argv[])
               << time_range.first << " ... " << time_range.second
               << std::endl;
 
-    process_logs(logdata);
+    cgi::OccupancySweep sweep = process_logs(logdata, bins);
+    bool good = show_sweep(sweep, window, format, fd, bins);
 
-    return 0;
+    // Empty results are cheap to recompute, hence never stored
+    if (!cacheKey.empty() && !sweep.timeline().empty()) {
+        std::ostringstream os;
+        sweep.write(os);
+        cache.store(cacheKey, os.str());
+    }
+
+    std::cout.rdbuf(coutBuffer);
+    return close_output(fd, output, good);
 }
@@ -0,0 +1,50 @@
+#-------------------------------------------------------------------------------
+# (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.
+# This software is distributed under the BSD 2-clause license.
+#-------------------------------------------------------------------------------
+
+# Pipe the log into process_logs via /dev/stdin and check that the output
+# matches the one obtained when reading the log file directly. If CACHEDIR is
+# given, the piped run uses it as --cache, which must not leave an entry behind
+# that a later run on the log file would pick up.
+#
+# Variables: PROCESS_LOGS (executable), LOGFILE (input log), CACHEDIR (optional).
+
+set (options)
+if (CACHEDIR)
+    file (REMOVE_RECURSE ${CACHEDIR})
+    set (options --cache ${CACHEDIR})
+endif ()
+
+execute_process (
+  COMMAND cat ${LOGFILE}
+  COMMAND ${PROCESS_LOGS} ${options} /dev/stdin
+  OUTPUT_VARIABLE piped
+  RESULT_VARIABLE status
+  )
+if (NOT status EQUAL 0)
+    message (FATAL_ERROR "process_logs failed reading from /dev/stdin")
+endif ()
+
+execute_process (
+  COMMAND ${PROCESS_LOGS} ${LOGFILE}
+  OUTPUT_VARIABLE expected
+  RESULT_VARIABLE status
+  )
+
+if (NOT piped STREQUAL expected)
+    message (FATAL_ERROR "Output for piped input differs:\n${piped}\nexpected:\n${expected}")
+endif ()
+
+if (CACHEDIR)
+    execute_process (
+      COMMAND ${PROCESS_LOGS} ${options} ${LOGFILE}
+      OUTPUT_VARIABLE direct
+      ERROR_VARIABLE messages
+      )
+    if (messages MATCHES "Using cached result")
+        message (FATAL_ERROR "Piped input left an entry in the cache:\n${direct}")
+    endif ()
+endif ()
+
+message (STATUS "${piped}")
@@ -0,0 +1,170 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file bench_allocators.cc
+ * \brief Benchmark for the allocation strategy of the event containers
+ *
+ * Compares the number of calls to the global ``operator new`` and the wall-time
+ * for building the per-call event containers of cgi::LogData -- the node-based
+ * containers used by an earlier version of the library as well as the ones used
+ * at present -- with storage obtained from the heap ("before") and from a
+ * cgi::MonotonicArena ("after").
+ *
+ * Usage: bench_allocators [nofEntries]
+ *
+ * Meaningful timings require an optimized build, i.e. configuring with
+ * ``-D CMAKE_BUILD_TYPE=Release``.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <set>
+#include <string>
+
+#include <LogData.h>
+#include <MonotonicArena.h>
+#include <PolymorphicAllocator.h>
+#include <TimePoint.h>
+
+/// Number of calls to the global operator new
+static std::size_t nofAllocations = 0;
+
+void* operator new (std::size_t size)
+{
+    ++nofAllocations;
+    void* p = std::malloc(size);
+    if (p == NULL) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete (void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete (void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+//______________________________________________________________________________
+//                                                                        report
+
+/*!
+ * \brief Run a benchmark and report allocations and wall-time
+ * \param name -- Name of the benchmark.
+ * \param func -- Function to run; returns a value to keep the work alive.
+ */
+template <typename Func>
+void report (const std::string& name,
+             Func func)
+{
+    std::size_t allocations = nofAllocations;
+    auto start              = std::chrono::steady_clock::now();
+
+    long result = func();
+
+    auto stop = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double,std::milli>(stop-start).count();
+
+    std::cout << std::left  << std::setw(40) << name
+              << std::right << std::setw(12) << nofAllocations-allocations
+              << std::setw(12) << std::fixed << std::setprecision(2) << ms
+              << std::setw(12) << result
+              << std::endl;
+}
+
+//______________________________________________________________________________
+//                                                                          main
+
+/// Program main function
+int main (int argc, char *argv[])
+{
+    std::size_t nofEntries = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 200000;
+    std::string filename   = "bench_allocators.txt";
+
+    // Generate visitor log with random times of entry and exit
+    {
+        std::srand(42);
+        std::ofstream outfile (filename);
+        for (std::size_t n=0; n<nofEntries; ++n) {
+            int entry = std::rand() % (23*60);
+            int exit  = entry + 1 + std::rand() % (24*60 - entry - 1);
+            char line[16];
+            std::snprintf(line, sizeof(line), "%02d:%02d,%02d:%02d",
+                          entry/60, entry%60, exit/60, exit%60);
+            outfile << line << "\n";
+        }
+    }
+
+    cgi::LogData data (filename);
+    std::remove(filename.c_str());
+
+    std::cout << "\n" << std::left << std::setw(40) << "Benchmark (N=" + std::to_string(nofEntries) + ")"
+              << std::right << std::setw(12) << "allocs"
+              << std::setw(12) << "time [ms]"
+              << std::setw(12) << "result"
+              << std::endl;
+
+    /* multiset<TimePoint>, as used by an earlier version of maxNofVisitors */
+
+    report("multiset<TimePoint>   [heap]", [&data] () {
+            std::multiset<cgi::TimePoint> set_tp;
+            for (std::size_t n=0; n<data.size(); ++n) {
+                set_tp.insert(cgi::TimePoint(cgi::DateTime(std::time_t(data.timesEntry()[n])), +1));
+                set_tp.insert(cgi::TimePoint(cgi::DateTime(std::time_t(data.timesExit()[n])),  -1));
+            }
+            return long(set_tp.size());
+        });
+
+    report("multiset<TimePoint>   [arena]", [&data] () {
+            typedef std::multiset<cgi::TimePoint, std::less<cgi::TimePoint>,
+                                  cgi::PolymorphicAllocator<cgi::TimePoint> > Set;
+            cgi::MonotonicArena arena;
+            Set set_tp (std::less<cgi::TimePoint>(), &arena);
+            for (std::size_t n=0; n<data.size(); ++n) {
+                set_tp.insert(cgi::TimePoint(cgi::DateTime(std::time_t(data.timesEntry()[n])), +1));
+                set_tp.insert(cgi::TimePoint(cgi::DateTime(std::time_t(data.timesExit()[n])),  -1));
+            }
+            return long(set_tp.size());
+        });
+
+    /* multimap<DateTime,int>, as returned by entranceTimepoints */
+
+    report("entranceTimepoints()  [heap]", [&data] () {
+            return long(data.entranceTimepoints().size());
+        });
+
+    report("entranceTimepoints()  [arena]", [&data] () {
+            cgi::MonotonicArena arena;
+            return long(data.entranceTimepoints(&arena).size());
+        });
+
+    /* Contiguous event arrays */
+
+    report("events()              [heap]", [&data] () {
+            return long(data.events().size());
+        });
+
+    report("events()              [arena]", [&data] () {
+            cgi::MonotonicArena arena;
+            return long(data.events(&arena).size());
+        });
+
+    report("maxNofVisitors()", [&data] () {
+            return long(data.maxNofVisitors());
+        });
+
+    return 0;
+}
@@ -0,0 +1,411 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file bench_hotpaths.cc
+ * \brief Benchmark suite for the hot paths of the library
+ *
+ * Runs each benchmark at several input sizes \f$ N \f$ -- the number of
+ * log entries -- and reports per run of the benchmark over the \f$ N \f$
+ * items
+ *
+ * \li `ns/op` -- wall-time per run;
+ * \li `items/s` -- number of items processed per second;
+ * \li `allocs/op` -- number of calls to the global ``operator new`` per run.
+ *
+ * Each benchmark is repeated until at least the minimum time has been spent
+ * in the timed region. Preparations (e.g. generating the log, or providing a
+ * fresh copy of cgi::LogData for which no derived quantities have been
+ * cached yet) are not included in the measurement.
+ *
+ * Usage: bench_hotpaths [--sizes N1,N2,...] [--min-time seconds] [--json file]
+ *
+ * Besides the table on the standard output, the results can be written as
+ * JSON, for comparing the results of different runs (e.g. before and after a
+ * change). The `bench` target runs the suite with the default settings and
+ * writes ``bench_hotpaths.json`` into the build directory.
+ *
+ * Meaningful timings require an optimized build, i.e. configuring with
+ * ``-D CMAKE_BUILD_TYPE=Release``.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <DateTime.h>
+#include <LogData.h>
+#include <LogEntry.h>
+#include <OccupancySweep.h>
+#include <OutputBuffer.h>
+#include <ThreadPool.h>
+#include <TimelineWriter.h>
+
+/// Number of calls to the global operator new, from any thread
+static std::atomic<std::size_t> nofAllocations (0);
+
+void* operator new (std::size_t size)
+{
+    nofAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size);
+    if (p == NULL) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete (void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete (void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+/*!
+ * \struct Result
+ * \brief Outcome of running a single benchmark at a single input size
+ */
+struct Result {
+    /// Name of the benchmark
+    std::string name;
+    /// Number of items processed per run
+    std::size_t items;
+    /// Number of runs
+    std::size_t runs;
+    /// Wall-time per run (in nanoseconds)
+    double nsPerOp;
+    /// Number of items processed per second
+    double itemsPerSecond;
+    /// Number of allocations per run
+    double allocsPerOp;
+};
+
+/// Minimum time (in seconds) to spend in the timed region per benchmark
+static double minTime = 0.2;
+
+/// Sink for the results of the runs, such that the work is not optimized away
+static volatile long sink = 0;
+
+//______________________________________________________________________________
+//                                                                       measure
+
+/*!
+ * \brief Run a benchmark repeatedly, measuring only the calls of `func`
+ * \param name  -- Name of the benchmark.
+ * \param items -- Number of items processed per run.
+ * \param setup -- Function preparing a run; not included in the measurement.
+ * \param func  -- Function to run; returns a value to keep the work alive.
+ */
+template <typename Setup, typename Func>
+Result measure (const std::string& name,
+                const std::size_t& items,
+                Setup setup,
+                Func func)
+{
+    Result result;
+    result.name  = name;
+    result.items = items;
+    result.runs  = 0;
+
+    double elapsed          = 0;
+    std::size_t allocations = 0;
+
+    while (result.runs == 0 || elapsed < minTime*1e9) {
+        setup();
+
+        std::size_t before = nofAllocations.load();
+        auto start         = std::chrono::steady_clock::now();
+
+        sink = sink + func();
+
+        auto stop    = std::chrono::steady_clock::now();
+        allocations += nofAllocations.load() - before;
+        elapsed     += std::chrono::duration<double,std::nano>(stop-start).count();
+        ++result.runs;
+    }
+
+    result.nsPerOp        = elapsed/result.runs;
+    result.itemsPerSecond = items*result.runs/(elapsed*1e-9);
+    result.allocsPerOp    = double(allocations)/result.runs;
+
+    return result;
+}
+
+/// Run a benchmark repeatedly, without any preparations per run
+template <typename Func>
+Result measure (const std::string& name,
+                const std::size_t& items,
+                Func func)
+{
+    return measure(name, items, [] () {}, func);
+}
+
+//______________________________________________________________________________
+//                                                                        report
+
+/// Show the result of a benchmark as a row of the table
+void report (const Result& result)
+{
+    std::cout << std::left  << std::setw(32) << result.name
+              << std::right << std::setw(10) << result.items
+              << std::setw(16) << std::fixed << std::setprecision(0) << result.nsPerOp
+              << std::setw(16) << std::setprecision(0) << result.itemsPerSecond
+              << std::setw(14) << std::setprecision(1) << result.allocsPerOp
+              << std::setw(8)  << result.runs
+              << std::endl;
+}
+
+//______________________________________________________________________________
+//                                                                    write_json
+
+/// Write the results of all benchmarks as JSON
+bool write_json (const std::string& filename,
+                 const std::vector<Result>& results)
+{
+    std::ofstream outfile (filename.c_str());
+    if (!outfile.is_open()) {
+        std::cerr << "Error opening: " << filename << "\n";
+        return false;
+    }
+
+    outfile << "{\n"
+            << "  \"context\": {\n"
+            << "    \"compiler\": \"" << __VERSION__ << "\",\n"
+            << "    \"threads\": " << cgi::ThreadPool::global().nofThreads() << ",\n"
+            << "    \"min_time\": " << minTime << "\n"
+            << "  },\n"
+            << "  \"benchmarks\": [\n";
+
+    for (std::size_t n=0; n<results.size(); ++n) {
+        outfile << "    {\"name\": \"" << results[n].name << "\""
+                << ", \"items\": " << results[n].items
+                << ", \"runs\": " << results[n].runs
+                << std::fixed << std::setprecision(1)
+                << ", \"ns_per_op\": " << results[n].nsPerOp
+                << ", \"items_per_second\": " << results[n].itemsPerSecond
+                << ", \"allocs_per_op\": " << results[n].allocsPerOp
+                << "}" << (n+1 < results.size() ? "," : "") << "\n";
+    }
+
+    outfile << "  ]\n"
+            << "}\n";
+
+    return true;
+}
+
+//______________________________________________________________________________
+//                                                               write_test_data
+
+/*!
+ * \brief Generate a visitor log with random times of entry and exit
+ * \param filename -- Name of the output file.
+ * \param nofLines -- Number of log entries.
+ * \return Log entries, in their original format.
+ */
+std::vector<std::string> write_test_data (const std::string& filename,
+                                          const std::size_t& nofLines)
+{
+    std::vector<std::string> lines (nofLines);
+    std::ofstream outfile (filename.c_str());
+
+    std::srand(42);
+    for (std::size_t n=0; n<nofLines; ++n) {
+        int entry = std::rand() % (23*60);
+        int exit  = entry + 1 + std::rand() % (24*60 - entry - 1);
+        char line[16];
+        std::snprintf(line, sizeof(line), "%02d:%02d,%02d:%02d",
+                      entry/60, entry%60, exit/60, exit%60);
+        lines[n] = line;
+        outfile << line << "\n";
+    }
+
+    return lines;
+}
+
+//______________________________________________________________________________
+//                                                                   parse_sizes
+
+/// Parse a comma-separated list of input sizes
+std::vector<std::size_t> parse_sizes (const std::string& arg)
+{
+    std::vector<std::size_t> result;
+    std::istringstream is (arg);
+    std::string item;
+
+    while (std::getline(is, item, ',')) {
+        std::size_t size = std::strtoul(item.c_str(), NULL, 10);
+        if (size > 0) {
+            result.push_back(size);
+        }
+    }
+
+    return result;
+}
+
+//______________________________________________________________________________
+//                                                                          main
+
+/// Program main function
+int main (int argc, char *argv[])
+{
+    std::vector<std::size_t> sizes;
+    std::string json;
+
+    sizes.push_back(1000);
+    sizes.push_back(10000);
+    sizes.push_back(100000);
+
+    for (int n=1; n<argc; ++n) {
+        std::string arg (argv[n]);
+        if (arg == "--sizes" && n+1 < argc) {
+            sizes = parse_sizes(argv[++n]);
+        } else if (arg == "--min-time" && n+1 < argc) {
+            minTime = std::strtod(argv[++n], NULL);
+        } else if (arg == "--json" && n+1 < argc) {
+            json = argv[++n];
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--sizes N1,N2,...] [--min-time seconds] [--json file]"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<Result> results;
+    std::string filename = "bench_hotpaths.txt";
+
+    /* The library reports progress on reading data, which is muted while
+       benchmarking. */
+    std::ofstream devnull ("/dev/null");
+    int nullfd = open("/dev/null", O_WRONLY);
+
+    std::cout << "\n" << std::left << std::setw(32) << "Benchmark"
+              << std::right << std::setw(10) << "N"
+              << std::setw(16) << "ns/op"
+              << std::setw(16) << "items/s"
+              << std::setw(14) << "allocs/op"
+              << std::setw(8)  << "runs"
+              << std::endl;
+
+    for (auto size=sizes.begin(); size!=sizes.end(); ++size) {
+        std::size_t N                  = *size;
+        std::vector<std::string> lines = write_test_data(filename, N);
+
+        std::streambuf* console = std::cout.rdbuf(devnull.rdbuf());
+        cgi::LogData pristine (filename);
+        std::cout.rdbuf(console);
+
+        std::vector<std::string> times (N);
+        std::vector<cgi::DateTime> datetimes (N);
+        for (std::size_t n=0; n<N; ++n) {
+            times[n]     = lines[n].substr(0, 5);
+            datetimes[n] = cgi::DateTime(times[n], "%H:%M");
+        }
+
+        std::vector<Result> batch;
+
+        /* Parsing and formatting of single points in time */
+
+        batch.push_back(measure("DateTime(string,format)", N, [&] () {
+                    long sum = 0;
+                    for (std::size_t n=0; n<N; ++n) {
+                        sum += cgi::DateTime(times[n], "%H:%M").rawtime();
+                    }
+                    return sum;
+                }));
+
+        batch.push_back(measure("DateTime::asString", N, [&] () {
+                    long sum = 0;
+                    for (std::size_t n=0; n<N; ++n) {
+                        sum += long(datetimes[n].asString("%H:%M").size());
+                    }
+                    return sum;
+                }));
+
+        batch.push_back(measure("LogEntry::setData", N, [&] () {
+                    long sum = 0;
+                    cgi::LogEntry entry (lines[0]);
+                    for (std::size_t n=0; n<N; ++n) {
+                        entry.setData(lines[n]);
+                        sum += entry.timeExit().rawtime();
+                    }
+                    return sum;
+                }));
+
+        /* Reading the log */
+
+        batch.push_back(measure("LogData::readData", N, [&] () {
+                    std::streambuf* console = std::cout.rdbuf(devnull.rdbuf());
+                    cgi::LogData data;
+                    data.readData(filename);
+                    std::cout.rdbuf(console);
+                    return long(data.size());
+                }));
+
+        /* Derived quantities, starting from a copy without any cached state */
+
+        cgi::LogData data;
+
+        batch.push_back(measure("LogData::maxNofVisitors", N,
+                                [&] () { data = pristine; },
+                                [&] () { return long(data.maxNofVisitors()); }));
+
+        batch.push_back(measure("LogData::entranceTimepoints", N,
+                                [&] () { data = pristine; },
+                                [&] () { return long(data.entranceTimepoints().size()); }));
+
+        /* Full flow of process_logs: read, sweep and write the statistics */
+
+        batch.push_back(measure("process_logs", N, [&] () {
+                    std::streambuf* console = std::cout.rdbuf(devnull.rdbuf());
+                    cgi::LogData data;
+                    data.readData(filename);
+                    std::cout.rdbuf(console);
+
+                    std::vector<cgi::Event> events = data.events();
+                    cgi::OccupancySweep sweep;
+                    for (auto it=events.begin(); it!=events.end(); ++it) {
+                        sweep.add(*it);
+                    }
+                    sweep.finish();
+
+                    cgi::OutputBuffer output (nullfd);
+                    cgi::TimelineWriter writer (output);
+                    writer.write(sweep.timeline(), sweep.maxIntervals());
+                    output.flush();
+
+                    return long(output.bytesWritten());
+                }));
+
+        for (auto it=batch.begin(); it!=batch.end(); ++it) {
+            report(*it);
+            results.push_back(*it);
+        }
+    }
+
+    std::remove(filename.c_str());
+    close(nullfd);
+
+    if (!json.empty() && !write_json(json, results)) {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file bench_prefix_scan.cc
+ * \brief Benchmark for the prefix-sum and max-scan kernels
+ *
+ * Buckets the events of randomly generated visits into a dense array covering a
+ * full year at a resolution of one second (31,536,000 slots), and compares the
+ * wall-time of the cgi::PrefixScan kernels supported by the processor against
+ * the sweep along the sorted list of events.
+ *
+ * Usage: bench_prefix_scan [nofVisits]
+ *
+ * Meaningful timings require an optimized build, i.e. configuring with
+ * ``-D CMAKE_BUILD_TYPE=Release``.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Event.h>
+#include <PrefixScan.h>
+
+/// Number of slots for a year at a resolution of one second
+static const std::size_t nofSlots = 365*24*3600;
+
+//______________________________________________________________________________
+//                                                                        report
+
+/*!
+ * \brief Run a benchmark and report wall-time and throughput
+ * \param name -- Name of the benchmark.
+ * \param func -- Function to run; returns the maximum number of visitors.
+ */
+template <typename Func>
+void report (const std::string& name,
+             Func func)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    long result = func();
+
+    auto stop = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double,std::milli>(stop-start).count();
+
+    std::cout << std::left  << std::setw(32) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2) << ms
+              << std::setw(16) << std::setprecision(3) << nofSlots/ms/1e6
+              << std::setw(12) << result
+              << std::endl;
+}
+
+//______________________________________________________________________________
+//                                                                          main
+
+/// Program main function
+int main (int argc, char *argv[])
+{
+    std::size_t nofVisits = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1000000;
+
+    // Generate visits of up to four hours, spread across the year
+    std::vector<std::int64_t> timesEntry (nofVisits);
+    std::vector<std::int64_t> timesExit (nofVisits);
+    std::vector<std::int32_t> delta (nofSlots, 0);
+    {
+        std::srand(42);
+        for (std::size_t n=0; n<nofVisits; ++n) {
+            std::size_t r = std::size_t(std::rand())*RAND_MAX + std::rand();
+            timesEntry[n] = r % (nofSlots - 4*3600);
+            timesExit[n]  = timesEntry[n] + 1 + std::rand() % (4*3600);
+            ++delta[timesEntry[n]];
+            --delta[timesExit[n]];
+        }
+    }
+
+    std::cout << "\n" << std::left << std::setw(32) << "Benchmark (N=" + std::to_string(nofVisits) + ")"
+              << std::right << std::setw(12) << "time [ms]"
+              << std::setw(16) << "slots [1/ns]"
+              << std::setw(12) << "result"
+              << std::endl;
+
+    /* Sweep along the sorted events, as done for sparse logs */
+
+    report("sorted events", [&] () {
+            std::vector<cgi::Event> events;
+            events.reserve(2*nofVisits);
+            for (std::size_t n=0; n<nofVisits; ++n) {
+                events.push_back(cgi::Event(timesEntry[n], true));
+                events.push_back(cgi::Event(timesExit[n], false));
+            }
+            std::sort(events.begin(), events.end());
+            int current = 0;
+            int max     = 0;
+            for (auto it=events.begin(); it!=events.end(); ++it) {
+                current += it->delta();
+                max = std::max(max, current);
+            }
+            return long(max);
+        });
+
+    /* Dense array of deltas, for each supported kernel */
+
+    cgi::PrefixScan::Kernel kernels[] = { cgi::PrefixScan::Scalar,
+                                          cgi::PrefixScan::AVX2,
+                                          cgi::PrefixScan::AVX512 };
+    std::vector<std::int32_t> sum (nofSlots);
+
+    for (std::size_t k=0; k<sizeof(kernels)/sizeof(kernels[0]); ++k) {
+        if (!cgi::PrefixScan::isSupported(kernels[k])) {
+            continue;
+        }
+        report(std::string("PrefixScan [") + cgi::PrefixScan::name(kernels[k]) + "]", [&] () {
+                cgi::IntervalSet<std::size_t,std::int32_t> runs;
+                return long(cgi::PrefixScan::scan(kernels[k], delta.data(), sum.data(),
+                                                  delta.size(), runs));
+            });
+    }
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_CLOCK_H
+#define CGI_CLOCK_H
+
+/*!
+ * \file Clock.h
+ * \brief Time representations for the storage of log data
+ */
+
+#include <cstdint>
+#include <ctime>
+
+#include "DateTime.h"
+#include "Iso8601.h"
+#include "LogEntryView.h"
+
+namespace cgi {
+
+    /*!
+     * \class TickClock
+     * \brief Time representation as integer number of ticks since the epoch
+     * \test test_Clock.cc
+     *
+     * A clock describes how points in time are stored by cgi::BasicLogData:
+     * as an integral `tick_type`, counting `TicksPerSecond` ticks per second
+     * since the Unix epoch. Besides the conversion from and to cgi::DateTime it
+     * provides the parsing of a single time field of a log entry, given either
+     * as time of day (``HH:MM:SS.fff``) or as ISO 8601 timestamp (see
+     * cgi::Iso8601); the fraction of a second is kept with up to as many digits
+     * as the resolution of the clock supports, further digits are truncated.
+     *
+     * Since events pack the time into the upper 63 bits (see cgi::Event), a
+     * nanosecond clock covers the years 1824 to 2116.
+     *
+     * Since all of the methods are static and inline, using a clock as template
+     * parameter does not introduce any run-time overhead.
+     */
+    template <std::int64_t TicksPerSecond>
+    struct TickClock {
+
+        /// Type used for the storage of points in time
+        typedef std::int64_t tick_type;
+
+        /// Number of ticks per second
+        static const std::int64_t ticksPerSecond = TicksPerSecond;
+
+        /// Convert cgi::DateTime to ticks
+        static inline tick_type fromDateTime (const DateTime& time) {
+            return tick_type(time.rawtime()) * TicksPerSecond;
+        }
+
+        /// Convert ticks to cgi::DateTime, truncating to full seconds
+        static inline DateTime toDateTime (const tick_type& ticks) {
+            tick_type seconds = ticks / TicksPerSecond;
+            if (ticks % TicksPerSecond < 0) {
+                --seconds;
+            }
+            return DateTime(std::time_t(seconds));
+        }
+
+        /*!
+         * \brief Parse the characters in [begin,end) as time
+         * \param begin     -- Pointer to the first character.
+         * \param end       -- Pointer past the last character.
+         * \param reference -- Start of the day, to which times of day are
+         *        referring; see cgi::LogEntryView::startOfDay().
+         */
+        static tick_type parse (const char* begin,
+                                const char* end,
+                                const std::time_t& reference) {
+            // Full timestamp, decoded straight into ticks
+            std::int64_t seconds     = 0;
+            std::int64_t nanoseconds = 0;
+            if (Iso8601::isDate(begin, end) && Iso8601::parse(begin, end, seconds, nanoseconds)) {
+                return seconds*TicksPerSecond + nanoseconds/(1000000000/TicksPerSecond);
+            }
+
+            // Split off the fraction of a second, if any
+            const char* dot = begin;
+            while (dot != end && *dot != '.') {
+                ++dot;
+            }
+
+            tick_type ticks = tick_type(LogEntryView::parseTime(begin, dot, reference)) * TicksPerSecond;
+
+            std::int64_t scale = TicksPerSecond;
+            const char* it     = (dot == end) ? end : dot+1;
+            for (; it != end && scale > 1; ++it) {
+                if (*it < '0' || *it > '9') {
+                    break;
+                }
+                scale /= 10;
+                ticks += scale*(*it-'0');
+            }
+
+            return ticks;
+        }
+
+    };  //  struct TickClock -- END
+
+    /// Clock with a resolution of one second; default for cgi::LogData
+    typedef TickClock<1> SecondsClock;
+
+    /// Clock with a resolution of one millisecond
+    typedef TickClock<1000> MillisecondsClock;
+
+    /// Clock with a resolution of one microsecond
+    typedef TickClock<1000000> MicrosecondsClock;
+
+    /// Clock with a resolution of one nanosecond
+    typedef TickClock<1000000000> NanosecondsClock;
+
+}  //  namespace cgi -- END
+
+#endif
@@ -203,24 +203,26 @@ namespace cgi {
                                const std::string& format)
     {
         // Get current date/time in order to fill in missing information
+        // (reentrant variant, since log entries may be parsed concurrently)
         time_t rawtime;
-        struct tm * tm_now;
+        struct tm tm_now;
         time ( &rawtime );
-        tm_now = localtime ( &rawtime );
+        localtime_r ( &rawtime, &tm_now );
 
         // Initialize the structure into which the parsed input will be written
-        struct std::tm tm = *tm_now;
-        tm.tm_hour = 0;
-        tm.tm_min  = 0;
-        tm.tm_sec  = 0;
+        struct std::tm tm = tm_now;
+        tm.tm_hour  = 0;
+        tm.tm_min   = 0;
+        tm.tm_sec   = 0;
+        tm.tm_isdst = -1;   // determined for the parsed time, not the current one
 
         // parse input character representation of date/time ...
         strptime (in.c_str(), format.c_str(), &tm);
         // ... and inspect the outcome
         if ( (tm.tm_year==0) && (tm.tm_mon==0) && (tm.tm_mday==0) ) {
-            tm.tm_year = tm_now->tm_year;
-            tm.tm_mon  = tm_now->tm_mon;
-            tm.tm_mday = tm_now->tm_mday;
+            tm.tm_year = tm_now.tm_year;
+            tm.tm_mon  = tm_now.tm_mon;
+            tm.tm_mday = tm_now.tm_mday;
         }
 
         return tm;
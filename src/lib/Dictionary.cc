@@ -0,0 +1,79 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <cstring>
+
+#include "Dictionary.h"
+
+namespace cgi {
+
+    const Dictionary::code_type Dictionary::npos;
+
+    // =========================================================================
+    //
+    //  Public methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                    encode
+
+    Dictionary::code_type Dictionary::encode (const char* begin,
+                                              const char* end)
+    {
+        std::size_t length = end - begin;
+
+        // Same value as for the previous call?
+        if (itsLastCode != npos) {
+            const std::string& last = itsValues[itsLastCode];
+            if (last.size() == length && std::memcmp(last.data(), begin, length) == 0) {
+                return itsLastCode;
+            }
+        }
+
+        std::string value (begin, length);
+        auto it = itsCodes.find(value);
+
+        if (it != itsCodes.end()) {
+            itsLastCode = it->second;
+        } else {
+            itsLastCode = code_type(itsValues.size());
+            itsValues.push_back(value);
+            itsCodes.insert(std::make_pair(value, itsLastCode));
+        }
+
+        return itsLastCode;
+    }
+
+    //__________________________________________________________________________
+    //                                                                      find
+
+    Dictionary::code_type Dictionary::find (const std::string& value) const
+    {
+        auto it = itsCodes.find(value);
+
+        return (it != itsCodes.end()) ? it->second : npos;
+    }
+
+    //__________________________________________________________________________
+    //                                                                     clear
+
+    void Dictionary::clear ()
+    {
+        itsValues.clear();
+        itsCodes.clear();
+        itsLastCode = npos;
+    }
+
+}  //  namespace cgi -- END
+
+std::ostream& operator<< (std::ostream& os, const cgi::Dictionary& obj)
+{
+    for (std::size_t n=0; n<obj.size(); ++n) {
+        os << "[" << n << "] = " << obj[n] << "\n";
+    }
+
+    return os;
+}
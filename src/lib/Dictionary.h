@@ -0,0 +1,112 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_DICTIONARY_H
+#define CGI_DICTIONARY_H
+
+/*!
+ * \file Dictionary.h
+ * \brief Class for the dictionary encoding of categorical values
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cgi {
+
+    /*!
+     * \class Dictionary
+     * \brief Dictionary encoding of categorical values
+     * \test test_Dictionary.cc
+     *
+     * Maps each distinct value -- e.g. a ticket type, a visitor ID or the name
+     * of a gate -- onto a dense integer code, assigned in order of first
+     * appearance. Columns of a log thereby are stored as arrays of codes, and
+     * anything computed per category can be kept in a plain array indexed by
+     * the code, rather than in a map keyed by strings. Since consecutive log
+     * entries frequently share the same value, the code of the most recently
+     * encoded value is checked before consulting the hash table.
+     */
+    class Dictionary {
+
+    public:
+
+        /// Type of the codes
+        typedef std::uint32_t code_type;
+
+        /// Code returned by find() for values not contained in the dictionary
+        static const code_type npos = code_type(-1);
+
+    private:
+
+        /// Distinct values, indexed by their code
+        std::vector<std::string> itsValues;
+        /// Codes, indexed by their value
+        std::unordered_map<std::string, code_type> itsCodes;
+        /// Code of the most recently encoded value
+        code_type itsLastCode;
+
+    public:
+
+        // === Construction ====================================================
+
+        /// Default constructor
+        Dictionary () : itsLastCode(npos) {}
+
+        // === Parameter access ================================================
+
+        /// Get the number of distinct values
+        inline std::size_t size () const {
+            return itsValues.size();
+        }
+
+        /// Is the dictionary empty?
+        inline bool empty () const {
+            return itsValues.empty();
+        }
+
+        /// Get the value for code `code`
+        inline const std::string& operator[] (const code_type& code) const {
+            return itsValues[code];
+        }
+
+        /// Get the distinct values, in order of their codes
+        inline const std::vector<std::string>& values () const {
+            return itsValues;
+        }
+
+        // === Public methods ==================================================
+
+        /*!
+         * \brief Get the code for the characters in [begin,end)
+         *
+         * Values not yet contained in the dictionary are added to it.
+         */
+        code_type encode (const char* begin,
+                          const char* end);
+
+        /// Get the code for `value`, adding it to the dictionary if required
+        inline code_type encode (const std::string& value) {
+            return encode(value.data(), value.data()+value.size());
+        }
+
+        /// Get the code for `value`, or npos if the value is not contained
+        code_type find (const std::string& value) const;
+
+        /// Remove all values
+        void clear ();
+
+    };  //  class Dictionary -- END
+
+}  //  namespace cgi -- END
+
+/// Overloading of output operator for cgi::Dictionary class
+std::ostream& operator<< (std::ostream& os, const cgi::Dictionary& obj);
+
+#endif
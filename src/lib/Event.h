@@ -0,0 +1,105 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_EVENT_H
+#define CGI_EVENT_H
+
+/*!
+ * \file Event.h
+ * \brief Class for the representation of a single entrance event
+ */
+
+#include <cstdint>
+#include <iostream>
+
+namespace cgi {
+
+    /*!
+     * \class Event
+     * \brief Packed representation of a single entrance event
+     * \test test_Event.cc
+     *
+     * An event -- a visitor entering or leaving -- is stored as a single 64-bit
+     * key, with the time of the event in the upper bits and the type of event in
+     * the lowest bit (``0`` for an exit, ``1`` for an entry). This way sorting a
+     * list of events by their key orders them by time and -- for simultaneous
+     * events -- places exits before entries, which is the same ordering as is
+     * obtained from a ``std::multiset<cgi::TimePoint>``: a visitor leaving at
+     * the same time another one is entering does not add to the count.
+     */
+    class Event {
+
+        /// Packed key, holding time and type of the event
+        std::int64_t itsKey;
+
+    public:
+
+        // === Construction ====================================================
+
+        /// Default constructor
+        Event () : itsKey(0) {}
+
+        /*!
+         * \brief Argumented constructor
+         * \param time  -- Time of the event (e.g. as returned by DateTime::rawtime).
+         * \param entry -- Is this an entry event (`true`) or an exit (`false`)?
+         */
+        Event (const std::int64_t& time,
+               const bool& entry)
+            // shifted as unsigned, since shifting negative (pre-1970) times is undefined
+            : itsKey(std::int64_t(std::uint64_t(time) << 1) | (entry ? 1 : 0)) {}
+
+        // === Operator overloading ============================================
+
+        /// Check if this is smaller than other
+        bool operator< (const Event& rhs) const {
+            return itsKey < rhs.itsKey;
+        }
+
+        /// Check if this is larger than other
+        bool operator> (const Event& rhs) const {
+            return itsKey > rhs.itsKey;
+        }
+
+        /// Comparison operator
+        bool operator== (const Event& rhs) const {
+            return itsKey == rhs.itsKey;
+        }
+
+        // === Parameter access ================================================
+
+        /// Get the packed key of the event
+        inline std::int64_t key () const {
+            return itsKey;
+        }
+
+        /// Get the time of the event
+        inline std::int64_t time () const {
+            return itsKey >> 1;
+        }
+
+        /// Is this an entry event?
+        inline bool isEntry () const {
+            return (itsKey & 1) != 0;
+        }
+
+        /// Get the change in the number of visitors: +1 for entry, -1 for exit
+        inline int delta () const {
+            return (itsKey & 1) ? +1 : -1;
+        }
+
+    };  //  class Event -- END
+
+}  //  namespace cgi -- END
+
+/// Overloading of output operator for cgi::Event class
+inline std::ostream& operator<< (std::ostream& os, const cgi::Event& obj)
+{
+    os << "[" << obj.time() << "] = " << obj.delta();
+
+    return os;
+}
+
+#endif
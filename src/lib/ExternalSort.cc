@@ -0,0 +1,317 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "ExternalSort.h"
+#include "LogBuffer.h"
+#include "LogDecoder.h"
+#include "ThreadPool.h"
+#include "TimeIndex.h"
+
+namespace cgi {
+
+    const std::size_t ExternalSort::minBufferSize;
+
+    /// Reader for a sorted run of events, stored in a temporary file
+    class RunReader {
+
+        /// Input stream for the run
+        std::ifstream itsStream;
+        /// Read buffer
+        std::vector<Event> itsBuffer;
+        /// Position of the next event within the read buffer
+        std::size_t itsPosition;
+
+        /// Refill the read buffer from the input stream
+        void fill () {
+            itsBuffer.resize(itsBuffer.capacity());
+            itsStream.read(reinterpret_cast<char*>(itsBuffer.data()),
+                           itsBuffer.size()*sizeof(Event));
+            itsBuffer.resize(itsStream.gcount()/sizeof(Event));
+            itsPosition = 0;
+        }
+
+    public:
+
+        RunReader (const std::string& filename,
+                   const std::size_t& bufferSize)
+            : itsStream(filename.c_str(), std::ios::binary),
+              itsPosition(0)
+        {
+            if (!itsStream.is_open()) {
+                throw "ERROR [ExternalSort::merge] Unable to open sorted run";
+            }
+            itsBuffer.reserve(std::max<std::size_t>(bufferSize, 1));
+            fill();
+        }
+
+        /// Is there an event available?
+        bool valid () const {
+            return itsPosition < itsBuffer.size();
+        }
+
+        /// Get the current event
+        const Event& current () const {
+            return itsBuffer[itsPosition];
+        }
+
+        /// Advance to the next event
+        void next () {
+            if (++itsPosition == itsBuffer.size()) {
+                fill();
+            }
+        }
+
+    };
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                              ExternalSort
+
+    ExternalSort::ExternalSort (const std::size_t& memoryBudget,
+                                const std::string& tempDir)
+        : itsMemoryBudget(memoryBudget),
+          itsTempDir(tempDir),
+          itsNofEvents(0),
+          itsMaxFanIn(64)
+    {
+        if (itsTempDir.empty()) {
+            const char* env = std::getenv("TMPDIR");
+            itsTempDir = (env && *env) ? env : "/tmp";
+        }
+
+        itsBuffer.reserve(std::max<std::size_t>(itsMemoryBudget/sizeof(Event), minBufferSize));
+    }
+
+    //__________________________________________________________________________
+    //                                                             ~ExternalSort
+
+    ExternalSort::~ExternalSort ()
+    {
+        for (auto it=itsRuns.begin(); it!=itsRuns.end(); ++it) {
+            std::remove(it->c_str());
+        }
+    }
+
+    // =========================================================================
+    //
+    //  Public methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                  readData
+
+    void ExternalSort::readData (const std::string& filename)
+    {
+        // Restrict reading to the relevant region of the file, if indexed
+        std::pair<std::size_t,std::size_t> region (0, std::size_t(-1));
+        TimeIndex index;
+        if (itsTimeWindow.isBounded() && index.load(filename)) {
+            region = index.region(itsTimeWindow);
+        }
+
+        LogBuffer buffer (filename, region.first, region.second-region.first);
+
+        if (buffer.isOpen()) {
+            std::size_t nofLines = 0;
+            std::size_t skipped  = 0;
+            for (auto it=buffer.begin(); it!=buffer.end(); ++it) {
+                std::size_t size       = it.lineSize();
+                std::int64_t timeEntry = 0;
+                std::int64_t timeExit  = 0;
+                if (!LogDecoder::times(it.line(), size, buffer.reference(), itsTimeWindow,
+                                       timeEntry, timeExit)) {
+                    ++skipped;
+                    continue;
+                }
+
+                insert(Event(timeEntry, true));
+                insert(Event(timeExit, false));
+                ++nofLines;
+            }
+            // report number of lines read
+            std::cout << "--> Finished reading " << nofLines
+                      << " lines from file into " << nofRuns()
+                      << " sorted runs.";
+            if (skipped > 0) {
+                std::cout << " Skipped " << skipped << " lines outside time window.";
+            }
+            std::cout << std::endl;
+        } else {
+            std::cerr << "Error opening: " << filename << "\n";
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                                    insert
+
+    void ExternalSort::insert (const Event& event)
+    {
+        if (itsBuffer.size() == itsBuffer.capacity()) {
+            spill();
+        }
+        itsBuffer.push_back(event);
+        ++itsNofEvents;
+    }
+
+    //__________________________________________________________________________
+    //                                                                     merge
+
+    void ExternalSort::merge (const std::function<void (const Event&)>& visitor)
+    {
+        // Everything fits into memory: no need for merging
+        if (itsRuns.empty()) {
+            ThreadPool::global().parallelSort(itsBuffer.begin(), itsBuffer.end());
+            for (auto it=itsBuffer.begin(); it!=itsBuffer.end(); ++it) {
+                visitor(*it);
+            }
+            return;
+        }
+
+        // Spill the remaining events, handing the memory on to the read buffers
+        if (!itsBuffer.empty()) {
+            spill();
+        }
+        std::vector<Event>().swap(itsBuffer);
+
+        // Keep clear of the limit on the number of open files
+        std::size_t fanIn = itsMaxFanIn;
+        struct rlimit limit;
+        if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+            fanIn = std::min<std::size_t>(fanIn, std::max<std::size_t>(limit.rlim_cur/2, 2));
+        }
+
+        // Reduce the number of runs by merging groups of them into longer runs
+        while (itsRuns.size() > fanIn) {
+            std::vector<std::string> group (itsRuns.begin(), itsRuns.begin()+fanIn);
+            std::string filename = createRun();
+            itsRuns.push_back(filename);
+
+            // The budget is shared between the read buffers and the output buffer
+            std::size_t bufferSize = std::max<std::size_t>(itsMemoryBudget/sizeof(Event)/(group.size()+1),
+                                                           minBufferSize);
+            std::ofstream outfile (filename.c_str(), std::ios::binary);
+            std::vector<Event> output;
+            output.reserve(bufferSize);
+            mergeRuns(group, bufferSize, [&outfile, &output] (const Event& event) {
+                    output.push_back(event);
+                    if (output.size() == output.capacity()) {
+                        outfile.write(reinterpret_cast<const char*>(output.data()),
+                                      output.size()*sizeof(Event));
+                        output.clear();
+                    }
+                });
+            outfile.write(reinterpret_cast<const char*>(output.data()),
+                          output.size()*sizeof(Event));
+            if (!outfile) {
+                throw "ERROR [ExternalSort::merge] Unable to write sorted run";
+            }
+
+            for (auto it=group.begin(); it!=group.end(); ++it) {
+                std::remove(it->c_str());
+            }
+            itsRuns.erase(itsRuns.begin(), itsRuns.begin()+group.size());
+        }
+
+        mergeRuns(itsRuns,
+                  std::max<std::size_t>(itsMemoryBudget/sizeof(Event)/itsRuns.size(), minBufferSize),
+                  visitor);
+    }
+
+    // =========================================================================
+    //
+    //  Private methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                     spill
+
+    void ExternalSort::spill ()
+    {
+        std::string filename = createRun();
+        itsRuns.push_back(filename);
+
+        ThreadPool::global().parallelSort(itsBuffer.begin(), itsBuffer.end());
+
+        std::ofstream outfile (filename.c_str(), std::ios::binary);
+        outfile.write(reinterpret_cast<const char*>(itsBuffer.data()),
+                      itsBuffer.size()*sizeof(Event));
+        if (!outfile) {
+            throw "ERROR [ExternalSort::spill] Unable to write sorted run";
+        }
+
+        itsBuffer.clear();
+    }
+
+    //__________________________________________________________________________
+    //                                                                 createRun
+
+    std::string ExternalSort::createRun () const
+    {
+        std::string filename = itsTempDir + "/cgi-run-XXXXXX";
+        std::vector<char> buffer (filename.begin(), filename.end());
+        buffer.push_back('\0');
+
+        int fd = mkstemp(buffer.data());
+        if (fd == -1) {
+            throw "ERROR [ExternalSort::createRun] Unable to create temporary file";
+        }
+        close(fd);
+
+        return buffer.data();
+    }
+
+    //__________________________________________________________________________
+    //                                                                 mergeRuns
+
+    void ExternalSort::mergeRuns (const std::vector<std::string>& runs,
+                                  const std::size_t& bufferSize,
+                                  const std::function<void (const Event&)>& visitor) const
+    {
+        std::vector<std::unique_ptr<RunReader> > readers;
+        for (auto it=runs.begin(); it!=runs.end(); ++it) {
+            readers.push_back(std::unique_ptr<RunReader>(new RunReader(*it, bufferSize)));
+        }
+
+        // Heap of (event, source) pairs
+        typedef std::pair<Event,std::size_t> Item;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item> > heap;
+
+        for (std::size_t n=0; n<readers.size(); ++n) {
+            if (readers[n]->valid()) {
+                heap.push(Item(readers[n]->current(), n));
+            }
+        }
+
+        while (!heap.empty()) {
+            Item item = heap.top();
+            heap.pop();
+            visitor(item.first);
+
+            RunReader* reader = readers[item.second].get();
+            reader->next();
+            if (reader->valid()) {
+                heap.push(Item(reader->current(), item.second));
+            }
+        }
+    }
+
+}  //  namespace cgi -- END
@@ -0,0 +1,162 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_EXTERNALSORT_H
+#define CGI_EXTERNALSORT_H
+
+/*!
+ * \file ExternalSort.h
+ * \brief Class for the out-of-core sorting of entrance events
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Event.h"
+#include "TimeWindow.h"
+
+namespace cgi {
+
+    /*!
+     * \class ExternalSort
+     * \brief Out-of-core sorting of entrance events for logs larger than memory
+     * \test test_ExternalSort.cc
+     *
+     * As opposed to cgi::LogData, which keeps every log entry in memory, the
+     * input is parsed line by line into packed events (see cgi::Event) which
+     * are collected into a buffer of fixed size. Once the buffer is full, it is
+     * sorted and spilled as a run to a temporary file. Upon calling merge() the
+     * sorted runs are combined through a k-way merge, handing the events in
+     * order to the provided visitor -- e.g. cgi::OccupancySweep -- such that
+     * at no point the full list of events needs to be held in memory.
+     *
+     * The memory budget covers the buffer used for collecting events as well as
+     * the read buffers used for the runs during the merge; it is raised to hold
+     * at least minBufferSize events, such that a small budget does not turn
+     * into a vast number of tiny runs. At most maxFanIn() runs -- and no more
+     * than half the limit on open files -- are merged at once, each of them
+     * holding on to an open file; for a larger number of runs groups of them
+     * are first merged into longer runs.
+     *
+     * If a time window is set, log entries outside the window are skipped while
+     * reading; with an up-to-date cgi::TimeIndex only the relevant region of
+     * the log file is read.
+     */
+    class ExternalSort {
+
+        /// Memory budget (in bytes)
+        std::size_t itsMemoryBudget;
+        /// Directory in which to place the temporary files
+        std::string itsTempDir;
+        /// Buffer for collecting events before they are spilled to disk
+        std::vector<Event> itsBuffer;
+        /// Names of the temporary files holding the sorted runs
+        std::vector<std::string> itsRuns;
+        /// Total number of events
+        std::size_t itsNofEvents;
+        /// Maximum number of runs merged at once
+        std::size_t itsMaxFanIn;
+        /// Time window outside of which log entries are skipped while reading
+        TimeWindow itsTimeWindow;
+
+        /// Sort the contents of the buffer and write it to a temporary file
+        void spill ();
+
+        /// Create an empty temporary file for a sorted run
+        std::string createRun () const;
+
+        /// Merge the given sorted runs, using read buffers of `bufferSize` events
+        void mergeRuns (const std::vector<std::string>& runs,
+                        const std::size_t& bufferSize,
+                        const std::function<void (const Event&)>& visitor) const;
+
+    public:
+
+        /// Minimum number of events per sorted run and per read buffer
+        static const std::size_t minBufferSize = 1024;
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param memoryBudget -- Memory budget (in bytes).
+         * \param tempDir      -- Directory in which to place the temporary
+         *        files; if left empty ``$TMPDIR`` (or ``/tmp``) is used.
+         */
+        ExternalSort (const std::size_t& memoryBudget=64*1024*1024,
+                      const std::string& tempDir="");
+
+        /// Destructor, removing the temporary files
+        ~ExternalSort ();
+
+        // === Parameter access ================================================
+
+        /// Get the memory budget (in bytes)
+        inline std::size_t memoryBudget () const {
+            return itsMemoryBudget;
+        }
+
+        /// Get the total number of events
+        inline std::size_t nofEvents () const {
+            return itsNofEvents;
+        }
+
+        /// Get the number of sorted runs spilled to disk
+        inline std::size_t nofRuns () const {
+            return itsRuns.size();
+        }
+
+        /// Get the maximum number of runs merged at once
+        inline std::size_t maxFanIn () const {
+            return itsMaxFanIn;
+        }
+
+        /// Set the maximum number of runs merged at once (at least 2)
+        inline void setMaxFanIn (const std::size_t& maxFanIn) {
+            itsMaxFanIn = std::max<std::size_t>(maxFanIn, 2);
+        }
+
+        /// Get the time window outside of which log entries are skipped
+        inline const TimeWindow& timeWindow () const {
+            return itsTimeWindow;
+        }
+
+        /// Set the time window (in seconds) outside of which log entries are skipped
+        inline void setTimeWindow (const TimeWindow& window) {
+            itsTimeWindow = window;
+        }
+
+        // === Public methods ==================================================
+
+        /*!
+         * \brief Read data from input source
+         * \param filename -- Name of the input file from which the log data are
+         *        read
+         */
+        void readData (const std::string& filename);
+
+        /// Add a single event
+        void insert (const Event& event);
+
+        /*!
+         * \brief Merge the sorted runs, passing the events on in order
+         * \param visitor -- Function called for every event, in order.
+         */
+        void merge (const std::function<void (const Event&)>& visitor);
+
+    private:
+
+        // Objects of this type hold on to temporary files
+        ExternalSort (const ExternalSort&);
+        ExternalSort& operator= (const ExternalSort&);
+
+    };  //  class ExternalSort -- END
+
+}  //  namespace cgi -- END
+
+#endif
@@ -0,0 +1,118 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <utility>
+
+#include "GroupOccupancy.h"
+#include "MonotonicArena.h"
+#include "ThreadPool.h"
+
+namespace cgi {
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                            GroupOccupancy
+
+    GroupOccupancy::GroupOccupancy (const LogData& data,
+                                    const std::size_t& column)
+    {
+        if (column >= data.nofColumns()) {
+            throw "ERROR [GroupOccupancy::GroupOccupancy] Invalid column index";
+        }
+
+        const LogData::TimeArray& timesEntry = data.timesEntry();
+        const LogData::TimeArray& timesExit  = data.timesExit();
+        const LogData::CodeArray& groups     = data.column(column);
+        std::size_t nofGroups                = data.dictionary(column).size();
+
+        itsNames = data.dictionary(column).values();
+        itsCount.assign(nofGroups, 0);
+        itsTime.assign(nofGroups, 0);
+        itsMax.assign(nofGroups, 0);
+        itsMaxIntervals.resize(nofGroups);
+
+        // Times of entry already are sorted, so only the exits need sorting
+        typedef std::pair<std::int64_t, Dictionary::code_type> GroupedTime;
+        MonotonicArena arena (data.size()*sizeof(GroupedTime) + 1024);
+        std::vector<GroupedTime, PolymorphicAllocator<GroupedTime> > exits (&arena);
+        exits.reserve(data.size());
+        for (std::size_t n=0; n<data.size(); ++n) {
+            exits.push_back(GroupedTime(timesExit[n], groups[n]));
+        }
+        ThreadPool::global().parallelSort(exits.begin(), exits.end());
+
+        // Merge, placing exits before entries for simultaneous events
+        std::size_t n = 0;
+        auto itExit   = exits.begin();
+
+        while (n < data.size() || itExit != exits.end()) {
+            if (n == data.size() || (itExit != exits.end() && itExit->first <= timesEntry[n])) {
+                add(itExit->second, itExit->first, -1);
+                ++itExit;
+            } else {
+                add(groups[n], timesEntry[n], +1);
+                ++n;
+            }
+        }
+    }
+
+    // =========================================================================
+    //
+    //  Operator overloading
+    //
+    // =========================================================================
+
+    std::ostream& operator<< (std::ostream& os, const GroupOccupancy& rhs)
+    {
+        for (std::size_t n=0; n<rhs.nofGroups(); ++n) {
+            os << "[" << rhs.itsNames[n] << "] max = " << rhs.itsMax[n]
+               << ", intervals = " << rhs.itsMaxIntervals[n].size() << "\n";
+        }
+
+        return os;
+    }
+
+    // =========================================================================
+    //
+    //  Private methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                       add
+
+    void GroupOccupancy::add (const Dictionary::code_type& group,
+                              const std::int64_t& time,
+                              const int& delta)
+    {
+        // Close the step of the occupancy function of this group; steps before
+        // the first event of the group carry no visitors and are ignored.
+        if (time != itsTime[group]) {
+            int count = itsCount[group];
+
+            if (count > itsMax[group]) {
+                itsMax[group] = count;
+                itsMaxIntervals[group].clear();
+            }
+
+            if (count == itsMax[group] && count > 0) {
+                itsMaxIntervals[group].insert(DateTime(std::time_t(itsTime[group])),
+                                              DateTime(std::time_t(time)),
+                                              count);
+            }
+
+            itsTime[group] = time;
+        }
+
+        itsCount[group] += delta;
+    }
+
+}  //  namespace cgi -- END
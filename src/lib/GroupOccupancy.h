@@ -0,0 +1,99 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_GROUPOCCUPANCY_H
+#define CGI_GROUPOCCUPANCY_H
+
+/*!
+ * \file GroupOccupancy.h
+ * \brief Class for the occupancy per category of visitors
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "DateTime.h"
+#include "IntervalSet.h"
+#include "LogData.h"
+
+namespace cgi {
+
+    /*!
+     * \class GroupOccupancy
+     * \brief Number of visitors per category, e.g. staff vs. visitors
+     * \test test_GroupOccupancy.cc
+     *
+     * The log entries are grouped by one of the additional columns of the log
+     * (see cgi::BasicLogData::column()), such as ticket type or gate. A single
+     * sweep along the time-ordered events of all groups keeps track of the
+     * number of visitors for each group separately, yielding per group the
+     * maximum number of visitors and the time intervals during which it is
+     * reached. Since groups are identified by their dictionary code, all
+     * per-group state is held in arrays indexed by the code.
+     */
+    class GroupOccupancy {
+
+        /// Names of the groups, indexed by their code
+        std::vector<std::string> itsNames;
+        /// Current number of visitors per group
+        std::vector<int> itsCount;
+        /// Start of the current step of the occupancy function per group
+        std::vector<std::int64_t> itsTime;
+        /// Maximum number of visitors per group
+        std::vector<int> itsMax;
+        /// Time intervals during which the maximum is reached, per group
+        std::vector<IntervalSet<DateTime,int> > itsMaxIntervals;
+
+        /// Add event for group `group` to the sweep
+        void add (const Dictionary::code_type& group,
+                  const std::int64_t& time,
+                  const int& delta);
+
+    public:
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param data   -- Log data to evaluate.
+         * \param column -- Index of the additional column by which to group.
+         */
+        GroupOccupancy (const LogData& data,
+                        const std::size_t& column);
+
+        // === Operator overloading ============================================
+
+        /// Overloading of output stream operator
+        friend std::ostream& operator<< (std::ostream& os, const GroupOccupancy& rhs);
+
+        // === Parameter access ================================================
+
+        /// Get the number of groups
+        inline std::size_t nofGroups () const {
+            return itsNames.size();
+        }
+
+        /// Get the name of group `n`
+        inline const std::string& name (const std::size_t& n) const {
+            return itsNames[n];
+        }
+
+        /// Get the maximum number of visitors for group `n`
+        inline int maxNofVisitors (const std::size_t& n) const {
+            return itsMax[n];
+        }
+
+        /// Get the time intervals during which the maximum is reached for group `n`
+        inline const IntervalSet<DateTime,int>& maxIntervals (const std::size_t& n) const {
+            return itsMaxIntervals[n];
+        }
+
+    };  //  class GroupOccupancy -- END
+
+}  //  namespace cgi -- END
+
+#endif
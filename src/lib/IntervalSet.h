@@ -0,0 +1,263 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_INTERVALSET_H
+#define CGI_INTERVALSET_H
+
+/*!
+ * \file IntervalSet.h
+ * \brief Class for a sorted collection of non-overlapping intervals
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "Interval.h"
+
+namespace cgi {
+
+    /*!
+     * \class IntervalSet
+     * \brief Sorted collection of non-overlapping intervals with values
+     * \test test_IntervalSet.cc
+     *
+     * The intervals are half-open, \f$ [begin, end) \f$, and are kept in a
+     * contiguous array sorted by their begin. Inserting an interval
+     *
+     * \li overwrites the part of any existing interval it overlaps with, and
+     * \li is merged with adjacent or overlapping intervals of equal value,
+     *
+     * such that e.g. a plateau in the number of visitors, reported as series of
+     * adjacent intervals, is stored as a single interval. Since the intervals do
+     * not overlap, both their begins and their ends are sorted, which allows
+     * for lookups by point or by range in \f$ O(\log n) \f$. Appending in order
+     * -- as is the case when filling the set from a sweep -- takes constant
+     * amortized time.
+     */
+    template <typename K, typename T>
+    class IntervalSet {
+
+    public:
+
+        typedef Interval<K,T>                                   value_type;
+        typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+    private:
+
+        /// Intervals, sorted by their begin
+        std::vector<value_type> itsIntervals;
+
+    public:
+
+        // === Construction ====================================================
+
+        /// Default constructor
+        IntervalSet () {}
+
+        // === Parameter access ================================================
+
+        /// Get the number of intervals
+        inline std::size_t size () const {
+            return itsIntervals.size();
+        }
+
+        /// Is the set empty?
+        inline bool empty () const {
+            return itsIntervals.empty();
+        }
+
+        /// Get the interval at position `n`
+        inline const value_type& operator[] (const std::size_t& n) const {
+            return itsIntervals[n];
+        }
+
+        /// Get iterator to the first interval
+        inline const_iterator begin () const {
+            return itsIntervals.begin();
+        }
+
+        /// Get iterator past the last interval
+        inline const_iterator end () const {
+            return itsIntervals.end();
+        }
+
+        // === Public methods ==================================================
+
+        /// Remove all intervals
+        void clear () {
+            itsIntervals.clear();
+        }
+
+        /*!
+         * \brief Insert interval, merging with neighbours of equal value
+         * \param interval -- Interval to insert; empty intervals are ignored.
+         */
+        void insert (const value_type& interval) {
+            const K& b = interval.begin();
+            const K& e = interval.end();
+
+            if (!(b < e)) {
+                return;
+            }
+
+            // Fast path: append after the last interval
+            if (itsIntervals.empty() || !(b < itsIntervals.back().end())) {
+                if (!itsIntervals.empty()
+                    && itsIntervals.back().end() == b
+                    && itsIntervals.back().value() == interval.value()) {
+                    itsIntervals.back().setEnd(e);
+                } else {
+                    itsIntervals.push_back(interval);
+                }
+                return;
+            }
+
+            // Intervals [first,last) overlapping with the new one
+            auto first = std::upper_bound(itsIntervals.begin(), itsIntervals.end(), b,
+                                          [] (const K& p, const value_type& item) {
+                                              return p < item.end();
+                                          });
+            auto last  = std::lower_bound(first, itsIntervals.end(), e,
+                                          [] (const value_type& item, const K& p) {
+                                              return item.begin() < p;
+                                          });
+
+            std::vector<value_type> replacement;
+
+            // Remainder of intervals sticking out on either side
+            if (first != last && first->begin() < b) {
+                replacement.push_back(value_type(first->begin(), b, first->value()));
+            }
+            replacement.push_back(interval);
+            if (first != last && e < (last-1)->end()) {
+                replacement.push_back(value_type(e, (last-1)->end(), (last-1)->value()));
+            }
+
+            // Merge with adjacent neighbours of equal value
+            if (first != itsIntervals.begin()
+                && (first-1)->end() == replacement.front().begin()
+                && (first-1)->value() == replacement.front().value()) {
+                --first;
+                replacement.front().setBegin(first->begin());
+            }
+            if (last != itsIntervals.end()
+                && last->begin() == replacement.back().end()
+                && last->value() == replacement.back().value()) {
+                replacement.back().setEnd(last->end());
+                ++last;
+            }
+
+            // Merge remainders with the new interval, if of equal value
+            std::vector<value_type> merged;
+            for (auto it=replacement.begin(); it!=replacement.end(); ++it) {
+                if (!merged.empty() && merged.back().end() == it->begin()
+                    && merged.back().value() == it->value()) {
+                    merged.back().setEnd(it->end());
+                } else {
+                    merged.push_back(*it);
+                }
+            }
+
+            auto pos = itsIntervals.erase(first, last);
+            itsIntervals.insert(pos, merged.begin(), merged.end());
+        }
+
+        /*!
+         * \brief Insert interval, merging with neighbours of equal value
+         * \param begin -- Begin of the interval.
+         * \param end   -- End of the interval.
+         * \param value -- Value associated with the interval.
+         */
+        void insert (const K& begin,
+                     const K& end,
+                     const T& value=T()) {
+            insert(value_type(begin, end, value));
+        }
+
+        /*!
+         * \brief Find the interval containing `point`
+         * \return Iterator to the interval, or end() if there is none.
+         */
+        const_iterator find (const K& point) const {
+            auto it = std::upper_bound(itsIntervals.begin(), itsIntervals.end(), point,
+                                       [] (const K& p, const value_type& item) {
+                                           return p < item.end();
+                                       });
+            if (it != itsIntervals.end() && !(point < it->begin())) {
+                return it;
+            }
+            return itsIntervals.end();
+        }
+
+        /// Is `point` contained in any of the intervals?
+        bool contains (const K& point) const {
+            return find(point) != end();
+        }
+
+        /*!
+         * \brief Get the intervals overlapping with \f$ [begin, end) \f$
+         * \return Pair of iterators delimiting the (contiguous) overlapping
+         *         intervals.
+         */
+        std::pair<const_iterator,const_iterator> overlapping (const K& begin,
+                                                              const K& end) const {
+            auto first = std::upper_bound(itsIntervals.begin(), itsIntervals.end(), begin,
+                                          [] (const K& p, const value_type& item) {
+                                              return p < item.end();
+                                          });
+            auto last  = std::lower_bound(first, itsIntervals.end(), end,
+                                          [] (const value_type& item, const K& p) {
+                                              return item.begin() < p;
+                                          });
+            if (!(begin < end)) {
+                last = first;
+            }
+            return std::make_pair(const_iterator(first), const_iterator(last));
+        }
+
+        /// Does any of the intervals overlap with \f$ [begin, end) \f$?
+        bool overlaps (const K& begin,
+                       const K& end) const {
+            std::pair<const_iterator,const_iterator> range = overlapping(begin, end);
+            return range.first != range.second;
+        }
+
+        /*!
+         * \brief Get the intervals restricted to the window \f$ [begin, end) \f$
+         * \param begin -- Begin of the window.
+         * \param end   -- End of the window.
+         */
+        IntervalSet clip (const K& begin,
+                          const K& end) const {
+            IntervalSet result;
+            std::pair<const_iterator,const_iterator> range = overlapping(begin, end);
+
+            for (auto it=range.first; it!=range.second; ++it) {
+                result.itsIntervals.push_back(value_type(it->begin() < begin ? begin : it->begin(),
+                                                         end < it->end() ? end : it->end(),
+                                                         it->value()));
+            }
+
+            return result;
+        }
+
+    };  //  class IntervalSet -- END
+
+}  //  namespace cgi -- END
+
+/// Overloading of output operator for cgi::IntervalSet class
+template <typename K, typename T>
+inline std::ostream& operator<<(std::ostream& os, const cgi::IntervalSet<K,T>& obj)
+{
+    for (auto it=obj.begin(); it!=obj.end(); ++it) {
+        os << *it << "\n";
+    }
+
+    return os;
+}
+
+#endif
@@ -0,0 +1,146 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include "Iso8601.h"
+
+namespace cgi {
+
+    /*!
+     * \brief Parse a fixed number of decimal digits
+     * \param it     -- Position of the first digit; advanced past the digits.
+     * \param end    -- End of the input.
+     * \param digits -- Number of digits to parse.
+     * \retval value -- Decoded value.
+     * \return Were there `digits` decimal digits available?
+     */
+    static bool parseDigits (const char*& it,
+                             const char* end,
+                             const int& digits,
+                             int& value)
+    {
+        if (end-it < digits) {
+            return false;
+        }
+
+        value = 0;
+        for (int n=0; n<digits; ++n, ++it) {
+            if (*it < '0' || *it > '9') {
+                return false;
+            }
+            value = 10*value + (*it-'0');
+        }
+
+        return true;
+    }
+
+    // =========================================================================
+    //
+    //  Public static methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                     parse
+
+    bool Iso8601::parse (const char* begin,
+                         const char* end,
+                         std::int64_t& seconds,
+                         std::int64_t& nanoseconds)
+    {
+        const char* it = begin;
+        int year       = 0;
+        int month      = 0;
+        int day        = 0;
+        int hour       = 0;
+        int minute     = 0;
+        int second     = 0;
+        std::int64_t fraction = 0;
+        std::int64_t offset   = 0;
+
+        // Date: YYYY-MM-DD
+        if (!parseDigits(it, end, 4, year)
+            || it == end || *it++ != '-'
+            || !parseDigits(it, end, 2, month)
+            || it == end || *it++ != '-'
+            || !parseDigits(it, end, 2, day)
+            || month < 1 || month > 12 || day < 1 || day > 31) {
+            return false;
+        }
+
+        // Time: Thh:mm[:ss[.fffffffff]]
+        if (it != end && (*it == 'T' || *it == ' ')) {
+            ++it;
+            if (!parseDigits(it, end, 2, hour)
+                || it == end || *it++ != ':'
+                || !parseDigits(it, end, 2, minute)
+                || hour > 24 || minute > 59) {
+                return false;
+            }
+            if (it != end && *it == ':') {
+                ++it;
+                if (!parseDigits(it, end, 2, second) || second > 60) {
+                    return false;
+                }
+                if (it != end && *it == '.') {
+                    std::int64_t scale = 1000000000;
+                    for (++it; it != end && *it >= '0' && *it <= '9'; ++it) {
+                        if (scale > 1) {
+                            scale /= 10;
+                            fraction += scale*(*it-'0');
+                        }
+                    }
+                }
+            }
+        }
+
+        // UTC offset: Z, +hh[:mm] or -hh[:mm]
+        if (it != end && *it == 'Z') {
+            ++it;
+        } else if (it != end && (*it == '+' || *it == '-')) {
+            int sign          = (*it++ == '-') ? -1 : +1;
+            int offsetHours   = 0;
+            int offsetMinutes = 0;
+            if (!parseDigits(it, end, 2, offsetHours)) {
+                return false;
+            }
+            if (it != end && *it == ':') {
+                ++it;
+            }
+            if (it != end && !parseDigits(it, end, 2, offsetMinutes)) {
+                return false;
+            }
+            offset = sign * (3600*offsetHours + 60*offsetMinutes);
+        }
+
+        if (it != end) {
+            return false;
+        }
+
+        seconds     = 86400*daysFromCivil(year, month, day)
+            + 3600*hour + 60*minute + second - offset;
+        nanoseconds = fraction;
+
+        return true;
+    }
+
+    //__________________________________________________________________________
+    //                                                             daysFromCivil
+
+    std::int64_t Iso8601::daysFromCivil (std::int64_t year,
+                                         const int& month,
+                                         const int& day)
+    {
+        // Count years from March on, such that the leap day is the last day
+        year -= (month <= 2) ? 1 : 0;
+
+        std::int64_t era = (year >= 0 ? year : year-399) / 400;
+        std::int64_t yoe = year - era*400;                                  // [0, 399]
+        std::int64_t doy = (153*(month + (month > 2 ? -3 : 9)) + 2)/5 + day-1;  // [0, 365]
+        std::int64_t doe = yoe*365 + yoe/4 - yoe/100 + doy;                 // [0, 146096]
+
+        return era*146097 + doe - 719468;
+    }
+
+}  //  namespace cgi -- END
@@ -0,0 +1,83 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_ISO8601_H
+#define CGI_ISO8601_H
+
+/*!
+ * \file Iso8601.h
+ * \brief Parser for timestamps in ISO 8601 format
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cgi {
+
+    /*!
+     * \class Iso8601
+     * \brief Parser for timestamps in ISO 8601 format
+     * \test test_Iso8601.cc
+     *
+     * Decodes timestamps of the form
+     *
+     * \verbatim
+       YYYY-MM-DD[Thh:mm[:ss[.fffffffff]]][Z|+hh[:mm]|-hh[:mm]]
+       \endverbatim
+     *
+     * directly from the characters into seconds since the Unix epoch plus a
+     * number of nanoseconds, without going through ``std::tm`` or the C library
+     * (``strptime`` is unable to handle fractional seconds). A space may be used
+     * instead of the ``T`` separating date and time; digits of the fraction
+     * beyond nanosecond resolution are truncated. Timestamps carrying a UTC
+     * offset are converted to UTC; timestamps without offset are taken to be
+     * given in UTC as well.
+     */
+    class Iso8601 {
+
+    public:
+
+        // === Public static methods ===========================================
+
+        /*!
+         * \brief Parse the characters in [begin,end) as ISO 8601 timestamp
+         * \param begin       -- Pointer to the first character.
+         * \param end         -- Pointer past the last character.
+         * \retval seconds     -- Seconds since the Unix epoch (UTC).
+         * \retval nanoseconds -- Fraction of the second, in nanoseconds.
+         * \return Could the characters be parsed as timestamp? If not, the
+         *         return values are left unchanged.
+         */
+        static bool parse (const char* begin,
+                           const char* end,
+                           std::int64_t& seconds,
+                           std::int64_t& nanoseconds);
+
+        /*!
+         * \brief Does the text in [begin,end) start like a calendar date?
+         *
+         * Cheap check to tell ISO 8601 timestamps (``YYYY-MM-DD...``) from
+         * plain times of day (``HH:MM``).
+         */
+        static inline bool isDate (const char* begin,
+                                   const char* end) {
+            return end-begin >= 10 && begin[4] == '-' && begin[7] == '-';
+        }
+
+        /*!
+         * \brief Get the number of days since 1970-01-01 for a calendar date
+         * \param year  -- Year of the proleptic Gregorian calendar.
+         * \param month -- Month, in the range [1,12].
+         * \param day   -- Day of the month, in the range [1,31].
+         */
+        static std::int64_t daysFromCivil (std::int64_t year,
+                                           const int& month,
+                                           const int& day);
+
+    };  //  class Iso8601 -- END
+
+}  //  namespace cgi -- END
+
+#endif
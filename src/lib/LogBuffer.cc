@@ -0,0 +1,185 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "LogBuffer.h"
+
+namespace cgi {
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                 LogBuffer
+
+    LogBuffer::LogBuffer (const std::string& filename,
+                          const std::size_t& offset,
+                          const std::size_t& length)
+        : itsMapping(NULL),
+          itsData(NULL),
+          itsSize(0),
+          itsMappedSize(0),
+          itsIsOpen(false),
+          itsReference(LogEntryView::startOfDay())
+    {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd == -1) {
+            return;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            // nothing to read from
+        } else if (!S_ISREG(info.st_mode)) {
+            // pipes and the like cannot be mapped, hence are read instead
+            readStream(fd, offset, length);
+        } else {
+            itsIsOpen = true;
+            std::size_t fileSize = info.st_size;
+            std::size_t size     = offset < fileSize ? std::min(length, fileSize-offset) : 0;
+            if (size > 0) {
+                // The offset of the mapping needs to be aligned to the page size
+                std::size_t pageSize = sysconf(_SC_PAGESIZE);
+                std::size_t base     = offset - offset%pageSize;
+                void* mapping = mmap(NULL, size + (offset-base), PROT_READ, MAP_PRIVATE, fd, base);
+                if (mapping != MAP_FAILED) {
+                    itsMapping    = static_cast<const char*>(mapping);
+                    itsData       = itsMapping + (offset-base);
+                    itsSize       = size;
+                    itsMappedSize = size + (offset-base);
+                    madvise(mapping, itsMappedSize, MADV_SEQUENTIAL);
+                } else {
+                    itsIsOpen = false;
+                }
+            }
+        }
+
+        close(fd);
+    }
+
+    //__________________________________________________________________________
+    //                                                                 LogBuffer
+
+    LogBuffer::LogBuffer (const char* data,
+                          const std::size_t& size)
+        : itsMapping(NULL),
+          itsData(data),
+          itsSize(size),
+          itsMappedSize(0),
+          itsIsOpen(true),
+          itsReference(LogEntryView::startOfDay())
+    {
+    }
+
+    //__________________________________________________________________________
+    //                                                                ~LogBuffer
+
+    LogBuffer::~LogBuffer ()
+    {
+        if (itsMappedSize > 0) {
+            munmap(const_cast<char*>(itsMapping), itsMappedSize);
+        }
+    }
+
+    // =========================================================================
+    //
+    //  Private methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                readStream
+
+    void LogBuffer::readStream (int fd,
+                                const std::size_t& offset,
+                                const std::size_t& length)
+    {
+        const std::size_t chunkSize = 1<<16;
+        std::size_t skip = offset;
+        std::size_t size = 0;
+
+        while (size < length) {
+            std::size_t chunk = std::min(chunkSize, length-size);
+            itsStorage.resize(size+chunk);
+            ssize_t nofBytes = read(fd, &itsStorage[size], chunk);
+            if (nofBytes < 0) {
+                itsStorage.clear();
+                return;
+            } else if (nofBytes == 0) {
+                break;
+            }
+            // discard the contents before the start of the requested region
+            std::size_t discard = std::min(skip, std::size_t(nofBytes));
+            if (discard > 0) {
+                std::memmove(&itsStorage[size], &itsStorage[size+discard], nofBytes-discard);
+                skip -= discard;
+            }
+            size += nofBytes-discard;
+        }
+
+        itsStorage.resize(size);
+        itsData   = itsStorage.empty() ? NULL : &itsStorage[0];
+        itsSize   = size;
+        itsIsOpen = true;
+    }
+
+    // =========================================================================
+    //
+    //  Iterators
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                            const_iterator
+
+    LogBuffer::const_iterator::const_iterator (const char* begin,
+                                               const char* end,
+                                               const std::time_t& reference)
+        : itsLine(begin),
+          itsLineEnd(begin),
+          itsEnd(end),
+          itsReference(reference)
+    {
+        findLine();
+    }
+
+    //__________________________________________________________________________
+    //                                                                operator++
+
+    LogBuffer::const_iterator& LogBuffer::const_iterator::operator++ ()
+    {
+        itsLine = itsLineEnd < itsEnd ? itsLineEnd+1 : itsEnd;
+        findLine();
+        return *this;
+    }
+
+    //__________________________________________________________________________
+    //                                                                  findLine
+
+    void LogBuffer::const_iterator::findLine ()
+    {
+        while (itsLine < itsEnd) {
+            const char* eol = static_cast<const char*>(std::memchr(itsLine, '\n', itsEnd-itsLine));
+            itsLineEnd = eol ? eol : itsEnd;
+            // skip empty lines
+            if (itsLineEnd > itsLine && !(itsLineEnd == itsLine+1 && *itsLine == '\r')) {
+                return;
+            }
+            itsLine = itsLineEnd < itsEnd ? itsLineEnd+1 : itsEnd;
+        }
+        itsLine    = itsEnd;
+        itsLineEnd = itsEnd;
+    }
+
+}  //  namespace cgi -- END
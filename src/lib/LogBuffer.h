@@ -0,0 +1,195 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_LOGBUFFER_H
+#define CGI_LOGBUFFER_H
+
+/*!
+ * \file LogBuffer.h
+ * \brief Class for the contiguous input buffer holding a log file
+ */
+
+#include <cstddef>
+#include <ctime>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "LogEntryView.h"
+
+namespace cgi {
+
+    /*!
+     * \class LogBuffer
+     * \brief Contiguous input buffer holding the contents of a log file
+     * \test test_LogBuffer.cc
+     *
+     * The contents of the log file are mapped into memory in one go; iterating
+     * over the buffer yields a cgi::LogEntryView per (non-empty) line, which
+     * refers to the bytes held by the buffer, such that walking through a log
+     * does not require any memory allocations. Input sources which cannot be
+     * mapped -- pipes, FIFOs or ``/dev/stdin`` -- are read into a buffer owned
+     * by the object instead.
+     */
+    class LogBuffer {
+
+        /// Pointer to the start of the memory mapping, if mapped from a file
+        const char* itsMapping;
+        /// Pointer to the start of the buffer
+        const char* itsData;
+        /// Size of the buffer (in bytes)
+        std::size_t itsSize;
+        /// Size of the memory mapping, if the buffer is mapped from a file
+        std::size_t itsMappedSize;
+        /// Contents of the input source, if it cannot be mapped into memory
+        std::vector<char> itsStorage;
+        /// Has the input source been opened successfully?
+        bool itsIsOpen;
+        /// Start of the day, to which times of day are referring
+        std::time_t itsReference;
+
+    public:
+
+        /*!
+         * \class const_iterator
+         * \brief Forward iterator over the log entries in the buffer
+         */
+        class const_iterator {
+
+            /// Start of the current line
+            const char* itsLine;
+            /// End of the current line
+            const char* itsLineEnd;
+            /// End of the buffer
+            const char* itsEnd;
+            /// Start of the day, to which times of day are referring
+            std::time_t itsReference;
+
+            /// Find the end of the current line, skipping empty lines
+            void findLine ();
+
+        public:
+
+            typedef std::forward_iterator_tag iterator_category;
+            typedef LogEntryView              value_type;
+            typedef std::ptrdiff_t            difference_type;
+            typedef const LogEntryView*       pointer;
+            typedef LogEntryView              reference;
+
+            /// Argumented constructor
+            const_iterator (const char* begin,
+                            const char* end,
+                            const std::time_t& reference);
+
+            /// Get the log entry at the current position
+            LogEntryView operator* () const {
+                return LogEntryView(itsLine, itsLineEnd-itsLine, itsReference);
+            }
+
+            /// Get pointer to the first character of the current line
+            inline const char* line () const {
+                return itsLine;
+            }
+
+            /// Get the number of characters of the current line
+            inline std::size_t lineSize () const {
+                return itsLineEnd-itsLine;
+            }
+
+            /// Advance to the next log entry
+            const_iterator& operator++ ();
+
+            /// Comparison operator
+            bool operator== (const const_iterator& rhs) const {
+                return itsLine == rhs.itsLine;
+            }
+
+            /// Comparison operator
+            bool operator!= (const const_iterator& rhs) const {
+                return itsLine != rhs.itsLine;
+            }
+
+        };  //  class const_iterator -- END
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor, mapping the contents of a file
+         * \param filename -- Name of the input file.
+         * \param offset   -- Offset (in bytes) of the region to map; expected
+         *        to be placed at the start of a line (see cgi::TimeIndex).
+         * \param length   -- Length (in bytes) of the region to map; by default
+         *        the region extends to the end of the file.
+         *
+         * Only the requested region is mapped, such that no other parts of the
+         * file are read. If the input is not a regular file (e.g. a pipe), its
+         * contents are read sequentially instead, discarding everything before
+         * `offset`.
+         */
+        LogBuffer (const std::string& filename,
+                   const std::size_t& offset=0,
+                   const std::size_t& length=std::size_t(-1));
+
+        /*!
+         * \brief Argumented constructor, referring to an existing buffer
+         * \param data -- Pointer to the start of the buffer.
+         * \param size -- Size of the buffer (in bytes).
+         */
+        LogBuffer (const char* data,
+                   const std::size_t& size);
+
+        /// Destructor
+        ~LogBuffer ();
+
+        // === Parameter access ================================================
+
+        /// Has the input source been opened successfully?
+        inline bool isOpen () const {
+            return itsIsOpen;
+        }
+
+        /// Get pointer to the start of the buffer
+        inline const char* data () const {
+            return itsData;
+        }
+
+        /// Get the size of the buffer (in bytes)
+        inline std::size_t size () const {
+            return itsSize;
+        }
+
+        /// Get the start of the day, to which times of day are referring
+        inline std::time_t reference () const {
+            return itsReference;
+        }
+
+        // === Iterators =======================================================
+
+        /// Get iterator to the first log entry
+        inline const_iterator begin () const {
+            return const_iterator(itsData, itsData+itsSize, itsReference);
+        }
+
+        /// Get iterator past the last log entry
+        inline const_iterator end () const {
+            return const_iterator(itsData+itsSize, itsData+itsSize, itsReference);
+        }
+
+    private:
+
+        /// Read the contents of a non-seekable input source into the buffer
+        void readStream (int fd,
+                         const std::size_t& offset,
+                         const std::size_t& length);
+
+        // Objects of this type hold on to a memory mapping
+        LogBuffer (const LogBuffer&);
+        LogBuffer& operator= (const LogBuffer&);
+
+    };  //  class LogBuffer -- END
+
+}  //  namespace cgi -- END
+
+#endif
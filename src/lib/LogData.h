@@ -10,60 +10,461 @@
 #ifndef CGI_LOGDATA_H
 #define CGI_LOGDATA_H
 
+#include <algorithm>
+#include <cstdint>
 #include <fstream>
+#include <iterator>
 #include <iostream>
 #include <map>
+#include <new>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "Clock.h"
+#include "Dictionary.h"
+#include "Event.h"
+#include "LogBuffer.h"
+#include "LogDecoder.h"
 #include "LogEntry.h"
+#include "LogEntryView.h"
+#include "LogPipeline.h"
+#include "MemoryResource.h"
+#include "MonotonicArena.h"
+#include "PartialAggregate.h"
+#include "PolymorphicAllocator.h"
+#include "PrefixScan.h"
+#include "TimeIndex.h"
 #include "TimePoint.h"
+#include "ThreadPool.h"
+#include "TimeWindow.h"
 
 namespace cgi {
 
     /*!
-     * \class LogData
+     * \class BasicLogData
      * \brief Container to the storage of log data.
      * \test test_LogData.cc
+     *
+     * Log entries are stored as contiguous arrays of entry and exit times --
+     * rather than as a set of individual cgi::LogEntry objects -- which are
+     * sorted by time of entry in bulk once the data have been read. Keeping the
+     * log entries in their original format is optional (see setKeepRawData());
+     * without it the memory footprint amounts to 16 bytes per visit -- plus
+     * another 16 bytes per visit once the list of events is cached. Visitors
+     * with identical time of entry are retained as separate log entries.
+     *
+     * Fields following the times of entry and exit -- e.g. visitor ID, ticket
+     * type or gate -- are kept as additional columns, each of which is stored
+     * as an array of integer codes along with the cgi::Dictionary mapping codes
+     * onto the original values (see column() and dictionary()).
+     *
+     * If a time window is set (see setTimeWindow()), log entries which cannot
+     * overlap with the window are skipped while reading, based on the cheaply
+     * decoded time of entry and -- only if required -- time of exit, before the
+     * remainder of the entry is decoded or stored. If in addition an
+     * up-to-date cgi::TimeIndex is available for a log sorted by time of entry,
+     * only the region of the file which may hold visits overlapping with the
+     * window is read in the first place.
+     *
+     * The storage is obtained from a cgi::MemoryResource, which can be provided
+     * upon construction. Temporaries created during the evaluation of the data
+     * -- e.g. the list of events -- are placed into a cgi::MonotonicArena local
+     * to the method call, such that they are released in one go.
+     *
+     * Quantities derived from the log entries -- the time-ordered list of
+     * events, the range of times and the state of the sweep for the maximum
+     * number of visitors -- are computed upon first request and cached, such
+     * that repeated queries on unchanged data come at no extra cost. Appending
+     * data (see readData()) merges the new entries into the cached state rather
+     * than discarding it; only overwriting the data invalidates the caches.
+     * Since the caches are filled by const methods, concurrent calls of these
+     * on the same object require external synchronization.
+     *
+     * Access to the log entries is provided without copying the data: iterating
+     * over the log -- via begin()/end(), forEach() or the sub-ranges returned by
+     * chunks() -- yields a cgi::LogEntryView per log entry, which refers to the
+     * data held by the LogData object.
+     *
+     * The container is a template over the type of record handed out for the
+     * individual log entries and over the representation of time:
+     *
+     * \li `Record` -- Type of the (non-owning) log entry, constructed from
+     *     `(const char* data, std::size_t size, DateTime timeEntry, DateTime
+     *     timeExit)`; cgi::LogEntryView by default.
+     * \li `Clock` -- Representation of points in time, see cgi::TickClock;
+     *     cgi::SecondsClock by default.
+     *
+     * Times -- as stored in timesEntry() and timesExit() and as contained in the
+     * list of events() -- are given in ticks of the `Clock`. Since both types
+     * are resolved at compile time, reading and evaluating the log data is
+     * specialized for each layout without any virtual dispatch. The default
+     * layout is available as cgi::LogData, which is instantiated once within
+     * the library.
      */
-    class LogData {
+    template <typename Record=LogEntryView, typename Clock=SecondsClock>
+    class BasicLogData {
+
+    public:
+
+        /// Type of the log entries handed out
+        typedef Record record_type;
+        /// Representation of points in time
+        typedef Clock clock_type;
+        /// Type used for the storage of points in time
+        typedef typename Clock::tick_type tick_type;
+
+        /// Array of times, as used for the storage of the log entries
+        typedef std::vector<tick_type, PolymorphicAllocator<tick_type> > TimeArray;
+        /// Array of events
+        typedef std::vector<Event, PolymorphicAllocator<Event> > EventArray;
+        /// Map with ordered values of entrance events
+        typedef std::multimap<DateTime, int, std::less<DateTime>,
+                              PolymorphicAllocator<std::pair<const DateTime,int> > > TimepointMap;
+        /// Array of dictionary codes, as used for the storage of additional columns
+        typedef std::vector<Dictionary::code_type,
+                            PolymorphicAllocator<Dictionary::code_type> > CodeArray;
+
+        /*!
+         * \class const_iterator
+         * \brief Random access iterator over the log entries
+         *
+         * Dereferencing yields a `Record` by value, which refers to the data
+         * held by the LogData object.
+         */
+        class const_iterator {
+
+            /// Log data over which to iterate
+            const BasicLogData* itsData;
+            /// Index of the current log entry
+            std::size_t itsIndex;
+
+        public:
+
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef Record                          value_type;
+            typedef std::ptrdiff_t                  difference_type;
+            typedef const Record*                   pointer;
+            typedef Record                          reference;
+
+            /// Default constructor
+            const_iterator () : itsData(NULL), itsIndex(0) {}
+
+            /// Argumented constructor
+            const_iterator (const BasicLogData* data,
+                            const std::size_t& index) : itsData(data),
+                                                        itsIndex(index) {}
+
+            /// Get the log entry at the current position
+            Record operator* () const {
+                return (*itsData)[itsIndex];
+            }
+
+            /// Get the log entry at offset `n` from the current position
+            Record operator[] (const difference_type& n) const {
+                return (*itsData)[itsIndex+n];
+            }
+
+            /// Get the index of the current log entry
+            inline std::size_t index () const {
+                return itsIndex;
+            }
+
+            const_iterator& operator++ () { ++itsIndex; return *this; }
+            const_iterator& operator-- () { --itsIndex; return *this; }
+            const_iterator operator++ (int) { const_iterator tmp (*this); ++itsIndex; return tmp; }
+            const_iterator operator-- (int) { const_iterator tmp (*this); --itsIndex; return tmp; }
+            const_iterator& operator+= (const difference_type& n) { itsIndex += n; return *this; }
+            const_iterator& operator-= (const difference_type& n) { itsIndex -= n; return *this; }
+            const_iterator operator+ (const difference_type& n) const { return const_iterator(itsData, itsIndex+n); }
+            const_iterator operator- (const difference_type& n) const { return const_iterator(itsData, itsIndex-n); }
+            difference_type operator- (const const_iterator& rhs) const { return difference_type(itsIndex) - difference_type(rhs.itsIndex); }
+
+            bool operator== (const const_iterator& rhs) const { return itsIndex == rhs.itsIndex; }
+            bool operator!= (const const_iterator& rhs) const { return itsIndex != rhs.itsIndex; }
+            bool operator<  (const const_iterator& rhs) const { return itsIndex <  rhs.itsIndex; }
+            bool operator>  (const const_iterator& rhs) const { return itsIndex >  rhs.itsIndex; }
+            bool operator<= (const const_iterator& rhs) const { return itsIndex <= rhs.itsIndex; }
+            bool operator>= (const const_iterator& rhs) const { return itsIndex >= rhs.itsIndex; }
+
+        };  //  class const_iterator -- END
+
+        /*!
+         * \class Range
+         * \brief Contiguous sub-range of the log entries
+         *
+         * Splitting the log into ranges -- see chunks() -- allows independent
+         * consumers to work on separate parts of the log without copying.
+         */
+        class Range {
+
+            /// Iterator to the first log entry of the range
+            const_iterator itsBegin;
+            /// Iterator past the last log entry of the range
+            const_iterator itsEnd;
+
+        public:
+
+            /// Argumented constructor
+            Range (const const_iterator& begin,
+                   const const_iterator& end) : itsBegin(begin),
+                                                itsEnd(end) {}
+
+            /// Get iterator to the first log entry of the range
+            inline const_iterator begin () const {
+                return itsBegin;
+            }
+
+            /// Get iterator past the last log entry of the range
+            inline const_iterator end () const {
+                return itsEnd;
+            }
+
+            /// Get the number of log entries in the range
+            inline std::size_t size () const {
+                return itsEnd - itsBegin;
+            }
+
+            /// Is the range empty?
+            inline bool empty () const {
+                return itsBegin == itsEnd;
+            }
+
+        };  //  class Range -- END
+
+    private:
 
         /// Name of the input file from which the log data are read
         std::vector<std::string> itsDataSources;
-        /// (Sorted) Log data read from the input file
-        std::set<LogEntry> itsData;
+        /// Keep the log entries in their original format?
+        bool itsKeepRawData;
+        /// Time window outside of which log entries are skipped while reading
+        TimeWindow itsTimeWindow;
+        /// Times of entry, sorted in ascending order
+        TimeArray itsTimeEntry;
+        /// Times of exit, in the order of the times of entry
+        TimeArray itsTimeExit;
+        /// Log entries in their original format (only if requested)
+        std::vector<std::string, PolymorphicAllocator<std::string> > itsRawData;
+        /// Additional columns, as dictionary codes in the order of the times of entry
+        std::vector<CodeArray> itsColumns;
+        /// Dictionaries for the additional columns
+        std::vector<Dictionary> itsDictionaries;
+        /// Cached time-ordered list of events, see events()
+        mutable EventArray itsEvents;
+        /// Is the cached list of events up to date?
+        mutable bool itsEventsValid;
+        /// Cached range of times (first entry, last exit), see rangeOfTimes()
+        mutable std::pair<tick_type,tick_type> itsRange;
+        /// Is the cached range of times up to date?
+        mutable bool itsRangeValid;
+        /// Number of cached events already included in the sweep
+        mutable std::size_t itsSweepPos;
+        /// Number of visitors after the events included in the sweep
+        mutable int itsSweepCount;
+        /// Maximum number of visitors; negative if not known
+        mutable int itsMaxNofVisitors;
+
+        /// Log entry decoded by a parser stage, see readData()
+        struct ParsedEntry {
+            /// Time of entry
+            tick_type timeEntry;
+            /// Time of exit
+            tick_type timeExit;
+            /// Pointer to the first character of the log entry
+            const char* line;
+            /// Pointer to the separator in front of the additional fields
+            const char* fields;
+            /// Pointer past the last character of the log entry
+            const char* end;
+        };
+
+        /// Log entries decoded from a block of the input, see readData()
+        struct ParsedBlock {
+            /// Log entries within the time window
+            std::vector<ParsedEntry> entries;
+            /// Number of log entries outside the time window
+            std::size_t skipped;
+
+            ParsedBlock () : skipped(0) {}
+        };
+
+        /// Convert a time window in ticks to the enclosing window in seconds
+        static TimeWindow secondsWindow (const TimeWindow& window);
+
+        /// Decode the times of the log entries in [begin,end); thread-safe
+        void parseBlock (const char* begin,
+                         const char* end,
+                         const std::time_t& reference,
+                         ParsedBlock& block) const;
+
+        /// Append the log entries decoded by parseBlock()
+        void appendBlock (const ParsedBlock& block);
+
+        /// Decode the additional columns of a log entry from [begin,end)
+        void readColumns (const char* begin,
+                          const char* end);
+
+        /// Sort the log entries starting at position `pos` into the existing data
+        void sortData (const std::size_t& pos);
+
+        /// Fill `result` with the time-ordered list of entrance events
+        template <typename Array>
+        void fillEvents (Array& result,
+                         MemoryResource* resource) const;
+
+        /// Get the cached time-ordered list of events, filling it if required
+        const EventArray& cachedEvents () const;
+
+        /// Invalidate all quantities derived from the log entries
+        void clearCache ();
+
+        /// Merge the log entries starting at position `pos` into the caches
+        void updateCache (const std::size_t& pos);
 
     public:
 
         // === Construction ====================================================
 
-        /// Default constructor
-        LogData () {
-            itsDataSources.clear();
-            itsData.clear();
+        /*!
+         * \brief Default constructor
+         * \param resource -- Resource from which the storage is obtained.
+         */
+        BasicLogData (MemoryResource* resource=newDeleteResource())
+            : itsKeepRawData(false),
+              itsTimeEntry(resource),
+              itsTimeExit(resource),
+              itsRawData(resource),
+              itsEvents(resource) {
+            clearCache();
         }
 
-        /// Argumented constructor
-        LogData (const std::string& filename) {
+        /*!
+         * \brief Argumented constructor
+         * \param filename    -- Name of the input file from which the log data
+         *        are read
+         * \param keepRawData -- Keep the log entries in their original format?
+         * \param resource    -- Resource from which the storage is obtained.
+         */
+        BasicLogData (const std::string& filename,
+                      const bool& keepRawData=false,
+                      MemoryResource* resource=newDeleteResource())
+            : itsKeepRawData(keepRawData),
+              itsTimeEntry(resource),
+              itsTimeExit(resource),
+              itsRawData(resource),
+              itsEvents(resource) {
+            clearCache();
             readData(filename, true);
         }
 
-        // === Operator overloading ============================================
-
-        /// Overloading of output stream operator
-        friend std::ostream& operator<< (std::ostream& os, const LogData& rhs);
-
         // === Parameter access ================================================
 
         /// Get the name(s) of the input source(s) for the log data
-        inline std::vector<std::string> dataSources () const {
+        inline const std::vector<std::string>& dataSources () const {
             return itsDataSources;
         }
 
-        /// Get a copy of the internally stored data
-        inline std::set<LogEntry> data () const {
-            return itsData;
+        /// Get the number of log entries
+        inline std::size_t size () const {
+            return itsTimeEntry.size();
+        }
+
+        /// Is the log empty?
+        inline bool empty () const {
+            return itsTimeEntry.empty();
+        }
+
+        /*!
+         * \brief Get a copy of the internally stored data, ordered by time of entry
+         *
+         * \note This copies the complete data set; in order to walk through the
+         *       log entries use begin()/end() or forEach() instead.
+         */
+        std::vector<LogEntry> data () const;
+
+        /// Get the log entry at position `n`, ordered by time of entry
+        inline Record operator[] (const std::size_t& n) const {
+            return itsKeepRawData
+                ? Record(itsRawData[n].data(), itsRawData[n].size(),
+                         Clock::toDateTime(itsTimeEntry[n]),
+                         Clock::toDateTime(itsTimeExit[n]))
+                : Record("", 0,
+                         Clock::toDateTime(itsTimeEntry[n]),
+                         Clock::toDateTime(itsTimeExit[n]));
+        }
+
+        /// Get the times of entry, sorted in ascending order
+        inline const TimeArray& timesEntry () const {
+            return itsTimeEntry;
+        }
+
+        /// Get the times of exit, in the order of the times of entry
+        inline const TimeArray& timesExit () const {
+            return itsTimeExit;
+        }
+
+        /// Get the number of additional columns
+        inline std::size_t nofColumns () const {
+            return itsColumns.size();
+        }
+
+        /*!
+         * \brief Get the codes of the additional column `n`
+         * \param n -- Index of the column, counting from the first field after
+         *        the time of exit; entries lacking the field are assigned the
+         *        code of the empty string.
+         */
+        inline const CodeArray& column (const std::size_t& n) const {
+            return itsColumns[n];
+        }
+
+        /// Get the dictionary for the additional column `n`
+        inline const Dictionary& dictionary (const std::size_t& n) const {
+            return itsDictionaries[n];
+        }
+
+        /// Get the resource from which the storage is obtained
+        inline MemoryResource* resource () const {
+            return itsTimeEntry.get_allocator().resource();
+        }
+
+        /// Keep the log entries in their original format?
+        inline bool keepRawData () const {
+            return itsKeepRawData;
+        }
+
+        /*!
+         * \brief Keep the log entries in their original format?
+         * \param keepRawData -- Keep the original format for subsequently read
+         *        log entries?
+         */
+        inline void setKeepRawData (const bool& keepRawData) {
+            itsKeepRawData = keepRawData;
+        }
+
+        /// Get the time window outside of which log entries are skipped
+        inline const TimeWindow& timeWindow () const {
+            return itsTimeWindow;
+        }
+
+        /*!
+         * \brief Set the time window outside of which log entries are skipped
+         * \param window -- Time window, in ticks of the clock; applies to
+         *        subsequently read log entries.
+         */
+        inline void setTimeWindow (const TimeWindow& window) {
+            itsTimeWindow = window;
+        }
+
+        /*!
+         * \brief Set the time window outside of which log entries are skipped
+         * \param from -- Begin of the window (inclusive).
+         * \param to   -- End of the window (exclusive).
+         */
+        inline void setTimeWindow (const DateTime& from,
+                                   const DateTime& to) {
+            itsTimeWindow = TimeWindow(Clock::fromDateTime(from), Clock::fromDateTime(to));
         }
 
         /*!
@@ -75,12 +476,60 @@ namespace cgi {
         void readData (const std::string& filename,
                        const bool& overwriteData=true);
 
+        // === Iterators =======================================================
+
+        /// Get iterator to the first log entry
+        inline const_iterator begin () const {
+            return const_iterator(this, 0);
+        }
+
+        /// Get iterator past the last log entry
+        inline const_iterator end () const {
+            return const_iterator(this, size());
+        }
+
+        /*!
+         * \brief Call `visitor` for each of the log entries, in order
+         * \param visitor -- Function object, called with a `const Record&`.
+         */
+        template <typename Visitor>
+        void forEach (Visitor visitor) const {
+            for (const_iterator it=begin(); it!=end(); ++it) {
+                visitor(*it);
+            }
+        }
+
+        /*!
+         * \brief Get the log entries within positions [first,last)
+         * \param first -- Position of the first log entry.
+         * \param last  -- Position past the last log entry.
+         */
+        inline Range range (const std::size_t& first,
+                            const std::size_t& last) const {
+            return Range(const_iterator(this, first), const_iterator(this, last));
+        }
+
+        /*!
+         * \brief Split the log entries into consecutive ranges of similar size
+         * \param nofChunks -- Number of ranges to split the log into.
+         * \return Up to `nofChunks` non-empty ranges, which together cover all
+         *         log entries in order.
+         */
+        std::vector<Range> chunks (const std::size_t& nofChunks) const;
+
         // === Public methods ==================================================
 
         /// Get range of times (min,max) covered by the log entry data
-        std::pair<DateTime,DateTime> rangeOfTimes ();
+        std::pair<DateTime,DateTime> rangeOfTimes () const;
 
-        /// Get the number of visitors
+        /*!
+         * \brief Get the maximum number of visitors
+         *
+         * If the log is dense in time -- i.e. the range of times spans no more
+         * than a few ticks per log entry -- the events are bucketed per tick
+         * and summed up by cgi::PrefixScan; otherwise the events are sorted
+         * and summed up in order.
+         */
         int maxNofVisitors () const;
 
         /*!
@@ -93,7 +542,702 @@ namespace cgi {
          */
         std::multimap<DateTime,int> entranceTimepoints () const;
 
-    };  //  class LogData -- END
+        /*!
+         * \brief Get map with ordered values of entrance events
+         * \param resource -- Resource from which to obtain the nodes of the map,
+         *        e.g. a cgi::MonotonicArena owned by the caller.
+         */
+        TimepointMap entranceTimepoints (MemoryResource* resource) const;
+
+        /*!
+         * \brief Get the time-ordered list of entrance events
+         *
+         * For simultaneous events exits are placed before entries, see
+         * cgi::Event for details.
+         */
+        std::vector<Event> events () const;
+
+        /*!
+         * \brief Get the time-ordered list of entrance events
+         * \param resource -- Resource from which to obtain the storage.
+         */
+        EventArray events (MemoryResource* resource) const;
+
+        /*!
+         * \brief Get the cached time-ordered list of entrance events
+         *
+         * As opposed to events() no copy is made; the reference is invalidated
+         * by reading further data.
+         */
+        inline const EventArray& sortedEvents () const {
+            return cachedEvents();
+        }
+
+        /*!
+         * \brief Get the number of visitors for a batch of points in time
+         * \param probes -- Points in time at which to evaluate the number of
+         *        visitors; no particular ordering is required.
+         * \return Number of visitors present at each of the `probes`, returned
+         *         in the same order as the probes were provided.
+         *
+         * Instead of scanning the log once per probe, the probes are sorted once
+         * and then answered in a single merge pass along the sorted list of
+         * events. A visitor is counted as present at time \f$ t \f$ if
+         * \f$ t_{entry} \leq t < t_{exit} \f$.
+         */
+        std::vector<int> nofVisitors (const std::vector<DateTime>& probes) const;
+
+        /*!
+         * \brief Get the mergeable occupancy statistics for a time shard
+         * \param shard -- Time shard, in ticks of the `Clock`; defaults to the
+         *        data as a whole.
+         *
+         * In order to compute the exact statistics of the shard, the data need
+         * to cover all log entries overlapping with it -- as is the case when
+         * reading the data with cgi::PartialAggregate::inputWindow() set as
+         * time window (see setTimeWindow()). See cgi::PartialAggregate for how
+         * to merge the results for a set of shards.
+         */
+        PartialAggregate partialAggregate (const TimeWindow& shard=TimeWindow()) const;
+
+    };  //  class BasicLogData -- END
+
+    // =========================================================================
+    //
+    //  Operator overloading
+    //
+    // =========================================================================
+
+    /// Overloading of output stream operator
+    template <typename Record, typename Clock>
+    std::ostream& operator<< (std::ostream &os, const BasicLogData<Record,Clock> &rhs)
+    {
+        rhs.forEach([&os] (const Record& entry) {
+                os << entry << "\n";
+            });
+        os << "Number of entries = " << rhs.size() << "\n";
+
+        return os;
+    }
+
+    /*!
+     * \brief Reorder the elements of `vec` starting at position `first`
+     * \param vec     -- Vector to reorder.
+     * \param order   -- Permutation; element `n` of the result is taken from
+     *        position `order[n]` of the input.
+     * \param first   -- Position of the first element to reorder.
+     * \param scratch -- Uninitialized storage for `order.size()-first`
+     *        elements, suitably aligned; it is left uninitialized on return,
+     *        such that the same storage can be reused for the next array.
+     */
+    template <typename Array, typename Order>
+    void permute (Array& vec,
+                  const Order& order,
+                  const std::size_t& first,
+                  void* scratch)
+    {
+        typedef typename Array::value_type T;
+        T* buffer = static_cast<T*>(scratch);
+
+        for (std::size_t n=first; n<order.size(); ++n) {
+            new (buffer+n-first) T(std::move(vec[order[n]]));
+        }
+        for (std::size_t n=first; n<order.size(); ++n) {
+            vec[n] = std::move(buffer[n-first]);
+            buffer[n-first].~T();
+        }
+    }
+
+    // =========================================================================
+    //
+    //  Parameter access
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                      data
+
+    template <typename Record, typename Clock>
+    std::vector<LogEntry> BasicLogData<Record,Clock>::data () const
+    {
+        std::vector<LogEntry> result;
+        result.reserve(size());
+
+        for (std::size_t n=0; n<size(); ++n) {
+            result.push_back(LogEntry(Clock::toDateTime(itsTimeEntry[n]),
+                                      Clock::toDateTime(itsTimeExit[n]),
+                                      itsKeepRawData ? itsRawData[n] : std::string()));
+        }
+
+        return result;
+    }
+
+    // =========================================================================
+    //
+    //  Iterators
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                    chunks
+
+    template <typename Record, typename Clock>
+    std::vector<typename BasicLogData<Record,Clock>::Range>
+    BasicLogData<Record,Clock>::chunks (const std::size_t& nofChunks) const
+    {
+        std::vector<Range> result;
+
+        if (nofChunks == 0 || empty()) {
+            return result;
+        }
+
+        std::size_t n = std::min(nofChunks, size());
+        result.reserve(n);
+
+        for (std::size_t k=0; k<n; ++k) {
+            result.push_back(range(k*size()/n, (k+1)*size()/n));
+        }
+
+        return result;
+    }
+
+    // =========================================================================
+    //
+    //  Public methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                  readData
+
+    template <typename Record, typename Clock>
+    void BasicLogData<Record,Clock>::readData (const std::string& filename,
+                                               const bool& overwriteData)
+    {
+        if (overwriteData) {
+            itsDataSources.clear();
+            itsTimeEntry.clear();
+            itsTimeExit.clear();
+            itsRawData.clear();
+            itsColumns.clear();
+            itsDictionaries.clear();
+            clearCache();
+        }
+
+        // The raw data either are kept for all log entries or for none
+        if (itsKeepRawData && itsRawData.size() != itsTimeEntry.size()) {
+            throw "ERROR [LogData::readData] Raw data not available for previous entries";
+        }
+
+        // Restrict reading to the relevant region of the file, if indexed
+        std::pair<std::size_t,std::size_t> region (0, std::size_t(-1));
+        TimeIndex index;
+        if (itsTimeWindow.isBounded() && index.load(filename)) {
+            region = index.region(secondsWindow(itsTimeWindow));
+        }
+
+        LogBuffer buffer (filename, region.first, region.second-region.first);
+
+        if (buffer.isOpen()) {
+            itsDataSources.push_back(filename);
+
+            std::size_t pos     = itsTimeEntry.size();
+            std::size_t skipped = 0;
+
+            // Decode blocks of the input concurrently, append them in order
+            LogPipeline<ParsedBlock> pipeline (ThreadPool::global().nofThreads()-1);
+            pipeline.run(buffer.data(), buffer.size(),
+                         [this, &buffer] (const char* begin, const char* end, ParsedBlock& block) {
+                             parseBlock(begin, end, buffer.reference(), block);
+                         },
+                         [this, &skipped] (const ParsedBlock& block) {
+                             appendBlock(block);
+                             skipped += block.skipped;
+                         });
+            updateCache(pos);
+            sortData(pos);
+            // report number of lines read
+            std::cout << "--> Finished reading " << itsTimeEntry.size()-pos
+                      << " lines from file.";
+            if (skipped > 0) {
+                std::cout << " Skipped " << skipped << " lines outside time window.";
+            }
+            std::cout << std::endl;
+        } else {
+            std::cerr << "Error opening: " << filename << "\n";
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                              rangeOfTimes
+
+    template <typename Record, typename Clock>
+    std::pair<DateTime,DateTime> BasicLogData<Record,Clock>::rangeOfTimes () const
+    {
+        std::pair<DateTime,DateTime> result;
+
+        if (empty()) {
+            return result;
+        }
+
+        if (!itsRangeValid) {
+            // step through the log entries in order to determine maximum exit time
+            itsRange.first  = itsTimeEntry.front();
+            itsRange.second = ThreadPool::global().parallelReduce(
+                0, size(), itsTimeExit.front(),
+                [this] (std::size_t begin, std::size_t end) {
+                    return *std::max_element(itsTimeExit.begin()+begin, itsTimeExit.begin()+end);
+                },
+                [] (const tick_type& a, const tick_type& b) {
+                    return std::max(a, b);
+                }, 65536);
+            itsRangeValid   = true;
+        }
+
+        result.first  = Clock::toDateTime(itsRange.first);
+        result.second = Clock::toDateTime(itsRange.second);
+
+        return result;
+    }
+
+    //__________________________________________________________________________
+    //                                                            maxNofVisitors
+
+    template <typename Record, typename Clock>
+    int BasicLogData<Record,Clock>::maxNofVisitors () const
+    {
+        if (size() == 0) {
+            return 0;
+        }
+
+        if (!itsEventsValid) {
+            if (itsMaxNofVisitors >= 0) {
+                return itsMaxNofVisitors;
+            }
+
+            /* If the log is dense in time, bucket the events per tick and run
+               the (vectorized) prefix scan; this also avoids sorting the events. */
+            const std::size_t slotsPerEntry = 16;
+            auto rangeEntry = std::minmax_element(itsTimeEntry.begin(), itsTimeEntry.end());
+            auto rangeExit  = std::minmax_element(itsTimeExit.begin(), itsTimeExit.end());
+            tick_type first = std::min(*rangeEntry.first, *rangeExit.first);
+            tick_type last  = std::max(*rangeEntry.second, *rangeExit.second);
+
+            if (first <= last && std::uint64_t(last-first) < slotsPerEntry*size()) {
+                std::vector<std::int32_t> slots (std::size_t(last-first)+1, 0);
+                for (std::size_t n=0; n<size(); ++n) {
+                    ++slots[std::size_t(itsTimeEntry[n]-first)];
+                    --slots[std::size_t(itsTimeExit[n]-first)];
+                }
+
+                IntervalSet<std::size_t,std::int32_t> runs;
+                itsMaxNofVisitors = std::max(PrefixScan::scan(slots.data(), slots.data(), slots.size(), runs), 0);
+                return itsMaxNofVisitors;
+            }
+        }
+
+        /* Continue the sweep along the cached events from where it stopped */
+        const EventArray& list_events = cachedEvents();
+
+        for (; itsSweepPos<list_events.size(); ++itsSweepPos) {
+            itsSweepCount += list_events[itsSweepPos].delta();
+            // keep track of the maximum
+            if (itsSweepCount > itsMaxNofVisitors) {
+                itsMaxNofVisitors = itsSweepCount;
+            }
+        }
+
+        return itsMaxNofVisitors;
+    }
+
+    //__________________________________________________________________________
+    //                                                      entranceTimepoints
+
+    template <typename Record, typename Clock>
+    std::multimap<DateTime,int> BasicLogData<Record,Clock>::entranceTimepoints () const
+    {
+        std::multimap<DateTime,int> timepoints;
+        const EventArray& list_events = cachedEvents();
+
+        // events already are ordered, hence insert at the end
+        for (auto it=list_events.begin(); it!=list_events.end(); ++it) {
+            timepoints.insert (timepoints.end(),
+                               std::pair<DateTime,int>(Clock::toDateTime(it->time()), it->delta()));
+        }
+
+        return timepoints;
+    }
+
+    //__________________________________________________________________________
+    //                                                      entranceTimepoints
+
+    template <typename Record, typename Clock>
+    typename BasicLogData<Record,Clock>::TimepointMap
+    BasicLogData<Record,Clock>::entranceTimepoints (MemoryResource* resource) const
+    {
+        TimepointMap timepoints (std::less<DateTime>(), resource);
+        const EventArray& list_events = cachedEvents();
+
+        // events already are ordered, hence insert at the end
+        for (auto it=list_events.begin(); it!=list_events.end(); ++it) {
+            timepoints.insert (timepoints.end(),
+                               std::pair<DateTime,int>(Clock::toDateTime(it->time()), it->delta()));
+        }
+
+        return timepoints;
+    }
+
+    //__________________________________________________________________________
+    //                                                                    events
+
+    template <typename Record, typename Clock>
+    std::vector<Event> BasicLogData<Record,Clock>::events () const
+    {
+        const EventArray& list_events = cachedEvents();
+
+        return std::vector<Event>(list_events.begin(), list_events.end());
+    }
+
+    //__________________________________________________________________________
+    //                                                                    events
+
+    template <typename Record, typename Clock>
+    typename BasicLogData<Record,Clock>::EventArray
+    BasicLogData<Record,Clock>::events (MemoryResource* resource) const
+    {
+        const EventArray& list_events = cachedEvents();
+
+        return EventArray(list_events.begin(), list_events.end(), resource);
+    }
+
+    //__________________________________________________________________________
+    //                                                          partialAggregate
+
+    template <typename Record, typename Clock>
+    PartialAggregate BasicLogData<Record,Clock>::partialAggregate (const TimeWindow& shard) const
+    {
+        PartialAggregate result (shard);
+        const EventArray& list_events = cachedEvents();
+
+        for (auto it=list_events.begin(); it!=list_events.end(); ++it) {
+            result.add(*it);
+        }
+        result.finish();
+
+        return result;
+    }
+
+    //__________________________________________________________________________
+    //                                                               nofVisitors
+
+    template <typename Record, typename Clock>
+    std::vector<int> BasicLogData<Record,Clock>::nofVisitors (const std::vector<DateTime>& probes) const
+    {
+        std::vector<int> result (probes.size(), 0);
+
+        MonotonicArena arena (probes.size()*sizeof(std::size_t) + 1024);
+        const EventArray& list_events = cachedEvents();
+
+        // sort the probes (by index, so the original order can be restored)
+        std::vector<std::size_t, PolymorphicAllocator<std::size_t> > order (probes.size(), 0, &arena);
+        for (std::size_t n=0; n<order.size(); ++n) {
+            order[n] = n;
+        }
+        std::sort(order.begin(), order.end(),
+                  [&probes] (const std::size_t& a, const std::size_t& b) {
+                      return probes[a] < probes[b];
+                  });
+
+        // single merge pass along the events and the sorted probes
+        int visitors_current = 0;
+        auto it = list_events.begin();
+
+        for (auto n=order.begin(); n!=order.end(); ++n) {
+            tick_type time = Clock::fromDateTime(probes[*n]);
+            while (it != list_events.end() && it->time() <= time) {
+                visitors_current += it->delta();
+                ++it;
+            }
+            result[*n] = visitors_current;
+        }
+
+        return result;
+    }
+
+    // =========================================================================
+    //
+    //  Private methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                             secondsWindow
+
+    template <typename Record, typename Clock>
+    TimeWindow BasicLogData<Record,Clock>::secondsWindow (const TimeWindow& window)
+    {
+        TimeWindow result;
+
+        // Visits are selected by exit > begin and entry < end; with times
+        // truncated to seconds the bounds need to be widened accordingly.
+        if (window.hasBegin()) {
+            std::int64_t begin = window.begin() / Clock::ticksPerSecond;
+            if (window.begin() % Clock::ticksPerSecond < 0) {
+                --begin;
+            }
+            result.setBegin(begin-1);
+        }
+        if (window.hasEnd()) {
+            std::int64_t end = (window.end()-1) / Clock::ticksPerSecond;
+            if ((window.end()-1) % Clock::ticksPerSecond < 0) {
+                --end;
+            }
+            result.setEnd(end+1);
+        }
+
+        return result;
+    }
+
+    //__________________________________________________________________________
+    //                                                                parseBlock
+
+    template <typename Record, typename Clock>
+    void BasicLogData<Record,Clock>::parseBlock (const char* begin,
+                                                 const char* end,
+                                                 const std::time_t& reference,
+                                                 ParsedBlock& block) const
+    {
+        LogBuffer::const_iterator last (end, end, reference);
+
+        for (LogBuffer::const_iterator it (begin, end, reference); it!=last; ++it) {
+            ParsedEntry entry;
+            std::size_t size = it.lineSize();
+            entry.line       = it.line();
+
+            if (!LogDecoder::times<Clock>(entry.line, size, reference, itsTimeWindow,
+                                          entry.timeEntry, entry.timeExit, entry.fields)) {
+                ++block.skipped;
+                continue;
+            }
+            entry.end = entry.line + size;
+
+            block.entries.push_back(entry);
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                               appendBlock
+
+    template <typename Record, typename Clock>
+    void BasicLogData<Record,Clock>::appendBlock (const ParsedBlock& block)
+    {
+        for (auto it=block.entries.begin(); it!=block.entries.end(); ++it) {
+            itsTimeEntry.push_back(it->timeEntry);
+            itsTimeExit.push_back(it->timeExit);
+            if (itsKeepRawData) {
+                itsRawData.push_back(std::string(it->line, it->end));
+            }
+            // Dictionary codes depend on the order, hence are assigned here
+            if (it->fields < it->end || !itsColumns.empty()) {
+                readColumns(it->fields, it->end);
+            }
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                               readColumns
+
+    template <typename Record, typename Clock>
+    void BasicLogData<Record,Clock>::readColumns (const char* begin,
+                                                  const char* end)
+    {
+        // Position of the current log entry
+        std::size_t row = itsTimeEntry.size()-1;
+        std::size_t n   = 0;
+
+        // `begin` points at the separator in front of each field
+        for (; begin < end; ++n) {
+            const char* field = begin+1;
+            begin = LogEntryView::fieldEnd(field, end);
+
+            if (n == itsColumns.size()) {
+                // New column: entries read so far lack the field
+                itsDictionaries.push_back(Dictionary());
+                itsColumns.push_back(CodeArray(resource()));
+                if (row > 0) {
+                    itsColumns.back().assign(row, itsDictionaries.back().encode(""));
+                }
+            }
+            itsColumns[n].push_back(itsDictionaries[n].encode(field, begin));
+        }
+
+        // Fields missing from this log entry
+        for (; n < itsColumns.size(); ++n) {
+            itsColumns[n].push_back(itsDictionaries[n].encode(""));
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                                  sortData
+
+    template <typename Record, typename Clock>
+    void BasicLogData<Record,Clock>::sortData (const std::size_t& pos)
+    {
+        auto byTimeEntry = [this] (const std::size_t& a, const std::size_t& b) {
+            return itsTimeEntry[a] < itsTimeEntry[b];
+        };
+
+        // One scratch buffer, fitting the largest element type, is shared by
+        // all the arrays to reorder
+        std::size_t elementSize = sizeof(tick_type);
+        if (itsKeepRawData) {
+            elementSize = std::max(elementSize, sizeof(std::string));
+        }
+        if (!itsColumns.empty()) {
+            elementSize = std::max(elementSize, sizeof(Dictionary::code_type));
+        }
+
+        MonotonicArena arena (size()*(sizeof(std::size_t)+elementSize) + 1024);
+
+        // Sort the newly added log entries by time of entry, via permutation
+        std::vector<std::size_t, PolymorphicAllocator<std::size_t> > order (size(), 0, &arena);
+        for (std::size_t n=0; n<order.size(); ++n) {
+            order[n] = n;
+        }
+        ThreadPool::global().parallelSort(order.begin()+pos, order.end(), byTimeEntry);
+
+        // Merge with the data already stored, unless all new entries are later
+        std::size_t first = pos;
+        if (pos > 0 && pos < order.size()
+            && itsTimeEntry[order[pos]] < itsTimeEntry[pos-1]) {
+            std::inplace_merge(order.begin(), order.begin()+pos, order.end(), byTimeEntry);
+            first = 0;
+        }
+
+        void* scratch = arena.allocate((order.size()-first)*elementSize);
+        permute(itsTimeEntry, order, first, scratch);
+        permute(itsTimeExit, order, first, scratch);
+        if (itsKeepRawData) {
+            permute(itsRawData, order, first, scratch);
+        }
+        for (auto it=itsColumns.begin(); it!=itsColumns.end(); ++it) {
+            permute(*it, order, first, scratch);
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                              cachedEvents
+
+    template <typename Record, typename Clock>
+    const typename BasicLogData<Record,Clock>::EventArray&
+    BasicLogData<Record,Clock>::cachedEvents () const
+    {
+        if (!itsEventsValid) {
+            MonotonicArena arena (size()*sizeof(tick_type) + 1024);
+            fillEvents(itsEvents, &arena);
+            itsEventsValid = true;
+            // restart the sweep along the events
+            itsSweepPos       = 0;
+            itsSweepCount     = 0;
+            itsMaxNofVisitors = 0;
+        }
+
+        return itsEvents;
+    }
+
+    //__________________________________________________________________________
+    //                                                                clearCache
+
+    template <typename Record, typename Clock>
+    void BasicLogData<Record,Clock>::clearCache ()
+    {
+        itsEvents.clear();
+        itsEventsValid    = false;
+        itsRangeValid     = false;
+        itsSweepPos       = 0;
+        itsSweepCount     = 0;
+        itsMaxNofVisitors = -1;
+    }
+
+    //__________________________________________________________________________
+    //                                                               updateCache
+
+    template <typename Record, typename Clock>
+    void BasicLogData<Record,Clock>::updateCache (const std::size_t& pos)
+    {
+        if (pos == size()) {
+            return;
+        }
+
+        // Range of times: extend by the new entries
+        if (itsRangeValid) {
+            itsRange.first  = std::min(itsRange.first,
+                                       *std::min_element(itsTimeEntry.begin()+pos, itsTimeEntry.end()));
+            itsRange.second = std::max(itsRange.second,
+                                       *std::max_element(itsTimeExit.begin()+pos, itsTimeExit.end()));
+        }
+
+        if (!itsEventsValid) {
+            itsMaxNofVisitors = -1;
+            return;
+        }
+
+        // Events: sort the new ones and merge them into the existing ones
+        std::size_t nofEvents = itsEvents.size();
+        for (std::size_t n=pos; n<size(); ++n) {
+            itsEvents.push_back(Event(itsTimeEntry[n], true));
+            itsEvents.push_back(Event(itsTimeExit[n], false));
+        }
+        ThreadPool::global().parallelSort(itsEvents.begin()+nofEvents, itsEvents.end());
+
+        // Unless all new events are later, the sweep needs to start over
+        if (nofEvents > 0 && itsEvents[nofEvents] < itsEvents[nofEvents-1]) {
+            std::inplace_merge(itsEvents.begin(), itsEvents.begin()+nofEvents, itsEvents.end());
+            itsSweepPos       = 0;
+            itsSweepCount     = 0;
+            itsMaxNofVisitors = 0;
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                                fillEvents
+
+    template <typename Record, typename Clock>
+    template <typename Array>
+    void BasicLogData<Record,Clock>::fillEvents (Array& result,
+                                                 MemoryResource* resource) const
+    {
+        // Times of entry already are sorted, so only the exits need sorting
+        TimeArray timesExit (itsTimeExit.begin(), itsTimeExit.end(), resource);
+        ThreadPool::global().parallelSort(timesExit.begin(), timesExit.end());
+
+        result.clear();
+        result.reserve(2*size());
+
+        auto itEntry = itsTimeEntry.begin();
+        auto itExit  = timesExit.begin();
+
+        // merge, placing exits before entries for simultaneous events
+        while (itEntry != itsTimeEntry.end() && itExit != timesExit.end()) {
+            if (*itExit <= *itEntry) {
+                result.push_back(Event(*itExit++, false));
+            } else {
+                result.push_back(Event(*itEntry++, true));
+            }
+        }
+        for (; itExit != timesExit.end(); ++itExit) {
+            result.push_back(Event(*itExit, false));
+        }
+        for (; itEntry != itsTimeEntry.end(); ++itEntry) {
+            result.push_back(Event(*itEntry, true));
+        }
+    }
+
+    /// Container to the storage of log data, in the default layout
+    typedef BasicLogData<LogEntryView, SecondsClock> LogData;
+
+    // The default layout is instantiated once, within the library
+    extern template class BasicLogData<LogEntryView, SecondsClock>;
 
 }  //  namespace cgi -- END
 
@@ -0,0 +1,90 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_LOGDECODER_H
+#define CGI_LOGDECODER_H
+
+/*!
+ * \file LogDecoder.h
+ * \brief Decoding of the times of entry and exit of a single log entry
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+#include "Clock.h"
+#include "LogEntryView.h"
+#include "TimeWindow.h"
+
+namespace cgi {
+
+    /*!
+     * \struct LogDecoder
+     * \brief Decoding of the times of entry and exit of a single log entry
+     * \test test_LogGenerator.cc
+     *
+     * Shared by all readers of log files -- cgi::BasicLogData,
+     * cgi::ExternalSort and cgi::LogGenerator -- such that a log entry is
+     * split, decoded and checked against the time window in one place.
+     */
+    struct LogDecoder {
+
+        /*!
+         * \brief Decode the times of a log entry, checking them against a window
+         * \param line      -- Pointer to the first character of the log entry.
+         * \param size      -- Number of characters of the log entry; a trailing
+         *        carriage return is stripped off.
+         * \param reference -- Start of the day, see LogEntryView::startOfDay().
+         * \param window    -- Time window (in ticks of `Clock`), with which the
+         *        visit is required to overlap.
+         * \param timeEntry -- Time of entry.
+         * \param timeExit  -- Time of exit; only decoded if the time of entry
+         *        is admitted by the window.
+         * \param fields    -- Pointer to the separator in front of any
+         *        additional fields, or past the last character if there are none.
+         * \return Does the visit overlap with the time window?
+         */
+        template <typename Clock>
+        static inline bool times (const char* line,
+                                  std::size_t& size,
+                                  const std::time_t& reference,
+                                  const TimeWindow& window,
+                                  typename Clock::tick_type& timeEntry,
+                                  typename Clock::tick_type& timeExit,
+                                  const char*& fields) {
+            const char* sep = LogEntryView::splitFields(line, size);
+            const char* end = line + size;
+
+            // Check against the time window, decoding as little as possible
+            timeEntry = Clock::parse(line, sep, reference);
+            if (!window.admitsEntry(timeEntry)) {
+                return false;
+            }
+
+            // Further fields -- if any -- do not belong to the time of exit
+            const char* exit = sep < end ? sep+1 : end;
+            fields   = LogEntryView::fieldEnd(exit, end);
+            timeExit = Clock::parse(exit, fields, reference);
+
+            return window.admitsExit(timeExit);
+        }
+
+        /// Decode the times (in seconds) of a log entry, see above
+        static inline bool times (const char* line,
+                                  std::size_t& size,
+                                  const std::time_t& reference,
+                                  const TimeWindow& window,
+                                  std::int64_t& timeEntry,
+                                  std::int64_t& timeExit) {
+            const char* fields = NULL;
+            return times<SecondsClock>(line, size, reference, window, timeEntry, timeExit, fields);
+        }
+
+    };  //  struct LogDecoder -- END
+
+}  //  namespace cgi -- END
+
+#endif
@@ -47,6 +47,19 @@ namespace cgi {
             setData(data);
         }
 
+        /*!
+         * \brief Argumented constructor
+         * \param timeEntry -- Time of entry
+         * \param timeExit  -- Time of exit
+         * \param data      -- Data of the log file entry in its original format,
+         *        if available.
+         */
+        LogEntry (const DateTime& timeEntry,
+                  const DateTime& timeExit,
+                  const std::string& data="") : itsData(data),
+                                                itsTimeEntry(timeEntry),
+                                                itsTimeExit(timeExit) {}
+
         // === Operator overloading ============================================
 
         /*!
@@ -82,7 +95,7 @@ namespace cgi {
         // === Parameter access ================================================
 
         /// Get data of the logfile entry
-        inline std::string data () const {
+        inline const std::string& data () const {
             return itsData;
         }
 
@@ -96,12 +109,12 @@ namespace cgi {
                       const std::string& format="%H:%M");
 
         /// Get the time of entry
-        inline DateTime timeEntry () const {
+        inline const DateTime& timeEntry () const {
             return itsTimeEntry;
         }
 
         /// Get the time of exit
-        inline DateTime timeExit () const {
+        inline const DateTime& timeExit () const {
             return itsTimeExit;
         }
 
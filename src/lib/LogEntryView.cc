@@ -0,0 +1,175 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <cstring>
+#include <ctime>
+
+#include "Iso8601.h"
+#include "LogEntryView.h"
+
+namespace cgi {
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    LogEntryView::LogEntryView (const char* data,
+                                const std::size_t& size,
+                                const std::time_t& reference)
+        : itsData(data),
+          itsSize(size)
+    {
+        const char* sep = splitFields(itsData, itsSize);
+        const char* end = itsData + itsSize;
+
+        itsTimeEntry = DateTime(parseTime(itsData, sep, reference));
+        // Further fields -- if any -- do not belong to the time of exit
+        const char* exit = sep < end ? sep+1 : end;
+        itsTimeExit  = DateTime(parseTime(exit, fieldEnd(exit, end), reference));
+    }
+
+    // =========================================================================
+    //
+    //  Operator overloading
+    //
+    // =========================================================================
+
+    std::ostream& operator<< (std::ostream& os, const LogEntryView& rhs)
+    {
+        std::string format = "%Y-%m-%dT%H:%M:%SZ";
+        os.write(rhs.itsData, rhs.itsSize);
+        os << " -> " << rhs.itsTimeEntry.asString(format)
+           << " - "  << rhs.itsTimeExit.asString(format);
+
+        return os;
+    }
+
+    // =========================================================================
+    //
+    //  Public static methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                startOfDay
+
+    std::time_t LogEntryView::startOfDay ()
+    {
+        return DateTime("00:00", "%H:%M").rawtime();
+    }
+
+    //__________________________________________________________________________
+    //                                                                 parseTime
+
+    std::time_t LogEntryView::parseTime (const char* begin,
+                                         const char* end,
+                                         const std::time_t& reference)
+    {
+        std::size_t length = end - begin;
+        int fields[3]      = {0, 0, 0};
+        bool valid         = (length == 5 || length == 8);
+
+        // Fast path: HH:MM or HH:MM:SS
+        for (std::size_t n=0; valid && n<length; ++n) {
+            if (n%3 == 2) {
+                valid = (begin[n] == ':');
+            } else if (begin[n] >= '0' && begin[n] <= '9') {
+                fields[n/3] = 10*fields[n/3] + (begin[n]-'0');
+            } else {
+                valid = false;
+            }
+        }
+
+        if (valid) {
+            return timeOfDay(reference, fields[0], fields[1], fields[2]);
+        }
+
+        // Full timestamp: YYYY-MM-DDThh:mm:ss[.f][Z]
+        std::int64_t seconds     = 0;
+        std::int64_t nanoseconds = 0;
+        if (Iso8601::isDate(begin, end) && Iso8601::parse(begin, end, seconds, nanoseconds)) {
+            return std::time_t(seconds);
+        }
+
+        // Fall back to parsing via the C library
+        return DateTime(std::string(begin, end), "%H:%M").rawtime();
+    }
+
+    //__________________________________________________________________________
+    //                                                                    isTime
+
+    bool LogEntryView::isTime (const char* begin,
+                               const char* end)
+    {
+        if (Iso8601::isDate(begin, end)) {
+            std::int64_t seconds;
+            std::int64_t nanoseconds;
+            return Iso8601::parse(begin, end, seconds, nanoseconds);
+        }
+
+        std::string text (begin, end);
+        const char* last = text.c_str() + text.size();
+        struct tm tm;
+
+        return strptime(text.c_str(), "%H:%M:%S", &tm) == last
+            || strptime(text.c_str(), "%H:%M", &tm) == last;
+    }
+
+    //__________________________________________________________________________
+    //                                                                 timeOfDay
+
+    std::time_t LogEntryView::timeOfDay (const std::time_t& reference,
+                                         const int& hour,
+                                         const int& minute,
+                                         const int& second)
+    {
+        // Does the offset to UTC change during the day? Checked once per day.
+        static thread_local bool cachedValid            = false;
+        static thread_local std::time_t cachedReference = 0;
+        static thread_local bool cachedShift            = false;
+        if (!cachedValid || reference != cachedReference) {
+            std::time_t dayEnd = reference + 24*3600;
+            struct tm tmBegin;
+            struct tm tmEnd;
+            localtime_r(&reference, &tmBegin);
+            localtime_r(&dayEnd, &tmEnd);
+            cachedShift     = tmBegin.tm_gmtoff != tmEnd.tm_gmtoff;
+            cachedReference = reference;
+            cachedValid     = true;
+        }
+
+        if (!cachedShift) {
+            return reference + 3600*hour + 60*minute + second;
+        }
+
+        // Same rule as cgi::DateTime: wall-clock time on the day of the reference
+        struct tm tm;
+        localtime_r(&reference, &tm);
+        tm.tm_hour  = hour;
+        tm.tm_min   = minute;
+        tm.tm_sec   = second;
+        tm.tm_isdst = -1;
+
+        return std::mktime(&tm);
+    }
+
+    //__________________________________________________________________________
+    //                                                               splitFields
+
+    const char* LogEntryView::splitFields (const char* data,
+                                           std::size_t& size)
+    {
+        if (size > 0 && data[size-1] == '\r') {
+            --size;
+        }
+
+        const char* sep = static_cast<const char*>(std::memchr(data, ',', size));
+
+        return (sep == NULL) ? data+size : sep;
+    }
+
+}  //  namespace cgi -- END
@@ -0,0 +1,180 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_LOGENTRYVIEW_H
+#define CGI_LOGENTRYVIEW_H
+
+/*!
+ * \file LogEntryView.h
+ * \brief Class for a non-owning view onto a single log file entry.
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "DateTime.h"
+
+namespace cgi {
+
+    /*!
+     * \class LogEntryView
+     * \brief Non-owning view onto the data of a single log file entry.
+     * \test test_LogEntryView.cc
+     *
+     * As opposed to cgi::LogEntry no copy of the log entry is made: the view
+     * refers to the bytes of the original line, as held by an input buffer
+     * (see cgi::LogBuffer), which therefore is required to outlive the view.
+     * Times given as ``HH:MM`` or ``HH:MM:SS`` -- or as full ISO 8601
+     * timestamps, see cgi::Iso8601 -- are decoded directly from the characters,
+     * without creating any intermediate strings; other formats are passed on to
+     * cgi::DateTime.
+     */
+    class LogEntryView {
+
+        /// Pointer to the first character of the log entry
+        const char* itsData;
+        /// Number of characters of the log entry (excluding line terminators)
+        std::size_t itsSize;
+        /// Time of entry
+        DateTime itsTimeEntry;
+        /// Time of exit
+        DateTime itsTimeExit;
+
+    public:
+
+        // === Construction ====================================================
+
+        /// Default constructor, referring to no log entry
+        LogEntryView () : itsData(NULL),
+                          itsSize(0) {}
+
+        /*!
+         * \brief Argumented constructor
+         * \param data      -- Pointer to the first character of the log entry.
+         * \param size      -- Number of characters of the log entry.
+         * \param reference -- Start of the day to which times of day (``HH:MM``)
+         *        are referring; see startOfDay().
+         */
+        LogEntryView (const char* data,
+                      const std::size_t& size,
+                      const std::time_t& reference=startOfDay());
+
+        /*!
+         * \brief Argumented constructor, for already decoded times
+         * \param data      -- Pointer to the first character of the log entry.
+         * \param size      -- Number of characters of the log entry.
+         * \param timeEntry -- Time of entry
+         * \param timeExit  -- Time of exit
+         */
+        LogEntryView (const char* data,
+                      const std::size_t& size,
+                      const DateTime& timeEntry,
+                      const DateTime& timeExit) : itsData(data),
+                                                  itsSize(size),
+                                                  itsTimeEntry(timeEntry),
+                                                  itsTimeExit(timeExit) {}
+
+        // === Operator overloading ============================================
+
+        /// Overloading of output stream operator
+        friend std::ostream& operator<< (std::ostream& os, const LogEntryView& rhs);
+
+        // === Parameter access ================================================
+
+        /// Get pointer to the data of the logfile entry
+        inline const char* data () const {
+            return itsData;
+        }
+
+        /// Get the number of characters of the logfile entry
+        inline std::size_t size () const {
+            return itsSize;
+        }
+
+        /// Get a copy of the data of the logfile entry
+        inline std::string str () const {
+            return std::string(itsData, itsSize);
+        }
+
+        /// Get the time of entry
+        inline const DateTime& timeEntry () const {
+            return itsTimeEntry;
+        }
+
+        /// Get the time of exit
+        inline const DateTime& timeExit () const {
+            return itsTimeExit;
+        }
+
+        // === Public static methods ===========================================
+
+        /// Get the start of the current day, as used for times of day
+        static std::time_t startOfDay ();
+
+        /*!
+         * \brief Parse the characters in [begin,end) as time
+         * \param begin     -- Pointer to the first character.
+         * \param end       -- Pointer past the last character.
+         * \param reference -- Start of the day, see startOfDay().
+         */
+        static std::time_t parseTime (const char* begin,
+                                      const char* end,
+                                      const std::time_t& reference);
+
+        /*!
+         * \brief Can the characters in [begin,end) be parsed as time?
+         *
+         * Accepted are times of day (``HH:MM`` or ``HH:MM:SS``) and ISO 8601
+         * timestamps; for anything else parseTime() yields an arbitrary time.
+         */
+        static bool isTime (const char* begin,
+                            const char* end);
+
+        /*!
+         * \brief Get the point in time for a time of day
+         * \param reference -- Start of the day, see startOfDay().
+         * \param hour      -- Hour of the day.
+         * \param minute    -- Minute of the hour.
+         * \param second    -- Second of the minute.
+         *
+         * Times of day are local wall-clock times, as for cgi::DateTime: on a
+         * day on which the offset to UTC changes (e.g. daylight saving time)
+         * the point in time is obtained through ``mktime``, otherwise it simply
+         * is offset from the reference.
+         */
+        static std::time_t timeOfDay (const std::time_t& reference,
+                                      const int& hour,
+                                      const int& minute,
+                                      const int& second=0);
+
+        /*!
+         * \brief Locate the separator between the time fields of a log entry
+         * \param data -- Pointer to the first character of the log entry.
+         * \param size -- Number of characters of the log entry; a trailing
+         *        carriage return is stripped off.
+         * \return Pointer to the separator, or past the last character if there
+         *         is none.
+         */
+        static const char* splitFields (const char* data,
+                                        std::size_t& size);
+
+        /*!
+         * \brief Locate the end of the field starting at `begin`
+         * \param begin -- Pointer to the first character of the field.
+         * \param end   -- Pointer past the last character of the log entry.
+         * \return Pointer to the next separator, or `end` if there is none.
+         */
+        static inline const char* fieldEnd (const char* begin,
+                                            const char* end) {
+            const char* sep = static_cast<const char*>(std::memchr(begin, ',', end-begin));
+            return (sep == NULL) ? end : sep;
+        }
+
+    };  //  class LogEntryView -- END
+
+}  //  namespace cgi -- END
+
+#endif
@@ -0,0 +1,416 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_LOGGENERATOR_H
+#define CGI_LOGGENERATOR_H
+
+/*!
+ * \file LogGenerator.h
+ * \brief Classes for lazily decoding the entries and events of a log file
+ */
+
+#include <cstddef>
+#include <ctime>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "Event.h"
+#include "LogBuffer.h"
+#include "LogDecoder.h"
+#include "LogEntryView.h"
+#include "TimeWindow.h"
+
+namespace cgi {
+
+    /*!
+     * \struct EntryDecoder
+     * \brief Decoding of a log entry into a cgi::LogEntryView
+     */
+    struct EntryDecoder : public LogDecoder {
+
+        /// Type of the values decoded from a log entry
+        typedef LogEntryView value_type;
+
+        /// Maximum number of values decoded from a log entry
+        static const std::size_t maxValues = 1;
+
+        /// Decode a log entry, returning the number of values stored in `values`
+        static inline std::size_t decode (const char* line,
+                                          std::size_t size,
+                                          const std::time_t& reference,
+                                          const TimeWindow& window,
+                                          value_type* values) {
+            std::int64_t timeEntry = 0;
+            std::int64_t timeExit  = 0;
+            if (!times(line, size, reference, window, timeEntry, timeExit)) {
+                return 0;
+            }
+            values[0] = LogEntryView(line, size,
+                                     DateTime(std::time_t(timeEntry)),
+                                     DateTime(std::time_t(timeExit)));
+            return 1;
+        }
+
+    };  //  struct EntryDecoder -- END
+
+    /*!
+     * \struct EventDecoder
+     * \brief Decoding of a log entry into its entry and exit cgi::Event
+     */
+    struct EventDecoder : public LogDecoder {
+
+        /// Type of the values decoded from a log entry
+        typedef Event value_type;
+
+        /// Maximum number of values decoded from a log entry
+        static const std::size_t maxValues = 2;
+
+        /// Decode a log entry, returning the number of values stored in `values`
+        static inline std::size_t decode (const char* line,
+                                          std::size_t size,
+                                          const std::time_t& reference,
+                                          const TimeWindow& window,
+                                          value_type* values) {
+            std::int64_t timeEntry = 0;
+            std::int64_t timeExit  = 0;
+            if (!times(line, size, reference, window, timeEntry, timeExit)) {
+                return 0;
+            }
+            values[0] = Event(timeEntry, true);
+            values[1] = Event(timeExit, false);
+            return 2;
+        }
+
+    };  //  struct EventDecoder -- END
+
+    /*!
+     * \class LogGenerator
+     * \brief Range lazily decoding the log entries of a file, one at a time
+     * \test test_LogGenerator.cc
+     *
+     * As opposed to cgi::LogData nothing is kept beyond the current log entry:
+     * the file is mapped into memory (see cgi::LogBuffer) and each step of the
+     * iterator decodes the next line through the `Decoder` -- cgi::EntryDecoder
+     * for the log entries themselves, cgi::EventDecoder for the events of entry
+     * and exit. Hence walking through a log -- optionally restricted to a time
+     * window, and combined with filter() -- runs in constant memory:
+     *
+     * \code
+     * std::size_t n = 0;
+     * for (const cgi::Event& event : cgi::events("visitors.txt")) {
+     *     n += event.isEntry();
+     * }
+     * \endcode
+     *
+     * Events are produced in the order of the log entries, i.e. they are not
+     * sorted by time (see cgi::ExternalSort for that).
+     *
+     * The mapping is shared between copies of a generator and its iterators,
+     * which refer to it, hence the generator is required to outlive them.
+     */
+    template <typename Decoder>
+    class LogGenerator {
+
+    public:
+
+        /// Type of the values produced
+        typedef typename Decoder::value_type value_type;
+
+        /*!
+         * \class iterator
+         * \brief Input iterator over the values decoded from the log entries
+         */
+        class iterator {
+
+            /// Next log entry to decode
+            LogBuffer::const_iterator itsLine;
+            /// End of the log entries
+            LogBuffer::const_iterator itsEnd;
+            /// Start of the day, to which times of day are referring
+            std::time_t itsReference;
+            /// Time window, with which the visits are required to overlap
+            TimeWindow itsWindow;
+            /// Values decoded from the current log entry
+            typename Decoder::value_type itsValues[Decoder::maxValues];
+            /// Position within the values of the current log entry
+            std::size_t itsIndex;
+            /// Number of values of the current log entry
+            std::size_t itsCount;
+
+            /// Decode the next log entry within the time window, if any
+            void decode () {
+                itsIndex = 0;
+                itsCount = 0;
+                while (itsLine != itsEnd && itsCount == 0) {
+                    itsCount = Decoder::decode(itsLine.line(), itsLine.lineSize(),
+                                               itsReference, itsWindow, itsValues);
+                    ++itsLine;
+                }
+            }
+
+        public:
+
+            typedef std::input_iterator_tag iterator_category;
+            typedef typename Decoder::value_type value_type;
+            typedef std::ptrdiff_t            difference_type;
+            typedef const value_type*         pointer;
+            typedef const value_type&         reference;
+
+            /// Argumented constructor
+            iterator (const LogBuffer::const_iterator& begin,
+                      const LogBuffer::const_iterator& end,
+                      const std::time_t& reference,
+                      const TimeWindow& window) : itsLine(begin),
+                                                  itsEnd(end),
+                                                  itsReference(reference),
+                                                  itsWindow(window) {
+                decode();
+            }
+
+            /// Get the value at the current position
+            inline const value_type& operator* () const {
+                return itsValues[itsIndex];
+            }
+
+            /// Get pointer to the value at the current position
+            inline const value_type* operator-> () const {
+                return &itsValues[itsIndex];
+            }
+
+            /// Advance to the next value
+            inline iterator& operator++ () {
+                if (++itsIndex == itsCount) {
+                    decode();
+                }
+                return *this;
+            }
+
+            /// Comparison operator
+            bool operator== (const iterator& rhs) const {
+                return itsLine == rhs.itsLine
+                    && itsIndex == rhs.itsIndex
+                    && itsCount == rhs.itsCount;
+            }
+
+            /// Comparison operator
+            bool operator!= (const iterator& rhs) const {
+                return !operator==(rhs);
+            }
+
+        };  //  class iterator -- END
+
+        /// Iterators only provide read access to the values
+        typedef iterator const_iterator;
+
+    private:
+
+        /// Buffer holding the contents of the log file
+        std::shared_ptr<const LogBuffer> itsBuffer;
+        /// Time window, with which the visits are required to overlap
+        TimeWindow itsWindow;
+
+    public:
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param filename -- Name of the input file.
+         * \param window   -- Time window, to which to restrict the log entries.
+         */
+        LogGenerator (const std::string& filename,
+                      const TimeWindow& window=TimeWindow())
+            : itsBuffer(std::make_shared<LogBuffer>(filename)),
+              itsWindow(window)
+        {
+            if (!itsBuffer->isOpen()) {
+                std::cerr << "Error opening: " << filename << "\n";
+            }
+        }
+
+        // === Parameter access ================================================
+
+        /// Has the input file been opened successfully?
+        inline bool isOpen () const {
+            return itsBuffer->isOpen();
+        }
+
+        /// Get the time window, to which the log entries are restricted
+        inline const TimeWindow& timeWindow () const {
+            return itsWindow;
+        }
+
+        // === Iterators =======================================================
+
+        /// Get iterator to the first value
+        inline iterator begin () const {
+            return iterator(itsBuffer->begin(), itsBuffer->end(),
+                            itsBuffer->reference(), itsWindow);
+        }
+
+        /// Get iterator past the last value
+        inline iterator end () const {
+            return iterator(itsBuffer->end(), itsBuffer->end(),
+                            itsBuffer->reference(), itsWindow);
+        }
+
+    };  //  class LogGenerator -- END
+
+    /// Range over the log entries of a file
+    typedef LogGenerator<EntryDecoder> EntryGenerator;
+
+    /// Range over the events of entry and exit of a file, in the order of the log
+    typedef LogGenerator<EventDecoder> EventGenerator;
+
+    /*!
+     * \brief Lazily decode the log entries of a file
+     * \param filename -- Name of the input file.
+     * \param window   -- Time window, to which to restrict the log entries.
+     */
+    inline EntryGenerator entries (const std::string& filename,
+                                   const TimeWindow& window=TimeWindow())
+    {
+        return EntryGenerator(filename, window);
+    }
+
+    /*!
+     * \brief Lazily decode the events of entry and exit of a file
+     * \param filename -- Name of the input file.
+     * \param window   -- Time window, to which to restrict the log entries.
+     */
+    inline EventGenerator events (const std::string& filename,
+                                  const TimeWindow& window=TimeWindow())
+    {
+        return EventGenerator(filename, window);
+    }
+
+    /*!
+     * \class FilterRange
+     * \brief Range lazily skipping the values of another range
+     * \test test_LogGenerator.cc
+     *
+     * Only the values for which the predicate returns `true` are passed on;
+     * ranges can be nested, such that filters compose into a lazy pipeline.
+     */
+    template <typename Range, typename Predicate>
+    class FilterRange {
+
+        /// Underlying range
+        Range itsRange;
+        /// Predicate selecting the values to pass on
+        Predicate itsPredicate;
+
+    public:
+
+        /// Type of the values produced
+        typedef typename Range::value_type value_type;
+
+        /*!
+         * \class iterator
+         * \brief Input iterator over the selected values
+         */
+        class iterator {
+
+            /// Position within the underlying range
+            typename Range::const_iterator itsPosition;
+            /// End of the underlying range
+            typename Range::const_iterator itsEnd;
+            /// Predicate selecting the values to pass on
+            const Predicate* itsPredicate;
+
+            /// Skip values not selected by the predicate
+            void skip () {
+                while (itsPosition != itsEnd && !(*itsPredicate)(*itsPosition)) {
+                    ++itsPosition;
+                }
+            }
+
+        public:
+
+            typedef std::input_iterator_tag iterator_category;
+            typedef typename Range::value_type value_type;
+            typedef std::ptrdiff_t            difference_type;
+            typedef const value_type*         pointer;
+            typedef const value_type&         reference;
+
+            /// Argumented constructor
+            iterator (const typename Range::const_iterator& position,
+                      const typename Range::const_iterator& end,
+                      const Predicate* predicate) : itsPosition(position),
+                                                    itsEnd(end),
+                                                    itsPredicate(predicate) {
+                skip();
+            }
+
+            /// Get the value at the current position
+            inline const value_type& operator* () const {
+                return *itsPosition;
+            }
+
+            /// Get pointer to the value at the current position
+            inline const value_type* operator-> () const {
+                return &(*itsPosition);
+            }
+
+            /// Advance to the next selected value
+            inline iterator& operator++ () {
+                ++itsPosition;
+                skip();
+                return *this;
+            }
+
+            /// Comparison operator
+            bool operator== (const iterator& rhs) const {
+                return itsPosition == rhs.itsPosition;
+            }
+
+            /// Comparison operator
+            bool operator!= (const iterator& rhs) const {
+                return itsPosition != rhs.itsPosition;
+            }
+
+        };  //  class iterator -- END
+
+        /// Iterators only provide read access to the values
+        typedef iterator const_iterator;
+
+        // === Construction ====================================================
+
+        /// Argumented constructor
+        FilterRange (const Range& range,
+                     const Predicate& predicate) : itsRange(range),
+                                                   itsPredicate(predicate) {}
+
+        // === Iterators =======================================================
+
+        /// Get iterator to the first selected value
+        inline iterator begin () const {
+            return iterator(itsRange.begin(), itsRange.end(), &itsPredicate);
+        }
+
+        /// Get iterator past the last selected value
+        inline iterator end () const {
+            return iterator(itsRange.end(), itsRange.end(), &itsPredicate);
+        }
+
+    };  //  class FilterRange -- END
+
+    /*!
+     * \brief Lazily select the values of a range
+     * \param range     -- Range to select from, e.g. as returned by entries().
+     * \param predicate -- Predicate selecting the values to pass on.
+     */
+    template <typename Range, typename Predicate>
+    inline FilterRange<Range,Predicate> filter (const Range& range,
+                                                const Predicate& predicate)
+    {
+        return FilterRange<Range,Predicate>(range, predicate);
+    }
+
+}  //  namespace cgi -- END
+
+#endif
@@ -0,0 +1,256 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_LOGPIPELINE_H
+#define CGI_LOGPIPELINE_H
+
+/*!
+ * \file LogPipeline.h
+ * \brief Class for processing an input buffer in overlapping pipeline stages
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "RingBuffer.h"
+
+namespace cgi {
+
+    /*!
+     * \class LogPipeline
+     * \brief Process an input buffer in overlapping reader/parser/aggregator stages
+     * \test test_LogPipeline.cc
+     *
+     * The input -- e.g. the contents of a cgi::LogBuffer -- is cut into blocks
+     * of about blockSize() bytes, each ending at a line break, and passed
+     * through three stages running concurrently:
+     *
+     * \li a reader thread, cutting the blocks and touching their pages ahead of
+     *     the parsers, such that the data are faulted in from disk while the
+     *     previous blocks are being parsed;
+     * \li nofParsers() parser threads, each turning a block into a `Batch`;
+     * \li the calling thread, consuming the batches in the order of the input.
+     *
+     * The stages are connected by bounded cgi::RingBuffer queues: each parser
+     * has one for its blocks and one for its batches, and blocks are dealt out
+     * round-robin, such that the consumer restores the order of the input by
+     * taking the batches round-robin as well. The depth of the queues bounds
+     * the number of blocks in flight, i.e. a slow consumer holds up the parsers
+     * and these the reader.
+     *
+     * Without parser threads -- or if the input fits into a single block -- the
+     * blocks are parsed and consumed by the calling thread, one after the other.
+     * Exceptions thrown by `parse` or `consume` stop all stages and are passed
+     * on to the caller.
+     */
+    template <typename Batch>
+    class LogPipeline {
+
+        /// Block of the input, [begin,end)
+        struct Block {
+            /// Pointer to the first character of the block
+            const char* begin;
+            /// Pointer past the last character of the block
+            const char* end;
+        };
+
+        /// Number of parser threads
+        std::size_t itsNofParsers;
+        /// Minimum size of a block (in bytes)
+        std::size_t itsBlockSize;
+        /// Number of blocks per queue
+        std::size_t itsDepth;
+
+    public:
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param nofParsers -- Number of parser threads; 0 processes the input on
+         *        the calling thread.
+         * \param blockSize  -- Minimum size of a block (in bytes).
+         * \param depth      -- Number of blocks queued per parser thread.
+         */
+        explicit LogPipeline (const std::size_t& nofParsers,
+                              const std::size_t& blockSize=1024*1024,
+                              const std::size_t& depth=4)
+            : itsNofParsers(nofParsers),
+              itsBlockSize(blockSize > 0 ? blockSize : 1),
+              itsDepth(depth > 0 ? depth : 1) {}
+
+        // === Parameter access ================================================
+
+        /// Get the number of parser threads
+        inline std::size_t nofParsers () const {
+            return itsNofParsers;
+        }
+
+        /// Get the minimum size of a block (in bytes)
+        inline std::size_t blockSize () const {
+            return itsBlockSize;
+        }
+
+        /// Get the number of blocks queued per parser thread
+        inline std::size_t depth () const {
+            return itsDepth;
+        }
+
+        // === Public methods ==================================================
+
+        /*!
+         * \brief Process the buffer [data,data+size)
+         * \param data    -- Pointer to the start of the buffer.
+         * \param size    -- Size of the buffer (in bytes).
+         * \param parse   -- Function object, called as `parse(begin, end, batch)`
+         *        for each block [begin,end); called concurrently for different
+         *        blocks.
+         * \param consume -- Function object, called as `consume(batch)` for the
+         *        batches in the order of the blocks, on the calling thread.
+         */
+        template <typename Parse, typename Consume>
+        void run (const char* data,
+                  const std::size_t& size,
+                  Parse parse,
+                  Consume consume) const {
+            const char* last = data + size;
+
+            if (itsNofParsers == 0 || size <= itsBlockSize) {
+                for (const char* begin=data; begin<last; ) {
+                    const char* end = nextBlock(begin, last, itsBlockSize);
+                    Batch batch;
+                    parse(begin, end, batch);
+                    consume(batch);
+                    begin = end;
+                }
+                return;
+            }
+
+            std::size_t nofParsers = itsNofParsers;
+            std::vector<std::unique_ptr<RingBuffer<Block> > > blocks;
+            std::vector<std::unique_ptr<RingBuffer<Batch> > > batches;
+            for (std::size_t n=0; n<nofParsers; ++n) {
+                blocks.push_back(std::unique_ptr<RingBuffer<Block> >(new RingBuffer<Block>(itsDepth)));
+                batches.push_back(std::unique_ptr<RingBuffer<Batch> >(new RingBuffer<Batch>(itsDepth)));
+            }
+
+            // First error encountered; closing all queues stops every stage
+            std::exception_ptr error;
+            std::mutex errorMutex;
+            auto fail = [&] () {
+                std::lock_guard<std::mutex> lock (errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                for (std::size_t n=0; n<nofParsers; ++n) {
+                    blocks[n]->close();
+                    batches[n]->close();
+                }
+            };
+
+            std::vector<std::thread> threads;
+
+            // Reader: cut the blocks and fault in their pages
+            std::size_t blockSize = itsBlockSize;
+            threads.push_back(std::thread([&, blockSize] () {
+                        std::size_t n = 0;
+                        for (const char* begin=data; begin<last; ++n) {
+                            Block block = {begin, nextBlock(begin, last, blockSize)};
+                            touch(block.begin, block.end);
+                            if (!blocks[n % nofParsers]->push(block)) {
+                                break;
+                            }
+                            begin = block.end;
+                        }
+                        for (std::size_t p=0; p<nofParsers; ++p) {
+                            blocks[p]->close();
+                        }
+                    }));
+
+            // Parsers
+            for (std::size_t p=0; p<nofParsers; ++p) {
+                threads.push_back(std::thread([&, p] () {
+                            try {
+                                Block block;
+                                while (blocks[p]->pop(block)) {
+                                    Batch batch;
+                                    parse(block.begin, block.end, batch);
+                                    if (!batches[p]->push(std::move(batch))) {
+                                        break;
+                                    }
+                                }
+                            } catch (...) {
+                                fail();
+                            }
+                            batches[p]->close();
+                        }));
+            }
+
+            // Aggregator: take the batches in the order of the blocks
+            try {
+                Batch batch;
+                for (std::size_t n=0; batches[n % nofParsers]->pop(batch); ++n) {
+                    consume(batch);
+                    std::lock_guard<std::mutex> lock (errorMutex);
+                    if (error) {
+                        break;
+                    }
+                }
+            } catch (...) {
+                fail();
+            }
+
+            for (auto it=threads.begin(); it!=threads.end(); ++it) {
+                it->join();
+            }
+
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // === Public static methods ===========================================
+
+        /*!
+         * \brief Find the end of the block starting at `begin`
+         * \param begin     -- Pointer to the first character of the block.
+         * \param last      -- Pointer past the last character of the buffer.
+         * \param blockSize -- Minimum size of the block (in bytes).
+         * \return Pointer past the first line break at or after `begin+blockSize`,
+         *         or `last` if there is none.
+         */
+        static const char* nextBlock (const char* begin,
+                                      const char* last,
+                                      const std::size_t& blockSize) {
+            if (std::size_t(last-begin) <= blockSize) {
+                return last;
+            }
+            const char* cut = begin + blockSize - 1;
+            const char* eol = static_cast<const char*>(std::memchr(cut, '\n', last-cut));
+            return (eol == NULL) ? last : eol+1;
+        }
+
+    private:
+
+        /// Read one byte per page of [begin,end), such that the pages are resident
+        static void touch (const char* begin,
+                           const char* end) {
+            volatile char sink = 0;
+            for (const char* it=begin; it<end; it+=4096) {
+                sink = sink ^ *it;
+            }
+            (void)sink;
+        }
+
+    };  //  class LogPipeline -- END
+
+}  //  namespace cgi -- END
+
+#endif
@@ -0,0 +1,43 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <new>
+
+#include "MemoryResource.h"
+
+namespace cgi {
+
+    /// Resource using the global operator new and operator delete
+    class NewDeleteResource : public MemoryResource {
+
+    protected:
+
+        void* doAllocate (std::size_t bytes,
+                          std::size_t) {
+            return ::operator new(bytes);
+        }
+
+        void doDeallocate (void* p,
+                           std::size_t,
+                           std::size_t) {
+            ::operator delete(p);
+        }
+
+        bool doIsEqual (const MemoryResource& other) const {
+            return this == &other;
+        }
+
+    };
+
+    //__________________________________________________________________________
+    //                                                         newDeleteResource
+
+    MemoryResource* newDeleteResource ()
+    {
+        static NewDeleteResource resource;
+        return &resource;
+    }
+
+}  //  namespace cgi -- END
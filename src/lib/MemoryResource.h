@@ -0,0 +1,75 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_MEMORYRESOURCE_H
+#define CGI_MEMORYRESOURCE_H
+
+/*!
+ * \file MemoryResource.h
+ * \brief Abstract interface to a source of memory for containers
+ */
+
+#include <cstddef>
+
+namespace cgi {
+
+    /*!
+     * \class MemoryResource
+     * \brief Abstract interface to a source of memory for containers
+     * \test test_PolymorphicAllocator.cc
+     *
+     * Modelled after ``std::pmr::memory_resource`` (which only becomes available
+     * with C++17): containers using a cgi::PolymorphicAllocator obtain their
+     * memory through a pointer to a resource, such that the allocation strategy
+     * -- e.g. a cgi::MonotonicArena for short-lived temporaries -- can be chosen
+     * at runtime without changing the type of the container.
+     */
+    class MemoryResource {
+
+    public:
+
+        /// Destructor
+        virtual ~MemoryResource () {}
+
+        /// Allocate storage with a size of at least `bytes` bytes
+        void* allocate (std::size_t bytes,
+                        std::size_t alignment=alignof(std::max_align_t)) {
+            return doAllocate(bytes, alignment);
+        }
+
+        /// Deallocate storage previously obtained through allocate()
+        void deallocate (void* p,
+                         std::size_t bytes,
+                         std::size_t alignment=alignof(std::max_align_t)) {
+            doDeallocate(p, bytes, alignment);
+        }
+
+        /// Can memory allocated from this be deallocated from `other`?
+        bool isEqual (const MemoryResource& other) const {
+            return this == &other || doIsEqual(other);
+        }
+
+    protected:
+
+        /// Allocate storage
+        virtual void* doAllocate (std::size_t bytes,
+                                  std::size_t alignment) = 0;
+
+        /// Deallocate storage
+        virtual void doDeallocate (void* p,
+                                   std::size_t bytes,
+                                   std::size_t alignment) = 0;
+
+        /// Compare for equality with another resource
+        virtual bool doIsEqual (const MemoryResource& other) const = 0;
+
+    };  //  class MemoryResource -- END
+
+    /// Get the resource using the global ``operator new`` and ``operator delete``
+    MemoryResource* newDeleteResource ();
+
+}  //  namespace cgi -- END
+
+#endif
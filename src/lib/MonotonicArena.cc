@@ -0,0 +1,120 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cstdint>
+
+#include "MonotonicArena.h"
+
+namespace cgi {
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                            MonotonicArena
+
+    MonotonicArena::MonotonicArena (const std::size_t& initialSize,
+                                    MemoryResource* upstream)
+        : itsUpstream(upstream),
+          itsInitialBuffer(NULL),
+          itsInitialSize(0),
+          itsChunks(NULL),
+          itsCurrent(NULL),
+          itsRemaining(0),
+          itsNextSize(std::max<std::size_t>(initialSize, 64)),
+          itsNofChunks(0)
+    {
+    }
+
+    //__________________________________________________________________________
+    //                                                            MonotonicArena
+
+    MonotonicArena::MonotonicArena (void* buffer,
+                                    const std::size_t& size,
+                                    MemoryResource* upstream)
+        : itsUpstream(upstream),
+          itsInitialBuffer(static_cast<char*>(buffer)),
+          itsInitialSize(size),
+          itsChunks(NULL),
+          itsCurrent(static_cast<char*>(buffer)),
+          itsRemaining(size),
+          itsNextSize(std::max<std::size_t>(2*size, 64)),
+          itsNofChunks(0)
+    {
+    }
+
+    //__________________________________________________________________________
+    //                                                           ~MonotonicArena
+
+    MonotonicArena::~MonotonicArena ()
+    {
+        release();
+    }
+
+    // =========================================================================
+    //
+    //  Public methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                   release
+
+    void MonotonicArena::release ()
+    {
+        while (itsChunks != NULL) {
+            Chunk* next = itsChunks->next;
+            itsUpstream->deallocate(itsChunks, itsChunks->size);
+            itsChunks = next;
+        }
+
+        itsNofChunks = 0;
+        itsCurrent   = itsInitialBuffer;
+        itsRemaining = itsInitialSize;
+    }
+
+    // =========================================================================
+    //
+    //  Protected methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                doAllocate
+
+    void* MonotonicArena::doAllocate (std::size_t bytes,
+                                      std::size_t alignment)
+    {
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(itsCurrent);
+        std::size_t padding    = (alignment - address % alignment) % alignment;
+
+        if (itsCurrent == NULL || padding + bytes > itsRemaining) {
+            // Obtain a new chunk from upstream, large enough for the request
+            std::size_t size = std::max(itsNextSize, sizeof(Chunk) + bytes + alignment);
+            Chunk* chunk     = static_cast<Chunk*>(itsUpstream->allocate(size));
+            chunk->next      = itsChunks;
+            chunk->size      = size;
+            itsChunks        = chunk;
+            itsCurrent       = reinterpret_cast<char*>(chunk) + sizeof(Chunk);
+            itsRemaining     = size - sizeof(Chunk);
+            itsNextSize      = 2*size;
+            ++itsNofChunks;
+
+            address = reinterpret_cast<std::uintptr_t>(itsCurrent);
+            padding = (alignment - address % alignment) % alignment;
+        }
+
+        void* result  = itsCurrent + padding;
+        itsCurrent   += padding + bytes;
+        itsRemaining -= padding + bytes;
+
+        return result;
+    }
+
+}  //  namespace cgi -- END
@@ -0,0 +1,124 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_MONOTONICARENA_H
+#define CGI_MONOTONICARENA_H
+
+/*!
+ * \file MonotonicArena.h
+ * \brief Memory resource releasing its memory only upon destruction
+ */
+
+#include <cstddef>
+
+#include "MemoryResource.h"
+
+namespace cgi {
+
+    /*!
+     * \class MonotonicArena
+     * \brief Memory resource releasing its memory only upon destruction
+     * \test test_MonotonicArena.cc
+     *
+     * Modelled after ``std::pmr::monotonic_buffer_resource``: memory is handed
+     * out by bumping a pointer through chunks obtained from an upstream resource,
+     * deallocation is a no-op and all memory is returned at once when the arena
+     * is released. Starting from an (optional) initial buffer -- e.g. residing
+     * on the stack -- the size of each further chunk grows geometrically, such
+     * that filling a container of \f$ N \f$ nodes takes \f$ O(\log N) \f$
+     * calls to the upstream resource rather than \f$ N \f$.
+     */
+    class MonotonicArena : public MemoryResource {
+
+        /// Header placed at the start of each chunk obtained from upstream
+        struct Chunk {
+            Chunk* next;
+            std::size_t size;
+        };
+
+        /// Resource from which the chunks are obtained
+        MemoryResource* itsUpstream;
+        /// Initial buffer provided by the user (not owned)
+        char* itsInitialBuffer;
+        /// Size of the initial buffer
+        std::size_t itsInitialSize;
+        /// Chunks obtained from upstream, most recent first
+        Chunk* itsChunks;
+        /// Current position within the active buffer
+        char* itsCurrent;
+        /// Number of bytes remaining in the active buffer
+        std::size_t itsRemaining;
+        /// Size of the next chunk to obtain from upstream
+        std::size_t itsNextSize;
+        /// Number of chunks obtained from upstream
+        std::size_t itsNofChunks;
+
+    public:
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param initialSize -- Size of the first chunk to obtain from upstream.
+         * \param upstream    -- Resource from which the chunks are obtained.
+         */
+        MonotonicArena (const std::size_t& initialSize=4096,
+                        MemoryResource* upstream=newDeleteResource());
+
+        /*!
+         * \brief Argumented constructor
+         * \param buffer   -- Initial buffer, used before turning to upstream.
+         * \param size     -- Size of the initial buffer (in bytes).
+         * \param upstream -- Resource from which further chunks are obtained.
+         */
+        MonotonicArena (void* buffer,
+                        const std::size_t& size,
+                        MemoryResource* upstream=newDeleteResource());
+
+        /// Destructor, releasing all memory
+        ~MonotonicArena ();
+
+        // === Parameter access ================================================
+
+        /// Get the resource from which the chunks are obtained
+        inline MemoryResource* upstream () const {
+            return itsUpstream;
+        }
+
+        /// Get the number of chunks obtained from upstream
+        inline std::size_t nofChunks () const {
+            return itsNofChunks;
+        }
+
+        // === Public methods ==================================================
+
+        /// Release all memory obtained from upstream
+        void release ();
+
+    protected:
+
+        void* doAllocate (std::size_t bytes,
+                          std::size_t alignment);
+
+        void doDeallocate (void*,
+                           std::size_t,
+                           std::size_t) {
+        }
+
+        bool doIsEqual (const MemoryResource& other) const {
+            return this == &other;
+        }
+
+    private:
+
+        // Objects of this type own the memory handed out
+        MonotonicArena (const MonotonicArena&);
+        MonotonicArena& operator= (const MonotonicArena&);
+
+    };  //  class MonotonicArena -- END
+
+}  //  namespace cgi -- END
+
+#endif
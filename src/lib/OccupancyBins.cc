@@ -0,0 +1,132 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+
+#include "OccupancyBins.h"
+
+namespace cgi {
+
+    /// Get the index of the bin holding `time`, rounding towards minus infinity
+    static inline std::int64_t binIndex (const std::int64_t& time,
+                                         const std::int64_t& origin,
+                                         const std::int64_t& width)
+    {
+        std::int64_t offset = time - origin;
+        std::int64_t index  = offset / width;
+        if (offset % width < 0) {
+            --index;
+        }
+        return index;
+    }
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                             OccupancyBins
+
+    OccupancyBins::OccupancyBins (const std::int64_t& width,
+                                  const std::int64_t& origin,
+                                  const TimeWindow& window)
+        : itsWidth(width > 0 ? width : 1),
+          itsOrigin(origin),
+          itsWindow(window),
+          itsFirst(0)
+    {
+    }
+
+    // =========================================================================
+    //
+    //  Public methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                       add
+
+    void OccupancyBins::add (const std::int64_t& begin,
+                             const std::int64_t& end,
+                             const int& count)
+    {
+        std::int64_t from = std::max(begin, itsWindow.begin());
+        std::int64_t to   = std::min(end, itsWindow.end());
+
+        for (std::int64_t index=binIndex(from, itsOrigin, itsWidth); from < to; ++index) {
+            Bin& current        = bin(index);
+            std::int64_t length = std::min(to, current.end) - from;
+
+            if (current.covered == 0) {
+                current.min = count;
+                current.max = count;
+            } else {
+                current.min = std::min(current.min, count);
+                current.max = std::max(current.max, count);
+            }
+            current.sum     += std::int64_t(count)*length;
+            current.covered += length;
+
+            from = current.end;
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                                       add
+
+    void OccupancyBins::add (const std::vector<TimePoint>& visitorsPerTime)
+    {
+        for (std::size_t n=1; n<visitorsPerTime.size(); ++n) {
+            add(visitorsPerTime[n-1].time().rawtime(),
+                visitorsPerTime[n].time().rawtime(),
+                visitorsPerTime[n-1].count());
+        }
+    }
+
+    // =========================================================================
+    //
+    //  Private methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                       bin
+
+    OccupancyBins::Bin& OccupancyBins::bin (const std::int64_t& index)
+    {
+        if (itsBins.empty()) {
+            itsFirst = index;
+        }
+
+        Bin empty;
+        empty.min     = 0;
+        empty.max     = 0;
+        empty.sum     = 0;
+        empty.covered = 0;
+
+        // extend the range of bins to include `index`, at the back ...
+        while (index >= itsFirst + std::int64_t(itsBins.size())) {
+            empty.begin = itsOrigin + (itsFirst + std::int64_t(itsBins.size()))*itsWidth;
+            empty.end   = empty.begin + itsWidth;
+            itsBins.push_back(empty);
+        }
+
+        // ... or at the front
+        if (index < itsFirst) {
+            std::vector<Bin> front (itsFirst - index, empty);
+            for (std::size_t n=0; n<front.size(); ++n) {
+                front[n].begin = itsOrigin + (index + std::int64_t(n))*itsWidth;
+                front[n].end   = front[n].begin + itsWidth;
+            }
+            itsBins.insert(itsBins.begin(), front.begin(), front.end());
+            itsFirst = index;
+        }
+
+        return itsBins[index - itsFirst];
+    }
+
+}  //  namespace cgi -- END
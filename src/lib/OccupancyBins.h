@@ -0,0 +1,165 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_OCCUPANCYBINS_H
+#define CGI_OCCUPANCYBINS_H
+
+/*!
+ * \file OccupancyBins.h
+ * \brief Class for the number of visitors downsampled to a regular grid
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "TimePoint.h"
+#include "TimeWindow.h"
+
+namespace cgi {
+
+    /*!
+     * \class OccupancyBins
+     * \brief Number of visitors downsampled to a regular grid of time bins
+     * \test test_OccupancyBins.cc
+     *
+     * The step function of the number of visitors -- one step per distinct
+     * point in time -- is reduced to bins of a fixed width(), aligned to
+     * origin(), keeping the minimum, the (time-weighted) mean and the maximum
+     * number of visitors per bin. This way the size of the result depends on
+     * the range of times covered, rather than on the number of events.
+     *
+     * Steps are added one by one, e.g. by cgi::OccupancySweep in the same pass
+     * that builds the timeline (see OccupancySweep::setBins()), or from an
+     * existing timeline. Only the part of the steps within timeWindow() is
+     * taken into account; the statistics of a bin cover the part of the bin
+     * for which steps have been added, see Bin::covered.
+     */
+    class OccupancyBins {
+
+    public:
+
+        /*!
+         * \struct Bin
+         * \brief Statistics of a single time bin
+         */
+        struct Bin {
+            /// Begin of the bin (inclusive)
+            std::int64_t begin;
+            /// End of the bin (exclusive)
+            std::int64_t end;
+            /// Minimum number of visitors
+            int min;
+            /// Maximum number of visitors
+            int max;
+            /// Number of visitors, integrated over time
+            std::int64_t sum;
+            /// Length of time covered by steps
+            std::int64_t covered;
+
+            /// Get the time-weighted mean number of visitors
+            inline double mean () const {
+                return covered > 0 ? double(sum)/double(covered) : 0.0;
+            }
+        };
+
+    private:
+
+        /// Width of the bins
+        std::int64_t itsWidth;
+        /// Point in time to which the bins are aligned
+        std::int64_t itsOrigin;
+        /// Time window, to which the steps are restricted
+        TimeWindow itsWindow;
+        /// Index of the first bin, counted from the origin
+        std::int64_t itsFirst;
+        /// Statistics per bin
+        std::vector<Bin> itsBins;
+
+        /// Get the bin with index `index`, counted from the origin
+        Bin& bin (const std::int64_t& index);
+
+    public:
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param width  -- Width of the bins, in the units of the event times.
+         * \param origin -- Point in time to which the bins are aligned, e.g.
+         *        the start of the day.
+         * \param window -- Time window, to which to restrict the steps.
+         */
+        OccupancyBins (const std::int64_t& width,
+                       const std::int64_t& origin=0,
+                       const TimeWindow& window=TimeWindow());
+
+        // === Parameter access ================================================
+
+        /// Get the width of the bins
+        inline std::int64_t width () const {
+            return itsWidth;
+        }
+
+        /// Get the point in time to which the bins are aligned
+        inline std::int64_t origin () const {
+            return itsOrigin;
+        }
+
+        /// Get the time window, to which the steps are restricted
+        inline const TimeWindow& timeWindow () const {
+            return itsWindow;
+        }
+
+        /// Get the number of bins, from the first to the last one covered
+        inline std::size_t size () const {
+            return itsBins.size();
+        }
+
+        /// Are there any bins?
+        inline bool empty () const {
+            return itsBins.empty();
+        }
+
+        /// Get the n-th bin
+        inline const Bin& operator[] (const std::size_t& n) const {
+            return itsBins[n];
+        }
+
+        /// Get iterator to the first bin
+        inline std::vector<Bin>::const_iterator begin () const {
+            return itsBins.begin();
+        }
+
+        /// Get iterator past the last bin
+        inline std::vector<Bin>::const_iterator end () const {
+            return itsBins.end();
+        }
+
+        // === Public methods ==================================================
+
+        /*!
+         * \brief Add a step of the number of visitors
+         * \param begin -- Begin of the step (inclusive).
+         * \param end   -- End of the step (exclusive).
+         * \param count -- Number of visitors during the step.
+         */
+        void add (const std::int64_t& begin,
+                  const std::int64_t& end,
+                  const int& count);
+
+        /*!
+         * \brief Add the steps of a timeline
+         * \param visitorsPerTime -- Number of visitors per point in time, e.g.
+         *        as recorded by cgi::OccupancySweep; each point starts a step
+         *        lasting until the next one.
+         */
+        void add (const std::vector<TimePoint>& visitorsPerTime);
+
+    };  //  class OccupancyBins -- END
+
+}  //  namespace cgi -- END
+
+#endif
@@ -0,0 +1,95 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <cstdlib>
+
+#include "OccupancyDiff.h"
+
+namespace cgi {
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                             OccupancyDiff
+
+    OccupancyDiff::OccupancyDiff (const LogData& first,
+                                  const LogData& second)
+        : itsDuration(0),
+          itsMaxDifference(0),
+          itsNetDifference(0)
+    {
+        // Walk the cached event lists of both logs in a single merged sweep
+        const LogData::EventArray& eventsFirst  = first.sortedEvents();
+        const LogData::EventArray& eventsSecond = second.sortedEvents();
+
+        auto itFirst  = eventsFirst.begin();
+        auto itSecond = eventsSecond.begin();
+
+        int difference         = 0;
+        std::int64_t timeBegin = 0;
+
+        while (itFirst != eventsFirst.end() || itSecond != eventsSecond.end()) {
+            // next point in time across both event streams
+            std::int64_t time;
+            if (itSecond == eventsSecond.end()
+                || (itFirst != eventsFirst.end() && itFirst->time() < itSecond->time())) {
+                time = itFirst->time();
+            } else {
+                time = itSecond->time();
+            }
+
+            // apply all events at this point in time
+            int current = difference;
+            while (itFirst != eventsFirst.end() && itFirst->time() == time) {
+                current += itFirst->delta();
+                ++itFirst;
+            }
+            while (itSecond != eventsSecond.end() && itSecond->time() == time) {
+                current -= itSecond->delta();
+                ++itSecond;
+            }
+
+            if (current == difference) {
+                continue;
+            }
+
+            // close the interval with the previous difference
+            if (difference != 0) {
+                itsIntervals.push_back(Interval<DateTime,int>(DateTime(std::time_t(timeBegin)),
+                                                              DateTime(std::time_t(time)),
+                                                              difference));
+                itsDuration      += time - timeBegin;
+                itsNetDifference += difference * (time - timeBegin);
+                if (std::abs(difference) > std::abs(itsMaxDifference)) {
+                    itsMaxDifference = difference;
+                }
+            }
+
+            difference = current;
+            timeBegin  = time;
+        }
+    }
+
+    // =========================================================================
+    //
+    //  Operator overloading
+    //
+    // =========================================================================
+
+    std::ostream& operator<< (std::ostream &os, const OccupancyDiff &rhs)
+    {
+        os << "Number of intervals = " << rhs.nofIntervals() << "\n"
+           << "Total duration      = " << rhs.duration() << " s\n"
+           << "Max. difference     = " << rhs.maxDifference() << "\n"
+           << "Net difference      = " << rhs.netDifference() << " visitor-s\n";
+
+        return os;
+    }
+
+}  //  namespace cgi -- END
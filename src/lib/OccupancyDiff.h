@@ -0,0 +1,99 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_OCCUPANCYDIFF_H
+#define CGI_OCCUPANCYDIFF_H
+
+/*!
+ * \file OccupancyDiff.h
+ * \brief Class for the comparison of the occupancy recorded by two logs
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "DateTime.h"
+#include "Interval.h"
+#include "LogData.h"
+
+namespace cgi {
+
+    /*!
+     * \class OccupancyDiff
+     * \brief Difference in the number of visitors recorded by two logs
+     * \test test_OccupancyDiff.cc
+     *
+     * Typical use case is the comparison of two data sources for the same day,
+     * e.g. turnstile logs against ticket scans. The event streams of both logs
+     * are swept together in one merged pass; whenever the difference in the
+     * number of visitors (first minus second log) changes, the interval with
+     * the previous non-zero difference is recorded.
+     */
+    class OccupancyDiff {
+
+        /// Time intervals during which the occupancy differs
+        std::vector<Interval<DateTime,int> > itsIntervals;
+        /// Total duration during which the occupancy differs
+        std::int64_t itsDuration;
+        /// Largest (absolute) difference in the number of visitors
+        int itsMaxDifference;
+        /// Time-integrated difference in the number of visitors
+        std::int64_t itsNetDifference;
+
+    public:
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param first  -- First log to compare.
+         * \param second -- Second log to compare.
+         */
+        OccupancyDiff (const LogData& first,
+                       const LogData& second);
+
+        // === Operator overloading ============================================
+
+        /// Overloading of output stream operator
+        friend std::ostream& operator<< (std::ostream& os, const OccupancyDiff& rhs);
+
+        // === Parameter access ================================================
+
+        /// Get the time intervals during which the occupancy differs
+        inline const std::vector<Interval<DateTime,int> >& intervals () const {
+            return itsIntervals;
+        }
+
+        /// Get the number of intervals during which the occupancy differs
+        inline std::size_t nofIntervals () const {
+            return itsIntervals.size();
+        }
+
+        /// Get the total duration (in seconds) during which the occupancy differs
+        inline std::int64_t duration () const {
+            return itsDuration;
+        }
+
+        /// Get the largest difference, (first - second), by absolute value
+        inline int maxDifference () const {
+            return itsMaxDifference;
+        }
+
+        /// Get the time-integrated difference (in visitor-seconds)
+        inline std::int64_t netDifference () const {
+            return itsNetDifference;
+        }
+
+        /// Check whether both logs record the same occupancy at all times
+        inline bool isEqual () const {
+            return itsIntervals.empty();
+        }
+
+    };  //  class OccupancyDiff -- END
+
+}  //  namespace cgi -- END
+
+#endif
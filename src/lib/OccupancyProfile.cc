@@ -0,0 +1,277 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <limits>
+
+#include "OccupancyProfile.h"
+
+namespace cgi {
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                          OccupancyProfile
+
+    OccupancyProfile::OccupancyProfile ()
+    {
+        buildTree();
+    }
+
+    //__________________________________________________________________________
+    //                                                          OccupancyProfile
+
+    OccupancyProfile::OccupancyProfile (const std::int64_t* times,
+                                        const int* counts,
+                                        const std::size_t& size,
+                                        const int* tree)
+        : itsTimesData(times),
+          itsCountsData(counts),
+          itsTreeData(tree),
+          itsSize(size),
+          itsLeaves(nofLeaves(size))
+    {
+    }
+
+    //__________________________________________________________________________
+    //                                                          OccupancyProfile
+
+    OccupancyProfile::OccupancyProfile (const OccupancyProfile& other)
+    {
+        *this = other;
+    }
+
+    // =========================================================================
+    //
+    //  Operator overloading
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                 operator=
+
+    OccupancyProfile& OccupancyProfile::operator= (const OccupancyProfile& other)
+    {
+        if (this == &other) {
+            return *this;
+        }
+
+        itsTimes  = other.itsTimes;
+        itsCounts = other.itsCounts;
+        itsTree   = other.itsTree;
+        itsSize   = other.itsSize;
+        itsLeaves = other.itsLeaves;
+
+        if (other.itsTreeData == other.itsTree.data()) {
+            bind();
+        } else {
+            // refer to the same external arrays
+            itsTimesData  = other.itsTimesData;
+            itsCountsData = other.itsCountsData;
+            itsTreeData   = other.itsTreeData;
+        }
+
+        return *this;
+    }
+
+    // =========================================================================
+    //
+    //  Public methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                        at
+
+    int OccupancyProfile::at (const std::int64_t& time) const
+    {
+        std::ptrdiff_t n = step(time);
+        return n < 0 ? 0 : itsCountsData[n];
+    }
+
+    //__________________________________________________________________________
+    //                                                            maxNofVisitors
+
+    int OccupancyProfile::maxNofVisitors (const std::int64_t& begin,
+                                          const std::int64_t& end) const
+    {
+        if (!(begin < end)) {
+            return 0;
+        }
+
+        std::ptrdiff_t first = step(begin);
+        std::ptrdiff_t last  = std::lower_bound(itsTimesData, itsTimesData+itsSize, end) - itsTimesData - 1;
+
+        // no visitors before the first step
+        int result = 0;
+        if (last >= 0) {
+            result = std::max(result, maxSteps(std::max<std::ptrdiff_t>(first, 0), last));
+        }
+
+        return result;
+    }
+
+    //__________________________________________________________________________
+    //                                                            maxNofVisitors
+
+    int OccupancyProfile::maxNofVisitors () const
+    {
+        return std::max(itsTreeData[1], 0);
+    }
+
+    //__________________________________________________________________________
+    //                                                              maxIntervals
+
+    IntervalSet<std::int64_t,int> OccupancyProfile::maxIntervals (const std::int64_t& begin,
+                                                                  const std::int64_t& end) const
+    {
+        IntervalSet<std::int64_t,int> result;
+        int max = maxNofVisitors(begin, end);
+
+        if (max <= 0) {
+            return result;
+        }
+
+        std::size_t first = std::max<std::ptrdiff_t>(step(begin), 0);
+        std::size_t last  = std::lower_bound(itsTimesData, itsTimesData+itsSize, end) - itsTimesData;
+
+        for (std::size_t n=findStep(first, max); n<last; n=findStep(n+1, max)) {
+            std::int64_t from = std::max(itsTimesData[n], begin);
+            std::int64_t to   = n+1 < itsSize ? std::min(itsTimesData[n+1], end) : end;
+            result.insert(from, to, max);
+        }
+
+        return result;
+    }
+
+    //__________________________________________________________________________
+    //                                                              maxIntervals
+
+    IntervalSet<std::int64_t,int> OccupancyProfile::maxIntervals () const
+    {
+        return maxIntervals(std::numeric_limits<std::int64_t>::min(),
+                            std::numeric_limits<std::int64_t>::max());
+    }
+
+    // =========================================================================
+    //
+    //  Private methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                      step
+
+    std::ptrdiff_t OccupancyProfile::step (const std::int64_t& time) const
+    {
+        return std::upper_bound(itsTimesData, itsTimesData+itsSize, time) - itsTimesData - 1;
+    }
+
+    //__________________________________________________________________________
+    //                                                                  maxSteps
+
+    int OccupancyProfile::maxSteps (std::size_t first,
+                                    std::size_t last) const
+    {
+        int result = std::numeric_limits<int>::min();
+
+        // bottom-up over the half-open range of leaves [first,last+1)
+        for (first += itsLeaves, last += itsLeaves+1; first < last; first /= 2, last /= 2) {
+            if (first & 1) {
+                result = std::max(result, itsTreeData[first++]);
+            }
+            if (last & 1) {
+                result = std::max(result, itsTreeData[--last]);
+            }
+        }
+
+        return result;
+    }
+
+    //__________________________________________________________________________
+    //                                                                  findStep
+
+    std::size_t OccupancyProfile::findStep (const std::size_t& first,
+                                            const int& value) const
+    {
+        return findNode(1, 0, itsLeaves, first, value);
+    }
+
+    //__________________________________________________________________________
+    //                                                                  findNode
+
+    std::size_t OccupancyProfile::findNode (const std::size_t& node,
+                                            const std::size_t& begin,
+                                            const std::size_t& end,
+                                            const std::size_t& first,
+                                            const int& value) const
+    {
+        if (end <= first || itsTreeData[node] < value) {
+            return itsSize;
+        }
+        if (end-begin == 1) {
+            return begin;
+        }
+
+        std::size_t middle = begin + (end-begin)/2;
+        std::size_t result = findNode(2*node, begin, middle, first, value);
+        if (result == itsSize) {
+            result = findNode(2*node+1, middle, end, first, value);
+        }
+
+        return result;
+    }
+
+    //__________________________________________________________________________
+    //                                                                 buildTree
+
+    void OccupancyProfile::buildTree ()
+    {
+        itsSize   = itsTimes.size();
+        itsLeaves = nofLeaves(itsSize);
+
+        itsTree.assign(2*itsLeaves, std::numeric_limits<int>::min());
+        std::copy(itsCounts.begin(), itsCounts.end(), itsTree.begin()+itsLeaves);
+
+        for (std::size_t n=itsLeaves-1; n>0; --n) {
+            itsTree[n] = std::max(itsTree[2*n], itsTree[2*n+1]);
+        }
+
+        bind();
+    }
+
+    //__________________________________________________________________________
+    //                                                                      bind
+
+    void OccupancyProfile::bind ()
+    {
+        itsTimesData  = itsTimes.data();
+        itsCountsData = itsCounts.data();
+        itsTreeData   = itsTree.data();
+    }
+
+    // =========================================================================
+    //
+    //  Public static methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                 nofLeaves
+
+    std::size_t OccupancyProfile::nofLeaves (const std::size_t& size)
+    {
+        std::size_t result = 1;
+        while (result < size) {
+            result *= 2;
+        }
+        return result;
+    }
+
+}  //  namespace cgi -- END
@@ -0,0 +1,215 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_OCCUPANCYPROFILE_H
+#define CGI_OCCUPANCYPROFILE_H
+
+/*!
+ * \file OccupancyProfile.h
+ * \brief Class for the number of visitors as step function of time
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Event.h"
+#include "IntervalSet.h"
+
+namespace cgi {
+
+    /*!
+     * \class OccupancyProfile
+     * \brief Number of visitors as step function of time, indexed for queries
+     * \test test_OccupancyProfile.cc
+     *
+     * The profile is built once from the time-ordered list of events; it holds
+     * one step per distinct point in time, along with a tree of the maxima over
+     * the steps. Afterwards, queries are answered without stepping through the
+     * events again:
+     *
+     * \li at() -- number of visitors at a point in time, \f$ O(\log N) \f$;
+     * \li maxNofVisitors() -- maximum number of visitors over time window,
+     *     \f$ O(\log N) \f$;
+     * \li maxIntervals() -- time intervals during which that maximum is
+     *     reached, \f$ O(\log N) \f$ per interval.
+     *
+     * As for cgi::LogData::nofVisitors(), a visitor is counted as present at
+     * time \f$ t \f$ if \f$ t_{entry} \leq t < t_{exit} \f$. Times are given in
+     * ticks of the clock used for the log data.
+     *
+     * The arrays are either owned by the profile or -- if constructed from
+     * pointers -- referred to without copying, e.g. when placed in a memory
+     * mapped cgi::OccupancySnapshot, which then is required to outlive the
+     * profile.
+     */
+    class OccupancyProfile {
+
+        /// Start of the steps (if owned)
+        std::vector<std::int64_t> itsTimes;
+        /// Number of visitors from the start of a step to the start of the next (if owned)
+        std::vector<int> itsCounts;
+        /// Tree of maxima over the steps; node `n` has children `2n` and `2n+1` (if owned)
+        std::vector<int> itsTree;
+        /// Pointer to the start of the steps
+        const std::int64_t* itsTimesData;
+        /// Pointer to the number of visitors per step
+        const int* itsCountsData;
+        /// Pointer to the tree of maxima
+        const int* itsTreeData;
+        /// Number of steps
+        std::size_t itsSize;
+        /// Number of leaves of the tree of maxima (power of two)
+        std::size_t itsLeaves;
+
+        /// Index of the step containing `time`; -1 if before the first step
+        std::ptrdiff_t step (const std::int64_t& time) const;
+
+        /// Maximum over the steps [first,last]
+        int maxSteps (std::size_t first,
+                      std::size_t last) const;
+
+        /// First step from `first` onwards with at least `value` visitors
+        std::size_t findStep (const std::size_t& first,
+                              const int& value) const;
+
+        /// Descend from `node`, covering steps [begin,end), for findStep()
+        std::size_t findNode (const std::size_t& node,
+                              const std::size_t& begin,
+                              const std::size_t& end,
+                              const std::size_t& first,
+                              const int& value) const;
+
+        /// Build the tree of maxima over the steps
+        void buildTree ();
+
+        /// Point to the arrays owned by the profile
+        void bind ();
+
+    public:
+
+        // === Construction ====================================================
+
+        /// Default constructor
+        OccupancyProfile ();
+
+        /*!
+         * \brief Argumented constructor
+         * \param events -- Time-ordered list of events, see cgi::LogData::events().
+         */
+        template <typename Array>
+        OccupancyProfile (const Array& events) {
+            build(events.begin(), events.end());
+        }
+
+        /*!
+         * \brief Argumented constructor, referring to existing arrays
+         * \param times  -- Start of the steps, see times().
+         * \param counts -- Number of visitors per step, see counts().
+         * \param size   -- Number of steps.
+         * \param tree   -- Tree of maxima over the steps, see tree().
+         */
+        OccupancyProfile (const std::int64_t* times,
+                          const int* counts,
+                          const std::size_t& size,
+                          const int* tree);
+
+        /// Copy constructor
+        OccupancyProfile (const OccupancyProfile& other);
+
+        /// Copy assignment
+        OccupancyProfile& operator= (const OccupancyProfile& other);
+
+        // === Parameter access ================================================
+
+        /// Get the number of steps
+        inline std::size_t size () const {
+            return itsSize;
+        }
+
+        /// Get the start of the steps, in ascending order
+        inline const std::int64_t* times () const {
+            return itsTimesData;
+        }
+
+        /// Get the number of visitors per step
+        inline const int* counts () const {
+            return itsCountsData;
+        }
+
+        /// Get the tree of maxima over the steps, with treeSize() nodes
+        inline const int* tree () const {
+            return itsTreeData;
+        }
+
+        /// Get the number of nodes of the tree of maxima
+        inline std::size_t treeSize () const {
+            return 2*itsLeaves;
+        }
+
+        /// Get the number of leaves of the tree of maxima for `size` steps
+        static std::size_t nofLeaves (const std::size_t& size);
+
+        // === Public methods ==================================================
+
+        /*!
+         * \brief Build the profile from a time-ordered list of events
+         * \param first -- Iterator to the first event.
+         * \param last  -- Iterator past the last event.
+         */
+        template <typename Iterator>
+        void build (Iterator first,
+                    Iterator last) {
+            itsTimes.clear();
+            itsCounts.clear();
+
+            int count = 0;
+            for (; first!=last; ++first) {
+                count += first->delta();
+                if (!itsTimes.empty() && itsTimes.back() == first->time()) {
+                    itsCounts.back() = count;
+                } else {
+                    itsTimes.push_back(first->time());
+                    itsCounts.push_back(count);
+                }
+            }
+
+            buildTree();
+        }
+
+        /// Get the number of visitors at time `time`
+        int at (const std::int64_t& time) const;
+
+        /*!
+         * \brief Get the maximum number of visitors within [begin,end)
+         * \param begin -- Begin of the time window (inclusive).
+         * \param end   -- End of the time window (exclusive).
+         */
+        int maxNofVisitors (const std::int64_t& begin,
+                            const std::int64_t& end) const;
+
+        /// Get the maximum number of visitors
+        int maxNofVisitors () const;
+
+        /*!
+         * \brief Get the time intervals within [begin,end) with the maximum
+         * \param begin -- Begin of the time window (inclusive).
+         * \param end   -- End of the time window (exclusive).
+         * \return Time intervals, clipped to the window, during which the
+         *         maximum number of visitors within the window is reached;
+         *         empty if there are no visitors at all.
+         */
+        IntervalSet<std::int64_t,int> maxIntervals (const std::int64_t& begin,
+                                                    const std::int64_t& end) const;
+
+        /// Get the time intervals during which the maximum is reached
+        IntervalSet<std::int64_t,int> maxIntervals () const;
+
+    };  //  class OccupancyProfile -- END
+
+}  //  namespace cgi -- END
+
+#endif
@@ -0,0 +1,317 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "LogEntryView.h"
+#include "OccupancySnapshot.h"
+
+namespace cgi {
+
+    const std::uint32_t OccupancySnapshot::version;
+
+    /// Identifier at the start of a snapshot file
+    static const char snapshotMagic[8] = {'C', 'G', 'I', 'S', 'N', 'A', 'P', '\0'};
+
+    /// Marker for the byte order of the host
+    static const std::uint32_t byteOrderMarker = 0x01020304;
+
+    /// Round `size` up to a multiple of 8 bytes
+    static inline std::uint64_t aligned (const std::uint64_t& size)
+    {
+        return (size + 7) & ~std::uint64_t(7);
+    }
+
+    /*!
+     * \brief Get size and modification time (in nanoseconds) of a file
+     * \return Could the information be retrieved?
+     */
+    static bool fileStatus (const std::string& filename,
+                            std::int64_t& size,
+                            std::int64_t& modified)
+    {
+        struct stat info;
+        if (stat(filename.c_str(), &info) != 0) {
+            return false;
+        }
+        size     = info.st_size;
+        modified = std::int64_t(info.st_mtim.tv_sec)*1000000000 + info.st_mtim.tv_nsec;
+        return true;
+    }
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                         OccupancySnapshot
+
+    OccupancySnapshot::OccupancySnapshot ()
+        : itsMapping(NULL),
+          itsMappedSize(0)
+    {
+    }
+
+    //__________________________________________________________________________
+    //                                                         OccupancySnapshot
+
+    OccupancySnapshot::OccupancySnapshot (const std::string& filename)
+        : itsMapping(NULL),
+          itsMappedSize(0)
+    {
+        open(filename);
+    }
+
+    //__________________________________________________________________________
+    //                                                        ~OccupancySnapshot
+
+    OccupancySnapshot::~OccupancySnapshot ()
+    {
+        close();
+    }
+
+    // =========================================================================
+    //
+    //  Parameter access
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                            dictionarySize
+
+    std::size_t OccupancySnapshot::dictionarySize (const std::size_t& n) const
+    {
+        const Section* sections = reinterpret_cast<const Section*>(itsMapping + sizeof(Header));
+        return sections[6 + 3*n].size/sizeof(std::uint64_t) - 1;
+    }
+
+    //__________________________________________________________________________
+    //                                                           dictionaryValue
+
+    std::string OccupancySnapshot::dictionaryValue (const std::size_t& n,
+                                                    const Dictionary::code_type& code) const
+    {
+        if (code >= dictionarySize(n)) {
+            throw "ERROR [OccupancySnapshot::dictionaryValue] Code out of range";
+        }
+
+        const std::uint64_t* offsets = section<std::uint64_t>(6 + 3*n);
+        const char* values           = section<char>(7 + 3*n);
+
+        return std::string(values + offsets[code], values + offsets[code+1]);
+    }
+
+    // =========================================================================
+    //
+    //  Public methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                      open
+
+    bool OccupancySnapshot::open (const std::string& filename)
+    {
+        close();
+
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd == -1) {
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && std::size_t(info.st_size) >= sizeof(Header)) {
+            void* mapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                itsMapping    = static_cast<const char*>(mapping);
+                itsMappedSize = info.st_size;
+            }
+        }
+        ::close(fd);
+
+        if (itsMapping == NULL) {
+            return false;
+        }
+
+        // Check the header ...
+        const Header& head = header();
+        bool valid = std::memcmp(head.magic, snapshotMagic, sizeof(snapshotMagic)) == 0
+            && head.version == version
+            && head.byteOrder == byteOrderMarker
+            && head.fileSize == itsMappedSize
+            && head.nofSections == 5 + 3*head.nofColumns
+            && sizeof(Header) + head.nofSections*sizeof(Section) <= itsMappedSize;
+
+        // ... and the location and size of the sections
+        std::vector<std::uint64_t> expected;
+        if (valid) {
+            expected.push_back(head.nofEntries*sizeof(std::int64_t));
+            expected.push_back(head.nofEntries*sizeof(std::int64_t));
+            expected.push_back(head.nofSteps*sizeof(std::int64_t));
+            expected.push_back(head.nofSteps*sizeof(int));
+            expected.push_back(2*OccupancyProfile::nofLeaves(head.nofSteps)*sizeof(int));
+        }
+
+        const Section* sections = reinterpret_cast<const Section*>(itsMapping + sizeof(Header));
+        for (std::size_t n=0; valid && n<head.nofSections; ++n) {
+            valid = sections[n].offset % 8 == 0
+                && sections[n].offset <= itsMappedSize
+                && sections[n].size <= itsMappedSize - sections[n].offset;
+            if (valid && n < expected.size()) {
+                valid = sections[n].size == expected[n];
+            } else if (valid && (n-5)%3 == 0) {
+                valid = sections[n].size == head.nofEntries*sizeof(Dictionary::code_type);
+            } else if (valid && (n-5)%3 == 1) {
+                // offsets into the values, ascending and ending with their size
+                const std::uint64_t* offsets = section<std::uint64_t>(n);
+                std::size_t count            = sections[n].size/sizeof(std::uint64_t);
+                valid = count > 0 && offsets[0] == 0
+                    && n+1 < head.nofSections
+                    && offsets[count-1] == sections[n+1].size;
+                for (std::size_t k=1; valid && k<count; ++k) {
+                    valid = offsets[k-1] <= offsets[k];
+                }
+            }
+        }
+
+        if (!valid) {
+            close();
+            return false;
+        }
+
+        itsProfile = OccupancyProfile(section<std::int64_t>(2),
+                                      section<int>(3),
+                                      head.nofSteps,
+                                      section<int>(4));
+
+        return true;
+    }
+
+    //__________________________________________________________________________
+    //                                                                     close
+
+    void OccupancySnapshot::close ()
+    {
+        itsProfile = OccupancyProfile();
+
+        if (itsMapping != NULL) {
+            munmap(const_cast<char*>(itsMapping), itsMappedSize);
+            itsMapping    = NULL;
+            itsMappedSize = 0;
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                              rangeOfTimes
+
+    std::pair<std::int64_t,std::int64_t> OccupancySnapshot::rangeOfTimes () const
+    {
+        return std::make_pair(header().firstEntry, header().lastExit);
+    }
+
+    //__________________________________________________________________________
+    //                                                                 isCurrent
+
+    bool OccupancySnapshot::isCurrent (const std::string& source,
+                                       const TimeWindow& window,
+                                       const std::int64_t& ticksPerSecond) const
+    {
+        Header expected = Header();
+        if (!isOpen() || !describeSource(source, window, expected)) {
+            return false;
+        }
+
+        const Header& head = header();
+        return head.sourceSize == expected.sourceSize
+            && head.sourceModified == expected.sourceModified
+            && head.reference == expected.reference
+            && head.windowBegin == expected.windowBegin
+            && head.windowEnd == expected.windowEnd
+            && head.ticksPerSecond == ticksPerSecond;
+    }
+
+    // =========================================================================
+    //
+    //  Private methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                            describeSource
+
+    bool OccupancySnapshot::describeSource (const std::string& source,
+                                            const TimeWindow& window,
+                                            Header& header)
+    {
+        if (!fileStatus(source, header.sourceSize, header.sourceModified)) {
+            return false;
+        }
+
+        std::memcpy(header.magic, snapshotMagic, sizeof(snapshotMagic));
+        header.version     = version;
+        header.byteOrder   = byteOrderMarker;
+        header.reference   = LogEntryView::startOfDay();
+        header.windowBegin = window.begin();
+        header.windowEnd   = window.end();
+
+        return true;
+    }
+
+    //__________________________________________________________________________
+    //                                                                 writeFile
+
+    bool OccupancySnapshot::writeFile (const std::string& filename,
+                                       Header& header,
+                                       const std::vector<std::pair<const void*,std::size_t> >& sections)
+    {
+        // Place the sections one after the other, aligned to 8 bytes
+        std::vector<Section> table (sections.size());
+        std::uint64_t offset = aligned(sizeof(Header) + sections.size()*sizeof(Section));
+        for (std::size_t n=0; n<sections.size(); ++n) {
+            table[n].offset = offset;
+            table[n].size   = sections[n].second;
+            offset          = aligned(offset + table[n].size);
+        }
+        header.nofSections = sections.size();
+        header.fileSize    = offset;
+
+        std::string tmpname = filename + ".tmp";
+        std::ofstream outfile (tmpname.c_str(), std::ios::binary | std::ios::trunc);
+        if (!outfile.is_open()) {
+            std::cerr << "Error opening: " << tmpname << "\n";
+            return false;
+        }
+
+        const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        outfile.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        outfile.write(reinterpret_cast<const char*>(table.data()), table.size()*sizeof(Section));
+        std::uint64_t position = sizeof(Header) + table.size()*sizeof(Section);
+
+        for (std::size_t n=0; n<sections.size(); ++n) {
+            outfile.write(padding, table[n].offset - position);
+            outfile.write(static_cast<const char*>(sections[n].first), sections[n].second);
+            position = table[n].offset + table[n].size;
+        }
+        outfile.write(padding, header.fileSize - position);
+        outfile.close();
+
+        if (!outfile || std::rename(tmpname.c_str(), filename.c_str()) != 0) {
+            std::remove(tmpname.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+}  //  namespace cgi -- END
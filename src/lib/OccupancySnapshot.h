@@ -0,0 +1,303 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_OCCUPANCYSNAPSHOT_H
+#define CGI_OCCUPANCYSNAPSHOT_H
+
+/*!
+ * \file OccupancySnapshot.h
+ * \brief Class for a memory mapped snapshot of log data and occupancy index
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Dictionary.h"
+#include "LogData.h"
+#include "OccupancyProfile.h"
+#include "TimeWindow.h"
+
+namespace cgi {
+
+    /*!
+     * \class OccupancySnapshot
+     * \brief Memory mapped snapshot of log data and their occupancy index
+     * \test test_OccupancySnapshot.cc
+     *
+     * A snapshot holds the times of entry and exit of a cgi::BasicLogData
+     * object, its additional columns (codes and dictionaries) and the
+     * cgi::OccupancyProfile built from it, in a single binary file. All arrays
+     * are stored at (8-byte aligned) offsets from the start of the file, such
+     * that the file is position independent: open() maps it read-only and the
+     * arrays are used in place -- the profile returned by profile() refers to
+     * the mapping -- hence opening takes the same time irrespective of the
+     * size of the log.
+     *
+     * Along with a format version, the header records the log file the
+     * snapshot has been taken from (size and modification time), the time
+     * window applied while reading it, the resolution of the clock and the
+     * start of the day to which times of day were referring; isCurrent()
+     * compares those against the log, so an outdated snapshot can be detected
+     * and replaced. Numbers are stored in the byte order of the host; snapshots
+     * from a host of different byte order are rejected.
+     */
+    class OccupancySnapshot {
+
+    public:
+
+        /// Version of the file format
+        static const std::uint32_t version = 1;
+
+        /*!
+         * \struct Header
+         * \brief Header at the start of a snapshot file
+         */
+        struct Header {
+            /// Identifier of the file format
+            char magic[8];
+            /// Version of the file format
+            std::uint32_t version;
+            /// Marker for the byte order of the host writing the file
+            std::uint32_t byteOrder;
+            /// Resolution of the clock (ticks per second)
+            std::int64_t ticksPerSecond;
+            /// Start of the day, to which times of day were referring
+            std::int64_t reference;
+            /// Size of the log file
+            std::int64_t sourceSize;
+            /// Modification time of the log file (nanoseconds since the epoch)
+            std::int64_t sourceModified;
+            /// Begin of the time window applied while reading the log
+            std::int64_t windowBegin;
+            /// End of the time window applied while reading the log
+            std::int64_t windowEnd;
+            /// Time of the first entry (ticks)
+            std::int64_t firstEntry;
+            /// Time of the last exit (ticks)
+            std::int64_t lastExit;
+            /// Number of log entries
+            std::uint64_t nofEntries;
+            /// Number of steps of the occupancy profile
+            std::uint64_t nofSteps;
+            /// Number of additional columns
+            std::uint64_t nofColumns;
+            /// Number of sections, following the header
+            std::uint64_t nofSections;
+            /// Size of the file (in bytes)
+            std::uint64_t fileSize;
+        };
+
+        /*!
+         * \struct Section
+         * \brief Location of an array within a snapshot file
+         */
+        struct Section {
+            /// Offset (in bytes) from the start of the file
+            std::uint64_t offset;
+            /// Size (in bytes)
+            std::uint64_t size;
+        };
+
+    private:
+
+        /// Pointer to the start of the memory mapping
+        const char* itsMapping;
+        /// Size of the memory mapping
+        std::size_t itsMappedSize;
+        /// Occupancy profile, referring to the mapping
+        OccupancyProfile itsProfile;
+
+        /// Get the header of the mapped file
+        inline const Header& header () const {
+            return *reinterpret_cast<const Header*>(itsMapping);
+        }
+
+        /// Get pointer to the start of section `n`
+        template <typename T>
+        inline const T* section (const std::size_t& n) const {
+            const Section* sections = reinterpret_cast<const Section*>(itsMapping + sizeof(Header));
+            return reinterpret_cast<const T*>(itsMapping + sections[n].offset);
+        }
+
+        /// Write the header and sections to `filename`
+        static bool writeFile (const std::string& filename,
+                               Header& header,
+                               const std::vector<std::pair<const void*,std::size_t> >& sections);
+
+        /// Fill in the parts of the header describing the log file
+        static bool describeSource (const std::string& source,
+                                    const TimeWindow& window,
+                                    Header& header);
+
+    public:
+
+        // === Construction ====================================================
+
+        /// Default constructor
+        OccupancySnapshot ();
+
+        /*!
+         * \brief Argumented constructor
+         * \param filename -- Name of the snapshot file to open.
+         */
+        explicit OccupancySnapshot (const std::string& filename);
+
+        /// Destructor
+        ~OccupancySnapshot ();
+
+        // === Parameter access ================================================
+
+        /// Has a snapshot been opened?
+        inline bool isOpen () const {
+            return itsMapping != NULL;
+        }
+
+        /// Get the resolution of the clock (ticks per second)
+        inline std::int64_t ticksPerSecond () const {
+            return header().ticksPerSecond;
+        }
+
+        /// Get the time window applied while reading the log
+        inline TimeWindow timeWindow () const {
+            return TimeWindow(header().windowBegin, header().windowEnd);
+        }
+
+        /// Get the number of log entries
+        inline std::size_t size () const {
+            return header().nofEntries;
+        }
+
+        /// Get the times of entry, sorted in ascending order
+        inline const std::int64_t* timesEntry () const {
+            return section<std::int64_t>(0);
+        }
+
+        /// Get the times of exit, in the order of the times of entry
+        inline const std::int64_t* timesExit () const {
+            return section<std::int64_t>(1);
+        }
+
+        /// Get the occupancy profile, referring to the mapped data
+        inline const OccupancyProfile& profile () const {
+            return itsProfile;
+        }
+
+        /// Get the number of additional columns
+        inline std::size_t nofColumns () const {
+            return header().nofColumns;
+        }
+
+        /// Get the codes of the additional column `n`, see cgi::LogData::column()
+        inline const Dictionary::code_type* column (const std::size_t& n) const {
+            return section<Dictionary::code_type>(5 + 3*n);
+        }
+
+        /// Get the number of values in the dictionary of column `n`
+        std::size_t dictionarySize (const std::size_t& n) const;
+
+        /// Get the value with code `code` in the dictionary of column `n`
+        std::string dictionaryValue (const std::size_t& n,
+                                     const Dictionary::code_type& code) const;
+
+        // === Public methods ==================================================
+
+        /*!
+         * \brief Map a snapshot file
+         * \param filename -- Name of the snapshot file.
+         * \return Is the file a valid snapshot of the current format version?
+         */
+        bool open (const std::string& filename);
+
+        /// Release the mapping of the snapshot file
+        void close ();
+
+        /// Get the range of times (first entry, last exit), in ticks
+        std::pair<std::int64_t,std::int64_t> rangeOfTimes () const;
+
+        /*!
+         * \brief Is the snapshot up to date with respect to a log file?
+         * \param source -- Name of the log file.
+         * \param window -- Time window applied while reading the log.
+         * \param ticksPerSecond -- Resolution of the clock.
+         */
+        bool isCurrent (const std::string& source,
+                        const TimeWindow& window=TimeWindow(),
+                        const std::int64_t& ticksPerSecond=1) const;
+
+        // === Public static methods ===========================================
+
+        /*!
+         * \brief Write a snapshot of log data and their occupancy profile
+         * \param filename -- Name of the snapshot file.
+         * \param source   -- Name of the log file the data have been read from.
+         * \param data     -- Log data, read with time window `window`.
+         * \param profile  -- Occupancy profile built from `data`.
+         * \param window   -- Time window applied while reading the log.
+         * \return Could the snapshot be written?
+         *
+         * The file is written under a temporary name and renamed once complete,
+         * such that readers never map a partially written snapshot.
+         */
+        template <typename Record, typename Clock>
+        static bool write (const std::string& filename,
+                           const std::string& source,
+                           const BasicLogData<Record,Clock>& data,
+                           const OccupancyProfile& profile,
+                           const TimeWindow& window=TimeWindow()) {
+            Header header = Header();
+            if (!describeSource(source, window, header)) {
+                return false;
+            }
+            header.ticksPerSecond = Clock::ticksPerSecond;
+            header.nofEntries     = data.size();
+            header.nofSteps       = profile.size();
+            header.nofColumns     = data.nofColumns();
+            if (!data.empty()) {
+                header.firstEntry = data.timesEntry().front();
+                header.lastExit   = *std::max_element(data.timesExit().begin(), data.timesExit().end());
+            }
+
+            std::vector<std::pair<const void*,std::size_t> > sections;
+            sections.push_back(std::make_pair(data.timesEntry().data(), data.size()*sizeof(std::int64_t)));
+            sections.push_back(std::make_pair(data.timesExit().data(), data.size()*sizeof(std::int64_t)));
+            sections.push_back(std::make_pair(profile.times(), profile.size()*sizeof(std::int64_t)));
+            sections.push_back(std::make_pair(profile.counts(), profile.size()*sizeof(int)));
+            sections.push_back(std::make_pair(profile.tree(), profile.treeSize()*sizeof(int)));
+
+            // Dictionaries as concatenated values, delimited by offsets
+            std::vector<std::vector<std::uint64_t> > offsets (data.nofColumns());
+            std::vector<std::string> values (data.nofColumns());
+            for (std::size_t n=0; n<data.nofColumns(); ++n) {
+                const Dictionary& dictionary = data.dictionary(n);
+                offsets[n].push_back(0);
+                for (std::size_t code=0; code<dictionary.size(); ++code) {
+                    values[n] += dictionary[code];
+                    offsets[n].push_back(values[n].size());
+                }
+                sections.push_back(std::make_pair(data.column(n).data(),
+                                                  data.size()*sizeof(Dictionary::code_type)));
+                sections.push_back(std::make_pair(offsets[n].data(),
+                                                  offsets[n].size()*sizeof(std::uint64_t)));
+                sections.push_back(std::make_pair(values[n].data(), values[n].size()));
+            }
+
+            return writeFile(filename, header, sections);
+        }
+
+    private:
+
+        // Objects of this type hold on to a memory mapping
+        OccupancySnapshot (const OccupancySnapshot&);
+        OccupancySnapshot& operator= (const OccupancySnapshot&);
+
+    };  //  class OccupancySnapshot -- END
+
+}  //  namespace cgi -- END
+
+#endif
@@ -0,0 +1,162 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <string>
+
+#include "OccupancySweep.h"
+
+namespace cgi {
+
+    /// Identifier at the start of a saved sweep, including format version
+    static const char occupancySweepMagic[] = "CGISWEEP 1";
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    OccupancySweep::OccupancySweep (const bool& recordTimeline)
+        : itsRecordTimeline(recordTimeline),
+          itsActive(false),
+          itsTime(0),
+          itsCount(0),
+          itsMax(0),
+          itsBins(NULL)
+    {
+    }
+
+    // =========================================================================
+    //
+    //  Public methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                       add
+
+    void OccupancySweep::add (const Event& event)
+    {
+        if (itsActive && event.time() != itsTime) {
+            closeStep(event.time());
+        }
+
+        itsTime    = event.time();
+        itsCount  += event.delta();
+        itsActive  = true;
+    }
+
+    //__________________________________________________________________________
+    //                                                                    finish
+
+    void OccupancySweep::finish ()
+    {
+        if (itsActive && itsRecordTimeline) {
+            itsTimeline.push_back(TimePoint(DateTime(std::time_t(itsTime)), itsCount));
+        }
+        itsActive = false;
+    }
+
+    //__________________________________________________________________________
+    //                                                                     write
+
+    void OccupancySweep::write (std::ostream& os) const
+    {
+        os << occupancySweepMagic << "\n"
+           << "max " << itsMax << "\n"
+           << "timeline " << itsTimeline.size() << "\n";
+
+        for (auto it=itsTimeline.begin(); it!=itsTimeline.end(); ++it) {
+            os << it->time().rawtime() << " " << it->count() << "\n";
+        }
+
+        os << "intervals " << itsMaxIntervals.size() << "\n";
+
+        for (auto it=itsMaxIntervals.begin(); it!=itsMaxIntervals.end(); ++it) {
+            os << it->begin().rawtime() << " " << it->end().rawtime() << "\n";
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                                      read
+
+    OccupancySweep OccupancySweep::read (std::istream& is)
+    {
+        std::string magic;
+        std::getline(is, magic);
+        if (magic != occupancySweepMagic) {
+            throw "ERROR [OccupancySweep::read] Unrecognized format";
+        }
+
+        std::string key[2];
+        std::size_t size = 0;
+        OccupancySweep result;
+
+        is >> key[0] >> result.itsMax >> key[1] >> size;
+        if (!is || key[0] != "max" || key[1] != "timeline") {
+            throw "ERROR [OccupancySweep::read] Malformed header";
+        }
+
+        std::int64_t begin = 0;
+        std::int64_t end   = 0;
+        int count          = 0;
+
+        // The size is not trusted for reserving memory; the stream may be corrupted
+        for (std::size_t n=0; n<size; ++n) {
+            if (!(is >> begin >> count)) {
+                throw "ERROR [OccupancySweep::read] Truncated timeline";
+            }
+            result.itsTimeline.push_back(TimePoint(DateTime(std::time_t(begin)), count));
+        }
+
+        is >> key[0] >> size;
+        if (!is || key[0] != "intervals") {
+            throw "ERROR [OccupancySweep::read] Malformed list of intervals";
+        }
+
+        for (std::size_t n=0; n<size; ++n) {
+            if (!(is >> begin >> end)) {
+                throw "ERROR [OccupancySweep::read] Truncated list of intervals";
+            }
+            result.itsMaxIntervals.insert(DateTime(std::time_t(begin)),
+                                          DateTime(std::time_t(end)),
+                                          result.itsMax);
+        }
+
+        return result;
+    }
+
+    // =========================================================================
+    //
+    //  Private methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                 closeStep
+
+    void OccupancySweep::closeStep (const std::int64_t& next)
+    {
+        if (itsRecordTimeline) {
+            itsTimeline.push_back(TimePoint(DateTime(std::time_t(itsTime)), itsCount));
+        }
+
+        if (itsBins != NULL) {
+            itsBins->add(itsTime, next, itsCount);
+        }
+
+        if (itsCount > itsMax) {
+            itsMax = itsCount;
+            itsMaxIntervals.clear();
+        }
+
+        if (itsCount == itsMax && itsCount > 0) {
+            itsMaxIntervals.insert(DateTime(std::time_t(itsTime)),
+                                   DateTime(std::time_t(next)),
+                                   itsCount);
+        }
+    }
+
+}  //  namespace cgi -- END
@@ -0,0 +1,128 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_OCCUPANCYSWEEP_H
+#define CGI_OCCUPANCYSWEEP_H
+
+/*!
+ * \file OccupancySweep.h
+ * \brief Class for the sweep along a time-ordered stream of events
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "DateTime.h"
+#include "Event.h"
+#include "Interval.h"
+#include "IntervalSet.h"
+#include "OccupancyBins.h"
+#include "TimePoint.h"
+
+namespace cgi {
+
+    /*!
+     * \class OccupancySweep
+     * \brief Sweep along a time-ordered stream of events
+     * \test test_OccupancySweep.cc
+     *
+     * Events are fed one by one -- in the order defined by cgi::Event -- while
+     * the sweep keeps track of the current number of visitors. Once all events
+     * for a given point in time have been seen, the number of visitors from
+     * that point in time onwards is known; this is recorded into the timeline
+     * (optional) and used to keep track of the time intervals during which the
+     * maximum number of visitors is reached. Since the sweep only requires
+     * a single event at a time, it can be driven from an in-memory list as well
+     * as from a merge of sorted runs kept on disk (see cgi::ExternalSort).
+     *
+     * The outcome of a sweep can be saved as text (see write() and read()),
+     * e.g. in order to keep it in a cgi::ResultCache.
+     */
+    class OccupancySweep {
+
+        /// Record the number of visitors per point in time?
+        bool itsRecordTimeline;
+        /// Has the sweep seen any events yet?
+        bool itsActive;
+        /// Point in time for which events currently are accumulated
+        std::int64_t itsTime;
+        /// Current number of visitors
+        int itsCount;
+        /// Maximum number of visitors
+        int itsMax;
+        /// Number of visitors per point in time
+        std::vector<TimePoint> itsTimeline;
+        /// Time intervals during which the maximum number of visitors is reached
+        IntervalSet<DateTime,int> itsMaxIntervals;
+        /// Time bins to which the steps are added as well (not owned)
+        OccupancyBins* itsBins;
+
+        /// Close the step of the occupancy function starting at `itsTime`
+        void closeStep (const std::int64_t& next);
+
+    public:
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param recordTimeline -- Record the number of visitors per point in time?
+         */
+        OccupancySweep (const bool& recordTimeline=true);
+
+        // === Parameter access ================================================
+
+        /// Get the number of visitors per point in time
+        inline const std::vector<TimePoint>& timeline () const {
+            return itsTimeline;
+        }
+
+        /*!
+         * \brief Get the time intervals during which the maximum is reached
+         *
+         * Adjacent intervals -- e.g. a plateau during which visitors enter and
+         * leave at the same time -- are merged into a single interval.
+         */
+        inline const IntervalSet<DateTime,int>& maxIntervals () const {
+            return itsMaxIntervals;
+        }
+
+        /// Get the maximum number of visitors
+        inline int maxNofVisitors () const {
+            return itsMax;
+        }
+
+        /*!
+         * \brief Add the steps to time bins as well, while sweeping the events
+         * \param bins -- Time bins, required to outlive the sweep; `NULL` to stop
+         *        adding steps.
+         */
+        inline void setBins (OccupancyBins* bins) {
+            itsBins = bins;
+        }
+
+        // === Public methods ==================================================
+
+        /*!
+         * \brief Add the next event to the sweep
+         * \param event -- Event to add; events are required to be added in order.
+         */
+        void add (const Event& event);
+
+        /// Signal the end of the event stream
+        void finish ();
+
+        /// Write the timeline and maximum intervals of a finished sweep to `os`
+        void write (std::ostream& os) const;
+
+        /// Read a finished sweep, as written by write(), from `is`
+        static OccupancySweep read (std::istream& is);
+
+    };  //  class OccupancySweep -- END
+
+}  //  namespace cgi -- END
+
+#endif
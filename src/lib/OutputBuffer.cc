@@ -0,0 +1,177 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <cerrno>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "OutputBuffer.h"
+
+namespace cgi {
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                              OutputBuffer
+
+    OutputBuffer::OutputBuffer (const int& fd,
+                                const std::size_t& capacity)
+        : itsFd(fd),
+          itsBuffer(capacity > 0 ? capacity : 1),
+          itsSize(0),
+          itsBytesWritten(0),
+          itsFailed(false)
+    {
+    }
+
+    //__________________________________________________________________________
+    //                                                             ~OutputBuffer
+
+    OutputBuffer::~OutputBuffer ()
+    {
+        flush();
+    }
+
+    // =========================================================================
+    //
+    //  Public methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                  writeInt
+
+    void OutputBuffer::writeInt (const std::int64_t& value)
+    {
+        char digits[24];
+        char* end = digits + sizeof(digits);
+        char* it  = end;
+
+        // work on the magnitude as unsigned, such that the minimum is covered
+        std::uint64_t magnitude = value < 0 ? 0 - std::uint64_t(value) : std::uint64_t(value);
+        do {
+            *--it = char('0' + magnitude%10);
+            magnitude /= 10;
+        } while (magnitude > 0);
+
+        if (value < 0) {
+            *--it = '-';
+        }
+
+        write(it, end-it);
+    }
+
+    //__________________________________________________________________________
+    //                                                                writeFixed
+
+    void OutputBuffer::writeFixed (const double& value,
+                                   const int& digits)
+    {
+        std::int64_t scale = 1;
+        for (int n=0; n<digits; ++n) {
+            scale *= 10;
+        }
+
+        // round to the last decimal, then split into integral part and fraction
+        double magnitude    = value < 0 ? -value : value;
+        std::int64_t scaled = std::int64_t(magnitude*scale + 0.5);
+
+        if (value < 0 && scaled > 0) {
+            put('-');
+        }
+        writeInt(scaled/scale);
+
+        if (digits > 0) {
+            char fraction[20];
+            std::int64_t rest = scaled%scale;
+            for (int n=digits-1; n>=0; --n) {
+                fraction[n] = char('0' + rest%10);
+                rest /= 10;
+            }
+            put('.');
+            write(fraction, digits);
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                                writeLarge
+
+    void OutputBuffer::writeLarge (const char* data,
+                                   const std::size_t& size)
+    {
+        if (size < itsBuffer.size()) {
+            // fits after flushing the buffer
+            flush();
+            write(data, size);
+        } else {
+            const char* blocks[2] = { itsBuffer.data(), data };
+            std::size_t sizes[2]  = { itsSize, size };
+            writeBlocks(blocks, sizes, 2);
+            itsSize = 0;
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                                     flush
+
+    void OutputBuffer::flush ()
+    {
+        if (itsSize > 0) {
+            const char* blocks[1] = { itsBuffer.data() };
+            std::size_t sizes[1]  = { itsSize };
+            writeBlocks(blocks, sizes, 1);
+            itsSize = 0;
+        }
+    }
+
+    // =========================================================================
+    //
+    //  Private methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                               writeBlocks
+
+    void OutputBuffer::writeBlocks (const char* data[],
+                                    std::size_t size[],
+                                    int count)
+    {
+        struct iovec blocks[2];
+        for (int n=0; n<count; ++n) {
+            blocks[n].iov_base = const_cast<char*>(data[n]);
+            blocks[n].iov_len  = size[n];
+        }
+
+        struct iovec* first = blocks;
+        while (count > 0 && !itsFailed) {
+            ssize_t written = writev(itsFd, first, count);
+            if (written < 0) {
+                if (errno != EINTR) {
+                    itsFailed = true;
+                }
+                continue;
+            }
+            itsBytesWritten += written;
+
+            // skip the blocks written completely, continue within a partial one
+            std::size_t remaining = written;
+            while (count > 0 && remaining >= first->iov_len) {
+                remaining -= first->iov_len;
+                ++first;
+                --count;
+            }
+            if (count > 0) {
+                first->iov_base = static_cast<char*>(first->iov_base) + remaining;
+                first->iov_len -= remaining;
+            }
+        }
+    }
+
+}  //  namespace cgi -- END
@@ -0,0 +1,154 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_OUTPUTBUFFER_H
+#define CGI_OUTPUTBUFFER_H
+
+/*!
+ * \file OutputBuffer.h
+ * \brief Class for buffered output to a file descriptor
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace cgi {
+
+    /*!
+     * \class OutputBuffer
+     * \brief Buffered output to a file descriptor, without flushing per row
+     * \test test_OutputBuffer.cc
+     *
+     * As opposed to writing to ``std::cout`` with ``std::endl`` -- which flushes
+     * the stream after each line -- all output is collected in a single buffer
+     * of capacity() bytes, which is only handed to the operating system once it
+     * is full, when calling flush(), or when the object is destroyed. Blocks
+     * larger than the remaining space (e.g. a raw array of a binary timeline)
+     * are not copied into the buffer, but written together with its contents
+     * by a single call of ``writev``.
+     *
+     * Integers are formatted directly into the buffer, without going through
+     * a ``std::ostream`` or any intermediate strings.
+     */
+    class OutputBuffer {
+
+        /// File descriptor to write to
+        int itsFd;
+        /// Buffer collecting the output
+        std::vector<char> itsBuffer;
+        /// Number of bytes in use within the buffer
+        std::size_t itsSize;
+        /// Number of bytes written to the file descriptor
+        std::uint64_t itsBytesWritten;
+        /// Has any write to the file descriptor failed?
+        bool itsFailed;
+
+        /// Write `count` blocks to the file descriptor, handling partial writes
+        void writeBlocks (const char* data[],
+                          std::size_t size[],
+                          int count);
+
+    public:
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param fd       -- File descriptor to write to, e.g. ``1`` for the
+         *        standard output; not closed by the object.
+         * \param capacity -- Capacity of the buffer (in bytes).
+         */
+        OutputBuffer (const int& fd=1,
+                      const std::size_t& capacity=1024*1024);
+
+        /// Destructor, flushing the remaining output
+        ~OutputBuffer ();
+
+        // === Parameter access ================================================
+
+        /// Get the file descriptor written to
+        inline int fd () const {
+            return itsFd;
+        }
+
+        /// Get the capacity of the buffer (in bytes)
+        inline std::size_t capacity () const {
+            return itsBuffer.size();
+        }
+
+        /// Get the number of bytes waiting in the buffer
+        inline std::size_t size () const {
+            return itsSize;
+        }
+
+        /// Get the number of bytes written to the file descriptor so far
+        inline std::uint64_t bytesWritten () const {
+            return itsBytesWritten;
+        }
+
+        /// Have all writes to the file descriptor succeeded so far?
+        inline bool good () const {
+            return !itsFailed;
+        }
+
+        // === Public methods ==================================================
+
+        /// Append `size` bytes starting at `data`
+        inline void write (const char* data,
+                           const std::size_t& size) {
+            if (itsSize + size <= itsBuffer.size()) {
+                std::memcpy(itsBuffer.data() + itsSize, data, size);
+                itsSize += size;
+            } else {
+                writeLarge(data, size);
+            }
+        }
+
+        /// Append a single character
+        inline void put (const char& c) {
+            if (itsSize == itsBuffer.size()) {
+                flush();
+            }
+            itsBuffer[itsSize++] = c;
+        }
+
+        /// Append a string
+        inline void write (const std::string& str) {
+            write(str.data(), str.size());
+        }
+
+        /// Append a null-terminated string
+        inline void write (const char* str) {
+            write(str, std::strlen(str));
+        }
+
+        /// Append the decimal representation of an integer
+        void writeInt (const std::int64_t& value);
+
+        /// Append the decimal representation of a number, with `digits` decimals
+        void writeFixed (const double& value,
+                         const int& digits=2);
+
+        /// Append a block of bytes too large for the remaining space
+        void writeLarge (const char* data,
+                         const std::size_t& size);
+
+        /// Hand the contents of the buffer to the operating system
+        void flush ();
+
+    private:
+
+        // Objects of this type hold on to unwritten output
+        OutputBuffer (const OutputBuffer&);
+        OutputBuffer& operator= (const OutputBuffer&);
+
+    };  //  class OutputBuffer -- END
+
+}  //  namespace cgi -- END
+
+#endif
@@ -0,0 +1,264 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <limits>
+
+#include "PartialAggregate.h"
+
+namespace cgi {
+
+    /// Header line identifying the serialization format
+    static const char* partialAggregateMagic = "CGIPARTIAL 1";
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                          PartialAggregate
+
+    PartialAggregate::PartialAggregate (const TimeWindow& window)
+        : itsWindow(window),
+          itsStartCount(0),
+          itsNetDelta(0),
+          itsPeak(std::numeric_limits<int>::min()),
+          itsActive(window.hasBegin()),
+          itsTime(window.begin())
+    {
+    }
+
+    // =========================================================================
+    //
+    //  Operator overloading
+    //
+    // =========================================================================
+
+    std::ostream& operator<< (std::ostream& os, const PartialAggregate& rhs)
+    {
+        os << "[" << rhs.itsWindow.begin() << "," << rhs.itsWindow.end() << ") start = " << rhs.itsStartCount
+           << ", delta = " << rhs.itsNetDelta
+           << ", peak = " << rhs.peak()
+           << ", intervals = " << rhs.itsPeakIntervals.size();
+
+        return os;
+    }
+
+    // =========================================================================
+    //
+    //  Parameter access
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                              maxIntervals
+
+    IntervalSet<std::int64_t,int> PartialAggregate::maxIntervals () const
+    {
+        IntervalSet<std::int64_t,int> result;
+        int visitors = maxNofVisitors();
+
+        if (visitors > 0) {
+            for (auto it=itsPeakIntervals.begin(); it!=itsPeakIntervals.end(); ++it) {
+                result.insert(it->begin(), it->end(), visitors);
+            }
+        }
+
+        return result;
+    }
+
+    // =========================================================================
+    //
+    //  Public methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                       add
+
+    void PartialAggregate::add (const Event& event)
+    {
+        std::int64_t time = event.time();
+
+        if (time < itsWindow.begin()) {
+            // before the shard: contributes to the boundary occupancy
+            itsStartCount += event.delta();
+        } else if (time < itsWindow.end()) {
+            if (itsActive && time != itsTime) {
+                closeStep(time);
+            }
+            itsTime      = time;
+            itsNetDelta += event.delta();
+            itsActive    = true;
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                                    finish
+
+    void PartialAggregate::finish ()
+    {
+        if (itsActive && itsWindow.hasEnd()) {
+            closeStep(itsWindow.end());
+        }
+        itsActive = false;
+    }
+
+    //__________________________________________________________________________
+    //                                                                     merge
+
+    void PartialAggregate::merge (const PartialAggregate& next)
+    {
+        if (itsWindow.end() != next.itsWindow.begin()) {
+            throw "ERROR [PartialAggregate::merge] Time shards are not adjacent";
+        }
+        if (itsStartCount + itsNetDelta != next.itsStartCount) {
+            throw "ERROR [PartialAggregate::merge] Mismatch in boundary occupancy";
+        }
+
+        if (!next.itsPeakIntervals.empty()) {
+            // profile of the next shard, relative to the start of this one
+            int peak = itsNetDelta + next.itsPeak;
+
+            if (itsPeakIntervals.empty() || peak > itsPeak) {
+                itsPeak = peak;
+                itsPeakIntervals.clear();
+            }
+
+            if (peak == itsPeak) {
+                for (auto it=next.itsPeakIntervals.begin(); it!=next.itsPeakIntervals.end(); ++it) {
+                    itsPeakIntervals.insert(it->begin(), it->end(), peak);
+                }
+            }
+        }
+
+        itsWindow.setEnd(next.itsWindow.end());
+        itsNetDelta += next.itsNetDelta;
+    }
+
+    //__________________________________________________________________________
+    //                                                               inputWindow
+
+    TimeWindow PartialAggregate::inputWindow (const TimeWindow& shard)
+    {
+        TimeWindow result (shard);
+
+        if (shard.hasBegin()) {
+            result.setBegin(shard.begin()-1);
+        }
+
+        return result;
+    }
+
+    //__________________________________________________________________________
+    //                                                                     merge
+
+    PartialAggregate PartialAggregate::merge (std::vector<PartialAggregate> shards)
+    {
+        if (shards.empty()) {
+            return PartialAggregate();
+        }
+
+        std::sort(shards.begin(), shards.end(),
+                  [] (const PartialAggregate& a, const PartialAggregate& b) {
+                      return a.itsWindow.begin() < b.itsWindow.begin()
+                          || (a.itsWindow.begin() == b.itsWindow.begin()
+                              && a.itsWindow.end() < b.itsWindow.end());
+                  });
+
+        PartialAggregate result = shards.front();
+        for (std::size_t n=1; n<shards.size(); ++n) {
+            result.merge(shards[n]);
+        }
+
+        return result;
+    }
+
+    //__________________________________________________________________________
+    //                                                                     write
+
+    void PartialAggregate::write (std::ostream& os) const
+    {
+        os << partialAggregateMagic << "\n"
+           << "window " << itsWindow.begin() << " " << itsWindow.end() << "\n"
+           << "start " << itsStartCount << "\n"
+           << "delta " << itsNetDelta << "\n"
+           << "peak " << peak() << "\n"
+           << "intervals " << itsPeakIntervals.size() << "\n";
+
+        for (auto it=itsPeakIntervals.begin(); it!=itsPeakIntervals.end(); ++it) {
+            os << it->begin() << " " << it->end() << "\n";
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                                      read
+
+    PartialAggregate PartialAggregate::read (std::istream& is)
+    {
+        std::string magic;
+        std::getline(is, magic);
+        if (magic != partialAggregateMagic) {
+            throw "ERROR [PartialAggregate::read] Unrecognized format";
+        }
+
+        std::string key[5];
+        std::int64_t begin    = 0;
+        std::int64_t end      = 0;
+        std::size_t intervals = 0;
+        PartialAggregate result;
+
+        is >> key[0] >> begin >> end
+           >> key[1] >> result.itsStartCount
+           >> key[2] >> result.itsNetDelta
+           >> key[3] >> result.itsPeak
+           >> key[4] >> intervals;
+
+        if (!is || key[0] != "window" || key[1] != "start" || key[2] != "delta"
+            || key[3] != "peak" || key[4] != "intervals") {
+            throw "ERROR [PartialAggregate::read] Malformed header";
+        }
+
+        result.itsWindow = TimeWindow(begin, end);
+        result.itsActive = false;
+
+        for (std::size_t n=0; n<intervals; ++n) {
+            if (!(is >> begin >> end)) {
+                throw "ERROR [PartialAggregate::read] Truncated list of intervals";
+            }
+            result.itsPeakIntervals.insert(begin, end, result.itsPeak);
+        }
+
+        return result;
+    }
+
+    // =========================================================================
+    //
+    //  Private methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                 closeStep
+
+    void PartialAggregate::closeStep (const std::int64_t& next)
+    {
+        if (!(itsTime < next)) {
+            return;
+        }
+
+        if (itsPeakIntervals.empty() || itsNetDelta > itsPeak) {
+            itsPeak = itsNetDelta;
+            itsPeakIntervals.clear();
+        }
+
+        if (itsNetDelta == itsPeak) {
+            itsPeakIntervals.insert(itsTime, next, itsNetDelta);
+        }
+    }
+
+}  //  namespace cgi -- END
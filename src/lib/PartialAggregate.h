@@ -0,0 +1,174 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_PARTIALAGGREGATE_H
+#define CGI_PARTIALAGGREGATE_H
+
+/*!
+ * \file PartialAggregate.h
+ * \brief Class for the mergeable occupancy statistics of a time shard
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Event.h"
+#include "IntervalSet.h"
+#include "TimeWindow.h"
+
+namespace cgi {
+
+    /*!
+     * \class PartialAggregate
+     * \brief Mergeable occupancy statistics for a time shard \f$ [begin, end) \f$
+     * \test test_PartialAggregate.cc
+     *
+     * The global maximum number of visitors cannot be obtained from the maxima
+     * of individual time shards, since the occupancy at the start of a shard
+     * depends on everything that happened before. A partial aggregate therefore
+     * records the occupancy of the shard relative to its start:
+     *
+     * \li the occupancy at the start of the shard (boundary occupancy),
+     * \li the net change in the number of visitors across the shard,
+     * \li the peak of the relative occupancy within the shard, along with the
+     *     time intervals during which the peak is reached.
+     *
+     * Partial aggregates of adjacent shards are merged by shifting the profile
+     * of the later shard by the net change of the earlier one (see merge()),
+     * which yields the partial aggregate of the combined shard; merging all
+     * shards of a log in order results in the exact global maximum and the
+     * corresponding time intervals. Shards may be computed independently -- in
+     * separate processes or on separate nodes -- from the log entries overlapping
+     * with the shard (see cgi::BasicLogData::partialAggregate()), and exchanged
+     * as compact text files (see write() and read()).
+     *
+     * Times are given in ticks of the clock used for the log data.
+     */
+    class PartialAggregate {
+
+        /// Time shard covered by the aggregate
+        TimeWindow itsWindow;
+        /// Number of visitors at the start of the shard
+        int itsStartCount;
+        /// Net change in the number of visitors across the shard
+        int itsNetDelta;
+        /// Peak of the occupancy relative to the start of the shard
+        int itsPeak;
+        /// Time intervals during which the peak is reached
+        IntervalSet<std::int64_t,int> itsPeakIntervals;
+        /// Is a step of the occupancy function currently open?
+        bool itsActive;
+        /// Start of the current step of the occupancy function
+        std::int64_t itsTime;
+
+        /// Close the step of the occupancy function starting at `itsTime`
+        void closeStep (const std::int64_t& next);
+
+    public:
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param window -- Time shard covered by the aggregate.
+         */
+        explicit PartialAggregate (const TimeWindow& window=TimeWindow());
+
+        // === Operator overloading ============================================
+
+        /// Overloading of output stream operator
+        friend std::ostream& operator<< (std::ostream& os, const PartialAggregate& rhs);
+
+        // === Parameter access ================================================
+
+        /// Get the time shard covered by the aggregate
+        inline const TimeWindow& window () const {
+            return itsWindow;
+        }
+
+        /// Get the number of visitors at the start of the shard
+        inline int startCount () const {
+            return itsStartCount;
+        }
+
+        /// Get the net change in the number of visitors across the shard
+        inline int netDelta () const {
+            return itsNetDelta;
+        }
+
+        /// Get the peak of the occupancy relative to the start of the shard
+        inline int peak () const {
+            return itsPeakIntervals.empty() ? 0 : itsPeak;
+        }
+
+        /// Get the time intervals during which the (relative) peak is reached
+        inline const IntervalSet<std::int64_t,int>& peakIntervals () const {
+            return itsPeakIntervals;
+        }
+
+        /// Get the maximum number of visitors within the shard
+        inline int maxNofVisitors () const {
+            return itsStartCount + peak();
+        }
+
+        /*!
+         * \brief Get the time intervals during which the maximum is reached
+         * \return Intervals with the (absolute) maximum number of visitors;
+         *         empty if there are no visitors at all.
+         */
+        IntervalSet<std::int64_t,int> maxIntervals () const;
+
+        // === Public methods ==================================================
+
+        /*!
+         * \brief Add the next event to the aggregate
+         * \param event -- Event to add; events are required to be added in
+         *        order. Events before the shard contribute to the boundary
+         *        occupancy, events after the shard are ignored.
+         */
+        void add (const Event& event);
+
+        /// Signal the end of the event stream
+        void finish ();
+
+        /*!
+         * \brief Merge with the aggregate of the subsequent shard
+         * \param next -- Aggregate of the shard starting where this one ends.
+         *
+         * If the boundary occupancy of `next` does not match the occupancy at
+         * the end of this shard, the shards have been computed from different
+         * data and an exception is thrown.
+         */
+        void merge (const PartialAggregate& next);
+
+        /*!
+         * \brief Get the time window covering the input required for a shard
+         * \param shard -- Time shard for which to compute the aggregate.
+         * \return Time window to use when reading the log data (see
+         *         cgi::BasicLogData::setTimeWindow()); besides the entries
+         *         overlapping with the shard this includes entries ending at its
+         *         begin, which are part of the boundary occupancy.
+         */
+        static TimeWindow inputWindow (const TimeWindow& shard);
+
+        /*!
+         * \brief Merge any number of aggregates into one
+         * \param shards -- Aggregates of contiguous shards, in any order.
+         */
+        static PartialAggregate merge (std::vector<PartialAggregate> shards);
+
+        /// Write the aggregate to `os`, in a compact text format
+        void write (std::ostream& os) const;
+
+        /// Read an aggregate, as written by write(), from `is`
+        static PartialAggregate read (std::istream& is);
+
+    };  //  class PartialAggregate -- END
+
+}  //  namespace cgi -- END
+
+#endif
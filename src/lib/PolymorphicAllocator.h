@@ -0,0 +1,98 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_POLYMORPHICALLOCATOR_H
+#define CGI_POLYMORPHICALLOCATOR_H
+
+/*!
+ * \file PolymorphicAllocator.h
+ * \brief Allocator obtaining its memory from a cgi::MemoryResource
+ */
+
+#include <cstddef>
+
+#include "MemoryResource.h"
+
+namespace cgi {
+
+    /*!
+     * \class PolymorphicAllocator
+     * \brief Allocator obtaining its memory from a cgi::MemoryResource
+     * \test test_PolymorphicAllocator.cc
+     *
+     * Modelled after ``std::pmr::polymorphic_allocator``; as for the latter,
+     * the resource is not propagated when a container is copied -- the copy
+     * uses newDeleteResource() -- such that a copy can safely outlive the
+     * resource of the original.
+     */
+    template <typename T>
+    class PolymorphicAllocator {
+
+        /// Resource from which memory is obtained
+        MemoryResource* itsResource;
+
+        template <typename U> friend class PolymorphicAllocator;
+
+    public:
+
+        typedef T value_type;
+
+        // === Construction ====================================================
+
+        /// Argumented constructor
+        PolymorphicAllocator (MemoryResource* resource=newDeleteResource())
+            : itsResource(resource) {}
+
+        /// Copy constructor for an allocator of different value type
+        template <typename U>
+        PolymorphicAllocator (const PolymorphicAllocator<U>& other)
+            : itsResource(other.itsResource) {}
+
+        // === Parameter access ================================================
+
+        /// Get the resource from which memory is obtained
+        inline MemoryResource* resource () const {
+            return itsResource;
+        }
+
+        // === Public methods ==================================================
+
+        /// Allocate storage for `n` objects of type `T`
+        T* allocate (std::size_t n) {
+            return static_cast<T*>(itsResource->allocate(n*sizeof(T), alignof(T)));
+        }
+
+        /// Deallocate storage for `n` objects of type `T`
+        void deallocate (T* p,
+                         std::size_t n) {
+            itsResource->deallocate(p, n*sizeof(T), alignof(T));
+        }
+
+        /// Allocator to use for the copy of a container
+        PolymorphicAllocator select_on_container_copy_construction () const {
+            return PolymorphicAllocator();
+        }
+
+    };  //  class PolymorphicAllocator -- END
+
+    /// Comparison operator
+    template <typename T, typename U>
+    inline bool operator== (const PolymorphicAllocator<T>& lhs,
+                            const PolymorphicAllocator<U>& rhs)
+    {
+        return lhs.resource()->isEqual(*rhs.resource());
+    }
+
+    /// Comparison operator
+    template <typename T, typename U>
+    inline bool operator!= (const PolymorphicAllocator<T>& lhs,
+                            const PolymorphicAllocator<U>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+}  //  namespace cgi -- END
+
+#endif
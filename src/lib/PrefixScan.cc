@@ -0,0 +1,284 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <limits>
+
+#include "PrefixScan.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CGI_PREFIXSCAN_X86
+#include <immintrin.h>
+#endif
+
+namespace cgi {
+
+    namespace {
+
+    /*!
+     * \brief Book-keeping of the maximum and the runs of slots reaching it
+     *
+     * The vectorized kernels only hand over blocks of slots containing a value
+     * at least as large as the current maximum, see block(); blocks entirely
+     * below the maximum merely terminate the current run, see below().
+     */
+    class MaxTracker {
+
+        /// Runs of slots during which the maximum is reached
+        IntervalSet<std::size_t,std::int32_t>& itsRuns;
+        /// Is a run currently open?
+        bool itsOpen;
+        /// First slot of the currently open run
+        std::size_t itsBegin;
+
+    public:
+
+        /// Current maximum
+        std::int32_t max;
+
+        /// Argumented constructor
+        MaxTracker (IntervalSet<std::size_t,std::int32_t>& runs)
+            : itsRuns(runs),
+              itsOpen(false),
+              itsBegin(0),
+              max(std::numeric_limits<std::int32_t>::min())
+        {
+            itsRuns.clear();
+        }
+
+        /// Is the maximum yet to be set?
+        inline bool empty () const {
+            return max == std::numeric_limits<std::int32_t>::min();
+        }
+
+        /// Update with the value of slot `n`
+        inline void update (const std::int32_t& value,
+                            const std::size_t& n) {
+            if (value > max) {
+                max = value;
+                itsRuns.clear();
+                itsBegin = n;
+                itsOpen  = true;
+            } else if (value == max) {
+                if (!itsOpen) {
+                    itsBegin = n;
+                    itsOpen  = true;
+                }
+            } else {
+                below(n);
+            }
+        }
+
+        /// Update with the `count` values of the slots starting at `first`
+        inline void block (const std::int32_t* values,
+                           const std::size_t& first,
+                           const std::size_t& count) {
+            for (std::size_t n=0; n<count; ++n) {
+                update(values[n], first+n);
+            }
+        }
+
+        /// Terminate the current run, if any, at slot `n`
+        inline void below (const std::size_t& n) {
+            if (itsOpen) {
+                itsRuns.insert(itsBegin, n, max);
+                itsOpen = false;
+            }
+        }
+
+        /// Finish the scan of `size` slots
+        inline std::int32_t finish (const std::size_t& size) {
+            below(size);
+            return empty() ? 0 : max;
+        }
+
+    };
+
+    }  //  namespace -- END
+
+    // =========================================================================
+    //
+    //  Kernels
+    //
+    // =========================================================================
+
+    /// Portable kernel, also used for the remainder of the vectorized kernels
+    static void scan_scalar (const std::int32_t* delta,
+                             std::int32_t* sum,
+                             const std::size_t& first,
+                             const std::size_t& size,
+                             MaxTracker& tracker,
+                             std::int32_t carry)
+    {
+        for (std::size_t n=first; n<size; ++n) {
+            carry += delta[n];
+            sum[n] = carry;
+            tracker.update(carry, n);
+        }
+    }
+
+#ifdef CGI_PREFIXSCAN_X86
+
+    /// Vectorized kernel for AVX2, processing 8 slots at a time
+    __attribute__((target("avx2")))
+    static void scan_avx2 (const std::int32_t* delta,
+                           std::int32_t* sum,
+                           const std::size_t& size,
+                           MaxTracker& tracker,
+                           const std::int32_t& carry)
+    {
+        const __m256i last = _mm256_set1_epi32(7);
+        __m256i vcarry     = _mm256_set1_epi32(carry);
+        std::size_t n      = 0;
+
+        for (; n+8<=size; n+=8) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(delta+n));
+            // prefix sum within each 128-bit lane ...
+            x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+            x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+            // ... carried over from the lower into the upper lane
+            x = _mm256_add_epi32(x, _mm256_shuffle_epi32(_mm256_permute2x128_si256(x, x, 0x08), 0xFF));
+            x = _mm256_add_epi32(x, vcarry);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(sum+n), x);
+            vcarry = _mm256_permutevar8x32_epi32(x, last);
+
+            if (tracker.empty()
+                || _mm256_movemask_epi8(_mm256_cmpgt_epi32(x, _mm256_set1_epi32(tracker.max-1)))) {
+                tracker.block(sum+n, n, 8);
+            } else {
+                tracker.below(n);
+            }
+        }
+
+        scan_scalar(delta, sum, n, size, tracker, n > 0 ? sum[n-1] : carry);
+    }
+
+    /// Vectorized kernel for AVX-512, processing 16 slots at a time
+    __attribute__((target("avx512f")))
+    static void scan_avx512 (const std::int32_t* delta,
+                             std::int32_t* sum,
+                             const std::size_t& size,
+                             MaxTracker& tracker,
+                             const std::int32_t& carry)
+    {
+        const __m512i zero = _mm512_setzero_si512();
+        const __m512i last = _mm512_set1_epi32(15);
+        __m512i vcarry     = _mm512_set1_epi32(carry);
+        std::size_t n      = 0;
+
+        for (; n+16<=size; n+=16) {
+            __m512i x = _mm512_loadu_si512(delta+n);
+            // prefix sum by shifting up 1, 2, 4 and 8 slots
+            x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 15));
+            x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 14));
+            x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 12));
+            x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 8));
+            x = _mm512_add_epi32(x, vcarry);
+            _mm512_storeu_si512(sum+n, x);
+            vcarry = _mm512_permutexvar_epi32(last, x);
+
+            if (tracker.empty()
+                || _mm512_cmpgt_epi32_mask(x, _mm512_set1_epi32(tracker.max-1))) {
+                tracker.block(sum+n, n, 16);
+            } else {
+                tracker.below(n);
+            }
+        }
+
+        scan_scalar(delta, sum, n, size, tracker, n > 0 ? sum[n-1] : carry);
+    }
+
+#endif
+
+    // =========================================================================
+    //
+    //  Public static methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                               isSupported
+
+    bool PrefixScan::isSupported (const Kernel& kernel)
+    {
+        switch (kernel) {
+        case Scalar:
+            return true;
+#ifdef CGI_PREFIXSCAN_X86
+        case AVX2:
+            return __builtin_cpu_supports("avx2");
+        case AVX512:
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                                    kernel
+
+    PrefixScan::Kernel PrefixScan::kernel ()
+    {
+        static const Kernel fastest = isSupported(AVX512) ? AVX512
+                                    : isSupported(AVX2)   ? AVX2
+                                    : Scalar;
+        return fastest;
+    }
+
+    //__________________________________________________________________________
+    //                                                                      name
+
+    const char* PrefixScan::name (const Kernel& kernel)
+    {
+        switch (kernel) {
+        case AVX2:
+            return "avx2";
+        case AVX512:
+            return "avx512";
+        default:
+            return "scalar";
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                                      scan
+
+    std::int32_t PrefixScan::scan (const std::int32_t* delta,
+                                   std::int32_t* sum,
+                                   const std::size_t& size,
+                                   IntervalSet<std::size_t,std::int32_t>& maxRuns,
+                                   const std::int32_t& carry)
+    {
+        return scan(kernel(), delta, sum, size, maxRuns, carry);
+    }
+
+    //__________________________________________________________________________
+    //                                                                      scan
+
+    std::int32_t PrefixScan::scan (const Kernel& kernel,
+                                   const std::int32_t* delta,
+                                   std::int32_t* sum,
+                                   const std::size_t& size,
+                                   IntervalSet<std::size_t,std::int32_t>& maxRuns,
+                                   const std::int32_t& carry)
+    {
+        MaxTracker tracker (maxRuns);
+
+#ifdef CGI_PREFIXSCAN_X86
+        if (kernel == AVX512 && isSupported(AVX512)) {
+            scan_avx512(delta, sum, size, tracker, carry);
+            return tracker.finish(size);
+        }
+        if (kernel == AVX2 && isSupported(AVX2)) {
+            scan_avx2(delta, sum, size, tracker, carry);
+            return tracker.finish(size);
+        }
+#endif
+
+        scan_scalar(delta, sum, 0, size, tracker, carry);
+        return tracker.finish(size);
+    }
+
+}  //  namespace cgi -- END
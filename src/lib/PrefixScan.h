@@ -0,0 +1,101 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_PREFIXSCAN_H
+#define CGI_PREFIXSCAN_H
+
+/*!
+ * \file PrefixScan.h
+ * \brief Fused prefix-sum and max-scan kernels for dense occupancy arrays
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "IntervalSet.h"
+
+namespace cgi {
+
+    /*!
+     * \class PrefixScan
+     * \brief Fused prefix-sum and max-scan over a dense array of deltas
+     * \test test_PrefixScan.cc
+     *
+     * Once the events have been bucketed into a dense array -- one slot per
+     * tick (or minute, etc.), holding the net change in the number of visitors
+     * -- the number of visitors is the running sum over the array, and the
+     * maximum number of visitors is the maximum of the running sum. Both are
+     * computed in a single pass, which at the same time records the runs of
+     * slots during which the maximum is reached.
+     *
+     * Besides the portable scalar kernel there are vectorized kernels for
+     * AVX2 (8 slots at a time) and AVX-512 (16 slots at a time). These are
+     * compiled for their instruction set through function attributes, such
+     * that no particular compiler flags are required; the kernel is selected
+     * once at run-time, based on the capabilities of the processor. Since
+     * blocks of slots below the current maximum are dismissed by a single
+     * comparison, the cost of tracking the maximum is negligible compared to
+     * the running sum itself.
+     */
+    class PrefixScan {
+
+    public:
+
+        /// Implementation of the scan
+        enum Kernel {
+            //! Portable implementation
+            Scalar,
+            //! Vectorized implementation for AVX2
+            AVX2,
+            //! Vectorized implementation for AVX-512
+            AVX512
+        };
+
+        // === Public static methods ===========================================
+
+        /// Get the kernel used by scan(), i.e. the fastest supported one
+        static Kernel kernel ();
+
+        /// Is `kernel` supported by the compiler and the processor?
+        static bool isSupported (const Kernel& kernel);
+
+        /// Get the name of `kernel`
+        static const char* name (const Kernel& kernel);
+
+        /*!
+         * \brief Compute running sum and maximum in a single pass
+         * \param delta   -- Array with the change in the number of visitors
+         *        per slot.
+         * \param sum     -- Array for the running sum, i.e. the number of
+         *        visitors per slot; may be the same as `delta`.
+         * \param size    -- Number of slots.
+         * \param maxRuns -- Runs of slots `[begin,end)` during which the maximum
+         *        is reached; previous contents are discarded.
+         * \param carry   -- Number of visitors before the first slot.
+         * \return Maximum of the running sum; 0 if `size` is zero.
+         */
+        static std::int32_t scan (const std::int32_t* delta,
+                                  std::int32_t* sum,
+                                  const std::size_t& size,
+                                  IntervalSet<std::size_t,std::int32_t>& maxRuns,
+                                  const std::int32_t& carry=0);
+
+        /*!
+         * \brief Compute running sum and maximum, using a particular kernel
+         * \param kernel -- Kernel to use; if not supported, the scalar kernel
+         *        is used instead.
+         */
+        static std::int32_t scan (const Kernel& kernel,
+                                  const std::int32_t* delta,
+                                  std::int32_t* sum,
+                                  const std::size_t& size,
+                                  IntervalSet<std::size_t,std::int32_t>& maxRuns,
+                                  const std::int32_t& carry=0);
+
+    };  //  class PrefixScan -- END
+
+}  //  namespace cgi -- END
+
+#endif
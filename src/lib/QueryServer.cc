@@ -0,0 +1,409 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "QueryServer.h"
+
+namespace cgi {
+
+    const std::size_t QueryServer::maxRequestSize;
+    const std::size_t QueryServer::maxPendingSize;
+
+    /// Get modification time (in nanoseconds) and size of a file
+    static bool fileStatus (const std::string& filename,
+                            std::int64_t& mtime,
+                            std::int64_t& size)
+    {
+        struct stat info;
+        if (stat(filename.c_str(), &info) != 0) {
+            return false;
+        }
+
+        mtime = std::int64_t(info.st_mtim.tv_sec)*1000000000 + info.st_mtim.tv_nsec;
+        size  = info.st_size;
+
+        return true;
+    }
+
+    /// Parse the next word of `is` as point in time
+    static std::int64_t parseTime (std::istream& is)
+    {
+        std::string word;
+        if (!(is >> word)) {
+            throw "Missing time";
+        }
+        if (!LogEntryView::isTime(word.data(), word.data()+word.size())) {
+            throw "Invalid time";
+        }
+
+        return LogData::clock_type::parse(word.data(), word.data()+word.size(),
+                                          LogEntryView::startOfDay());
+    }
+
+    /// Write maximum and corresponding time intervals to `os`
+    static void writeMax (std::ostream& os,
+                          const int& max,
+                          const IntervalSet<std::int64_t,int>& intervals)
+    {
+        os << "OK " << max;
+        for (auto it=intervals.begin(); it!=intervals.end(); ++it) {
+            os << " " << LogData::clock_type::toDateTime(it->begin())
+               << "/" << LogData::clock_type::toDateTime(it->end());
+        }
+    }
+
+    /// Send as much of `data` to non-blocking socket `fd` as possible, removing
+    /// the sent part; returns false if the connection failed
+    static bool sendPending (const int& fd,
+                             std::string& data)
+    {
+        std::size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = send(fd, data.data()+sent, data.size()-sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            sent += n;
+        }
+        data.erase(0, sent);
+        return true;
+    }
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                               QueryServer
+
+    QueryServer::QueryServer (const std::string& filename,
+                              const TimeWindow& window,
+                              const int& reloadInterval,
+                              const std::string& snapshotFile)
+        : itsFilename(filename),
+          itsTimeWindow(window),
+          itsReloadInterval(reloadInterval),
+          itsSnapshotFile(snapshotFile),
+          itsRunning(false)
+    {
+        reload();
+    }
+
+    // =========================================================================
+    //
+    //  Parameter access
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                generation
+
+    std::size_t QueryServer::generation () const
+    {
+        std::shared_ptr<const Snapshot> current = snapshot();
+        return current ? current->generation : 0;
+    }
+
+    // =========================================================================
+    //
+    //  Public methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                    reload
+
+    bool QueryServer::reload ()
+    {
+        std::int64_t mtime = 0;
+        std::int64_t size  = 0;
+        if (!fileStatus(itsFilename, mtime, size)) {
+            return false;
+        }
+
+        std::shared_ptr<const Snapshot> current = snapshot();
+        if (current && current->mtime == mtime && current->size == size) {
+            return false;
+        }
+
+        // Read and index the log, while queries still use the current state
+        std::shared_ptr<Snapshot> next (new Snapshot);
+        std::int64_t ticksPerSecond = LogData::clock_type::ticksPerSecond;
+
+        if (!itsSnapshotFile.empty()
+            && next->mapping.open(itsSnapshotFile)
+            && next->mapping.isCurrent(itsFilename, itsTimeWindow, ticksPerSecond)) {
+            // Up-to-date snapshot: query the mapped index in place
+            next->profile    = next->mapping.profile();
+            next->nofEntries = next->mapping.size();
+            if (next->nofEntries > 0) {
+                next->range.first  = LogData::clock_type::toDateTime(next->mapping.rangeOfTimes().first);
+                next->range.second = LogData::clock_type::toDateTime(next->mapping.rangeOfTimes().second);
+            }
+        } else {
+            next->mapping.close();
+
+            LogData data;
+            data.setTimeWindow(itsTimeWindow);
+            data.readData(itsFilename);
+            next->profile    = OccupancyProfile(data.sortedEvents());
+            next->nofEntries = data.size();
+            next->range      = data.rangeOfTimes();
+
+            // Save the snapshot, unless the log has changed while reading
+            std::int64_t mtimeRead = 0;
+            std::int64_t sizeRead  = 0;
+            if (!itsSnapshotFile.empty()
+                && fileStatus(itsFilename, mtimeRead, sizeRead)
+                && mtimeRead == mtime && sizeRead == size
+                && !OccupancySnapshot::write(itsSnapshotFile, itsFilename, data,
+                                             next->profile, itsTimeWindow)) {
+                std::cerr << "Unable to write snapshot: " << itsSnapshotFile << "\n";
+            }
+        }
+
+        next->mtime      = mtime;
+        next->size       = size;
+        next->generation = current ? current->generation+1 : 1;
+
+        std::lock_guard<std::mutex> lock (itsMutex);
+        itsSnapshot = next;
+
+        return true;
+    }
+
+    //__________________________________________________________________________
+    //                                                                    answer
+
+    std::string QueryServer::answer (const std::string& request) const
+    {
+        std::shared_ptr<const Snapshot> current = snapshot();
+        std::istringstream is (request);
+        std::ostringstream os;
+        std::string command;
+
+        is >> command;
+        std::transform(command.begin(), command.end(), command.begin(), ::toupper);
+
+        try {
+            if (!current) {
+                throw "No data loaded";
+            } else if (command == "MAX") {
+                writeMax(os, current->profile.maxNofVisitors(), current->profile.maxIntervals());
+            } else if (command == "AT") {
+                std::int64_t time = parseTime(is);
+                os << "OK " << current->profile.at(time);
+            } else if (command == "RANGE") {
+                std::int64_t from = parseTime(is);
+                std::int64_t to   = parseTime(is);
+                writeMax(os, current->profile.maxNofVisitors(from, to),
+                         current->profile.maxIntervals(from, to));
+            } else if (command == "INFO") {
+                os << "OK " << current->nofEntries
+                   << " " << current->range.first << "/" << current->range.second
+                   << " " << current->generation;
+            } else {
+                throw "Unknown request";
+            }
+        } catch (const char* message) {
+            os.str("");
+            os << "ERR " << message;
+        }
+
+        return os.str();
+    }
+
+    //__________________________________________________________________________
+    //                                                                     serve
+
+    int QueryServer::serve (const std::string& path)
+    {
+        struct sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+
+        if (path.size() >= sizeof(address.sun_path)) {
+            std::cerr << "Socket path too long: " << path << "\n";
+            return 1;
+        }
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path)-1);
+
+        int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        unlink(path.c_str());
+        if (listener < 0
+            || bind(listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0
+            || listen(listener, 16) != 0) {
+            std::cerr << "Error opening: " << path << "\n";
+            if (listener >= 0) {
+                close(listener);
+            }
+            return 1;
+        }
+
+        itsRunning = true;
+
+        // Check the log for changes in the background
+        std::thread watcher ([this] () {
+                const int step = 50;
+                while (itsRunning) {
+                    for (int waited=0; waited<itsReloadInterval && itsRunning; waited+=step) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(step));
+                    }
+                    if (!itsRunning) {
+                        break;
+                    }
+                    // Keep answering from the previous state if reading fails
+                    try {
+                        reload();
+                    } catch (const char* message) {
+                        std::cerr << "Unable to reload " << itsFilename << ": " << message << "\n";
+                    } catch (const std::exception& error) {
+                        std::cerr << "Unable to reload " << itsFilename << ": " << error.what() << "\n";
+                    }
+                }
+            });
+
+        // Poll the listening socket as well as the connected clients; clients
+        // never block the loop, their responses are queued until writable
+        std::vector<struct pollfd> fds (1);
+        std::vector<std::string> buffers (1);
+        std::vector<std::string> pending (1);
+        std::vector<char> closing (1, false);
+        fds[0].fd     = listener;
+        fds[0].events = POLLIN;
+
+        while (itsRunning) {
+            for (auto it=fds.begin(); it!=fds.end(); ++it) {
+                it->revents = 0;
+            }
+            if (poll(fds.data(), fds.size(), 100) <= 0) {
+                continue;
+            }
+
+            if (fds[0].revents & POLLIN) {
+                int client = accept(listener, NULL, NULL);
+                if (client >= 0) {
+                    fcntl(client, F_SETFL, fcntl(client, F_GETFL) | O_NONBLOCK);
+                    struct pollfd fd = { client, POLLIN, 0 };
+                    fds.push_back(fd);
+                    buffers.push_back(std::string());
+                    pending.push_back(std::string());
+                    closing.push_back(false);
+                }
+            }
+
+            for (std::size_t n=fds.size()-1; n>0; --n) {
+                if (fds[n].revents == 0) {
+                    continue;
+                }
+
+                bool open = (fds[n].revents & (POLLERR | POLLNVAL)) == 0;
+
+                if (open && !closing[n] && (fds[n].revents & (POLLIN | POLLHUP))) {
+                    char data[4096];
+                    ssize_t received = recv(fds[n].fd, data, sizeof(data), 0);
+                    if (received > 0) {
+                        buffers[n].append(data, received);
+                    } else if (received == 0) {
+                        // answer what has been requested before hanging up
+                        closing[n] = true;
+                    } else if (errno != EAGAIN && errno != EINTR) {
+                        open = false;
+                    }
+
+                    // answer all complete request lines
+                    std::size_t pos;
+                    while (open && (pos = buffers[n].find('\n')) != std::string::npos) {
+                        std::string line = buffers[n].substr(0, pos);
+                        buffers[n].erase(0, pos+1);
+                        if (!line.empty() && line[line.size()-1] == '\r') {
+                            line.resize(line.size()-1);
+                        }
+                        pending[n] += answer(line) + "\n";
+                    }
+
+                    // drop clients which never complete their request line
+                    if (buffers[n].size() > maxRequestSize) {
+                        pending[n] += "ERR Request too long\n";
+                        closing[n] = true;
+                    }
+                }
+
+                // drop clients which do not read their responses
+                open = open
+                    && sendPending(fds[n].fd, pending[n])
+                    && pending[n].size() <= maxPendingSize
+                    && !(closing[n] && pending[n].empty());
+
+                if (open) {
+                    fds[n].events = (closing[n] ? 0 : POLLIN) | (pending[n].empty() ? 0 : POLLOUT);
+                } else {
+                    close(fds[n].fd);
+                    fds.erase(fds.begin()+n);
+                    buffers.erase(buffers.begin()+n);
+                    pending.erase(pending.begin()+n);
+                    closing.erase(closing.begin()+n);
+                }
+            }
+        }
+
+        for (auto it=fds.begin(); it!=fds.end(); ++it) {
+            close(it->fd);
+        }
+        unlink(path.c_str());
+        watcher.join();
+
+        return 0;
+    }
+
+    //__________________________________________________________________________
+    //                                                                      stop
+
+    void QueryServer::stop ()
+    {
+        itsRunning = false;
+    }
+
+    // =========================================================================
+    //
+    //  Private methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                  snapshot
+
+    std::shared_ptr<const QueryServer::Snapshot> QueryServer::snapshot () const
+    {
+        std::lock_guard<std::mutex> lock (itsMutex);
+        return itsSnapshot;
+    }
+
+}  //  namespace cgi -- END
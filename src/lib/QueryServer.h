@@ -0,0 +1,170 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_QUERYSERVER_H
+#define CGI_QUERYSERVER_H
+
+/*!
+ * \file QueryServer.h
+ * \brief Class for serving occupancy queries over a Unix domain socket
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "LogData.h"
+#include "OccupancyProfile.h"
+#include "OccupancySnapshot.h"
+#include "TimeWindow.h"
+
+namespace cgi {
+
+    /*!
+     * \class QueryServer
+     * \brief Resident server answering occupancy queries for a visitor log
+     * \test test_QueryServer.cc
+     *
+     * The visitor log is read once and indexed as cgi::OccupancyProfile, such
+     * that subsequent queries are answered without touching the log file
+     * again. Queries are received over a Unix domain socket (see serve()) in a
+     * line-based protocol; each request line is answered by a single response
+     * line, starting with either `OK` or `ERR`:
+     *
+     * | Request             | Response                                       |
+     * |---------------------|------------------------------------------------|
+     * | `MAX`               | `OK <max> <begin>/<end> ...`                   |
+     * | `AT <time>`         | `OK <visitors>`                                |
+     * | `RANGE <from> <to>` | `OK <max> <begin>/<end> ...`, within [from,to) |
+     * | `INFO`              | `OK <entries> <first>/<last> <generation>`     |
+     *
+     * A client sending more than maxRequestSize characters without completing
+     * the request line is answered by `ERR Request too long` and disconnected.
+     * Clients are served without blocking: responses are queued until the
+     * client's socket is writable, and a client with more than
+     * maxPendingSize characters of responses not yet read is disconnected,
+     * such that a client which stops reading never stalls the others.
+     *
+     * Times in requests are accepted as ``HH:MM[:SS]`` or ISO 8601 timestamp;
+     * times in responses are given as ISO 8601 timestamps (UTC), intervals in
+     * ISO 8601 ``<begin>/<end>`` notation.
+     *
+     * While serving, the log file is checked for changes at regular intervals
+     * by a background thread; if modified, it is read and indexed anew, and
+     * swapped in once complete -- queries in the meantime are answered from
+     * the previous state, which also remains in place if reading the log
+     * fails. The generation reported by `INFO` counts the number of times the
+     * log has been loaded.
+     *
+     * If a snapshot file is given, the log data and index are saved to it as
+     * cgi::OccupancySnapshot after reading the log; a server started later on
+     * maps the snapshot -- provided it is up to date with the log -- instead
+     * of reading the log again, such that it answers queries right away.
+     */
+    class QueryServer {
+
+        /*!
+         * \brief State of the server for a particular version of the log file
+         */
+        struct Snapshot {
+            /// Snapshot file, if mapped, to which the index refers
+            OccupancySnapshot mapping;
+            /// Index of the number of visitors over time
+            OccupancyProfile profile;
+            /// Number of log entries
+            std::size_t nofEntries;
+            /// Range of times (first entry, last exit)
+            std::pair<DateTime,DateTime> range;
+            /// Modification time of the log file (nanoseconds since the epoch)
+            std::int64_t mtime;
+            /// Size of the log file
+            std::int64_t size;
+            /// Number of times the log has been loaded
+            std::size_t generation;
+        };
+
+        /// Name of the visitor log
+        std::string itsFilename;
+        /// Time window to which to restrict the log data
+        TimeWindow itsTimeWindow;
+        /// Interval (in milliseconds) at which to check the log for changes
+        int itsReloadInterval;
+        /// Name of the snapshot file; empty if not used
+        std::string itsSnapshotFile;
+        /// Current state, as used for answering queries
+        std::shared_ptr<const Snapshot> itsSnapshot;
+        /// Mutex guarding the access to the current state
+        mutable std::mutex itsMutex;
+        /// Keep serving requests?
+        std::atomic<bool> itsRunning;
+
+        /// Get the current state
+        std::shared_ptr<const Snapshot> snapshot () const;
+
+    public:
+
+        /// Maximum number of characters of a pending request line
+        static const std::size_t maxRequestSize = 4096;
+        /// Maximum number of characters of responses not yet read by a client
+        static const std::size_t maxPendingSize = 1024*1024;
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param filename       -- Name of the visitor log.
+         * \param window         -- Time window to which to restrict the data.
+         * \param reloadInterval -- Interval (in milliseconds) at which to check
+         *        the log for changes.
+         * \param snapshotFile   -- Name of the snapshot file to start from and
+         *        to keep up to date; empty if not used.
+         */
+        QueryServer (const std::string& filename,
+                     const TimeWindow& window=TimeWindow(),
+                     const int& reloadInterval=1000,
+                     const std::string& snapshotFile="");
+
+        // === Parameter access ================================================
+
+        /// Get the name of the visitor log
+        inline const std::string& filename () const {
+            return itsFilename;
+        }
+
+        /// Get the number of times the log has been loaded
+        std::size_t generation () const;
+
+        // === Public methods ==================================================
+
+        /*!
+         * \brief Reload the log, if changed since it was last loaded
+         * \return Has the log been reloaded?
+         */
+        bool reload ();
+
+        /*!
+         * \brief Answer a single request
+         * \param request -- Request line, without line terminator.
+         * \return Response line, without line terminator.
+         */
+        std::string answer (const std::string& request) const;
+
+        /*!
+         * \brief Serve requests on a Unix domain socket, until stopped
+         * \param path -- Path of the socket; an existing file is replaced.
+         * \return Status of the operation; returns non-zero in case of an error.
+         */
+        int serve (const std::string& path);
+
+        /// Stop serving requests; safe to call from a signal handler
+        void stop ();
+
+    };  //  class QueryServer -- END
+
+}  //  namespace cgi -- END
+
+#endif
@@ -0,0 +1,341 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "LogBuffer.h"
+#include "ResultCache.h"
+
+namespace cgi {
+
+    /// Suffix of the files holding the entries
+    static const char entrySuffix[] = ".result";
+
+    /// Suffix of the files an entry is written to before being renamed
+    static const char tmpSuffix[] = ".tmp";
+
+    /// Age (in seconds) after which a temporary file is considered left behind,
+    /// rather than still being written by a concurrent store
+    static const std::time_t tmpGracePeriod = 600;
+
+    /*!
+     * \struct CacheEntry
+     * \brief File holding an entry of the cache
+     */
+    struct CacheEntry {
+        /// Name of the file
+        std::string filename;
+        /// Size of the file (in bytes)
+        std::uint64_t size;
+        /// Time of last use (nanoseconds since the epoch)
+        std::int64_t used;
+    };
+
+    /// Does `name` end with `suffix`?
+    static bool endsWith (const std::string& name,
+                          const char* suffix)
+    {
+        std::size_t length = std::strlen(suffix);
+        return name.size() > length
+            && name.compare(name.size()-length, length, suffix) == 0;
+    }
+
+    /// Get the files holding the entries within `directory`, optionally
+    /// including temporary files left behind by interrupted stores
+    static std::vector<CacheEntry> listEntries (const std::string& directory,
+                                                bool withTemporary=false)
+    {
+        std::vector<CacheEntry> result;
+        std::time_t staleBefore = std::time(NULL) - tmpGracePeriod;
+
+        DIR* dir = opendir(directory.c_str());
+        if (dir == NULL) {
+            return result;
+        }
+
+        for (struct dirent* it=readdir(dir); it!=NULL; it=readdir(dir)) {
+            std::string name (it->d_name);
+            struct stat info;
+            bool temporary = withTemporary
+                && endsWith(name, tmpSuffix)
+                && name.find(std::string(entrySuffix) + ".") != std::string::npos;
+            if ((!endsWith(name, entrySuffix) && !temporary)
+                || stat((directory + "/" + name).c_str(), &info) != 0
+                || (temporary && info.st_mtime >= staleBefore)) {
+                continue;
+            }
+
+            CacheEntry entry;
+            entry.filename = directory + "/" + name;
+            entry.size     = info.st_size;
+            entry.used     = std::int64_t(info.st_mtim.tv_sec)*1000000000 + info.st_mtim.tv_nsec;
+            result.push_back(entry);
+        }
+        closedir(dir);
+
+        return result;
+    }
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                               ResultCache
+
+    ResultCache::ResultCache (const std::string& directory,
+                              const std::uint64_t& maxSize)
+        : itsDirectory(directory),
+          itsMaxSize(maxSize)
+    {
+        if (!itsDirectory.empty()) {
+            mkdir(itsDirectory.c_str(), 0755);
+        }
+    }
+
+    // =========================================================================
+    //
+    //  Parameter access
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                      size
+
+    std::uint64_t ResultCache::size () const
+    {
+        std::vector<CacheEntry> entries = listEntries(itsDirectory);
+        std::uint64_t result            = 0;
+
+        for (auto it=entries.begin(); it!=entries.end(); ++it) {
+            result += it->size;
+        }
+
+        return result;
+    }
+
+    //__________________________________________________________________________
+    //                                                                nofEntries
+
+    std::size_t ResultCache::nofEntries () const
+    {
+        return listEntries(itsDirectory).size();
+    }
+
+    // =========================================================================
+    //
+    //  Public methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                      load
+
+    bool ResultCache::load (const std::string& key,
+                            std::string& value) const
+    {
+        std::string filename = entryName(key);
+        std::ifstream infile (filename.c_str(), std::ios::binary);
+        if (key.empty() || !infile.is_open()) {
+            return false;
+        }
+
+        std::ostringstream os;
+        os << infile.rdbuf();
+        value = os.str();
+
+        // mark the entry as recently used
+        utimensat(AT_FDCWD, filename.c_str(), NULL, 0);
+
+        return true;
+    }
+
+    //__________________________________________________________________________
+    //                                                                     store
+
+    bool ResultCache::store (const std::string& key,
+                             const std::string& value)
+    {
+        if (key.empty()) {
+            return false;
+        }
+
+        /* Unique temporary name, such that concurrent stores of the same key
+           do not write into the same file */
+        std::string filename = entryName(key);
+        std::string tmpname  = filename + ".XXXXXX" + tmpSuffix;
+        std::vector<char> buffer (tmpname.begin(), tmpname.end());
+        buffer.push_back('\0');
+
+        int fd = mkstemps(buffer.data(), std::strlen(tmpSuffix));
+        if (fd < 0) {
+            std::cerr << "Error opening: " << tmpname << "\n";
+            return false;
+        }
+        tmpname = buffer.data();
+        fchmod(fd, 0644);
+
+        bool good        = true;
+        const char* data = value.data();
+        std::size_t left = value.size();
+        while (good && left > 0) {
+            ssize_t written = write(fd, data, left);
+            if (written < 0) {
+                good = false;
+            } else {
+                data += written;
+                left -= written;
+            }
+        }
+        good = close(fd) == 0 && good;
+
+        if (!good || std::rename(tmpname.c_str(), filename.c_str()) != 0) {
+            std::remove(tmpname.c_str());
+            return false;
+        }
+
+        evict();
+
+        return true;
+    }
+
+    //__________________________________________________________________________
+    //                                                                    remove
+
+    bool ResultCache::remove (const std::string& key)
+    {
+        return !key.empty() && std::remove(entryName(key).c_str()) == 0;
+    }
+
+    //__________________________________________________________________________
+    //                                                                     evict
+
+    void ResultCache::evict ()
+    {
+        std::vector<CacheEntry> entries = listEntries(itsDirectory, true);
+        std::uint64_t total             = 0;
+
+        for (auto it=entries.begin(); it!=entries.end(); ++it) {
+            total += it->size;
+        }
+
+        // least recently used first
+        std::sort(entries.begin(), entries.end(),
+                  [] (const CacheEntry& a, const CacheEntry& b) {
+                      return a.used < b.used || (a.used == b.used && a.filename < b.filename);
+                  });
+
+        for (auto it=entries.begin(); it!=entries.end() && total > itsMaxSize; ++it) {
+            if (std::remove(it->filename.c_str()) == 0) {
+                total -= it->size;
+            }
+        }
+    }
+
+    // =========================================================================
+    //
+    //  Public static methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                       key
+
+    std::string ResultCache::key (const std::string& filename,
+                                  const std::string& options)
+    {
+        // Hashing a pipe would consume the input before it is processed
+        struct stat info;
+        if (stat(filename.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+            return "";
+        }
+
+        LogBuffer buffer (filename);
+        if (!buffer.isOpen()) {
+            return "";
+        }
+
+        char result[33];
+        std::snprintf(result, sizeof(result), "%016llx%016llx",
+                      static_cast<unsigned long long>(hash(buffer.data(), buffer.size())),
+                      static_cast<unsigned long long>(hash(options.data(), options.size())));
+
+        return result;
+    }
+
+    //__________________________________________________________________________
+    //                                                                      hash
+
+    std::uint64_t ResultCache::hash (const char* data,
+                                     const std::size_t& size,
+                                     const std::uint64_t& seed)
+    {
+        const std::uint64_t m = 0xc6a4a7935bd1e995ULL;
+        const int r           = 47;
+
+        std::uint64_t h = seed ^ (size * m);
+
+        const char* end = data + (size - size%8);
+        for (const char* it=data; it!=end; it+=8) {
+            std::uint64_t k;
+            std::memcpy(&k, it, sizeof(k));
+
+            k *= m;
+            k ^= k >> r;
+            k *= m;
+
+            h ^= k;
+            h *= m;
+        }
+
+        // remaining bytes
+        switch (size%8) {
+        case 7: h ^= std::uint64_t(static_cast<unsigned char>(end[6])) << 48; // fall through
+        case 6: h ^= std::uint64_t(static_cast<unsigned char>(end[5])) << 40; // fall through
+        case 5: h ^= std::uint64_t(static_cast<unsigned char>(end[4])) << 32; // fall through
+        case 4: h ^= std::uint64_t(static_cast<unsigned char>(end[3])) << 24; // fall through
+        case 3: h ^= std::uint64_t(static_cast<unsigned char>(end[2])) << 16; // fall through
+        case 2: h ^= std::uint64_t(static_cast<unsigned char>(end[1])) << 8; // fall through
+        case 1: h ^= std::uint64_t(static_cast<unsigned char>(end[0]));
+                h *= m;
+        };
+
+        h ^= h >> r;
+        h *= m;
+        h ^= h >> r;
+
+        return h;
+    }
+
+    // =========================================================================
+    //
+    //  Private methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                 entryName
+
+    std::string ResultCache::entryName (const std::string& key) const
+    {
+        return itsDirectory + "/" + key + entrySuffix;
+    }
+
+}  //  namespace cgi -- END
@@ -0,0 +1,143 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_RESULTCACHE_H
+#define CGI_RESULTCACHE_H
+
+/*!
+ * \file ResultCache.h
+ * \brief Class for an on-disk cache of results, keyed by the content of the input
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cgi {
+
+    /*!
+     * \class ResultCache
+     * \brief On-disk cache of results, keyed by the content of the input
+     * \test test_ResultCache.cc
+     *
+     * Results of processing a log -- e.g. a saved cgi::OccupancySweep -- are
+     * kept as one file per entry in a cache directory. The key of an entry
+     * (see key()) combines a hash of the contents of the input file with a
+     * hash of the options affecting the result, such that a repeated run on
+     * unchanged input with the same options finds its result, regardless of
+     * the name or modification time of the input file.
+     *
+     * The total size of the entries is bounded by maxSize(): after storing a
+     * result, the least recently used entries -- as per their modification
+     * time, which is refreshed whenever an entry is loaded -- are removed
+     * until the cache fits again. Entries are written under a unique
+     * temporary name and renamed once complete, such that concurrent runs
+     * sharing a cache directory never see a partially written entry;
+     * temporary files left behind by interrupted runs are subject to
+     * eviction as well, once older than a grace period which leaves those
+     * of concurrent runs untouched.
+     */
+    class ResultCache {
+
+        /// Directory holding the entries
+        std::string itsDirectory;
+        /// Upper limit for the total size of the entries (in bytes)
+        std::uint64_t itsMaxSize;
+
+        /// Get the name of the file holding the entry for `key`
+        std::string entryName (const std::string& key) const;
+
+    public:
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param directory -- Directory holding the entries; created if missing.
+         * \param maxSize   -- Upper limit for the total size of the entries (in
+         *        bytes).
+         */
+        ResultCache (const std::string& directory,
+                     const std::uint64_t& maxSize=256*1024*1024);
+
+        // === Parameter access ================================================
+
+        /// Get the directory holding the entries
+        inline const std::string& directory () const {
+            return itsDirectory;
+        }
+
+        /// Get the upper limit for the total size of the entries (in bytes)
+        inline std::uint64_t maxSize () const {
+            return itsMaxSize;
+        }
+
+        /// Get the total size of the entries (in bytes)
+        std::uint64_t size () const;
+
+        /// Get the number of entries
+        std::size_t nofEntries () const;
+
+        // === Public methods ==================================================
+
+        /*!
+         * \brief Look up the entry for `key`
+         * \param key   -- Key of the entry, see key().
+         * \param value -- Contents of the entry, if found.
+         * \return Has an entry been found?
+         */
+        bool load (const std::string& key,
+                   std::string& value) const;
+
+        /*!
+         * \brief Store an entry, evicting least recently used entries as needed
+         * \param key   -- Key of the entry, see key().
+         * \param value -- Contents of the entry.
+         * \return Could the entry be stored?
+         */
+        bool store (const std::string& key,
+                    const std::string& value);
+
+        /*!
+         * \brief Remove the entry for `key`, e.g. after failing to decode it
+         * \param key -- Key of the entry, see key().
+         * \return Has an entry been removed?
+         */
+        bool remove (const std::string& key);
+
+        /// Remove least recently used entries until the cache fits into maxSize()
+        void evict ();
+
+        // === Public static methods ===========================================
+
+        /*!
+         * \brief Get the key for the contents of a file and a set of options
+         * \param filename -- Name of the input file.
+         * \param options  -- Description of all options affecting the result.
+         * \return Key of the entry; empty if the file could not be read or is
+         *         not a regular file -- e.g. a pipe, which could be read only
+         *         once.
+         */
+        static std::string key (const std::string& filename,
+                                const std::string& options);
+
+        /*!
+         * \brief Get a 64-bit hash of the bytes in [data,data+size)
+         * \param data -- Pointer to the first byte.
+         * \param size -- Number of bytes.
+         * \param seed -- Seed, e.g. for chaining hashes.
+         *
+         * Non-cryptographic hash (MurmurHash64A), consuming eight bytes per
+         * step.
+         */
+        static std::uint64_t hash (const char* data,
+                                   const std::size_t& size,
+                                   const std::uint64_t& seed=0);
+
+    };  //  class ResultCache -- END
+
+}  //  namespace cgi -- END
+
+#endif
@@ -0,0 +1,181 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_RINGBUFFER_H
+#define CGI_RINGBUFFER_H
+
+/*!
+ * \file RingBuffer.h
+ * \brief Class for a bounded lock-free single-producer/single-consumer queue
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cgi {
+
+    /*!
+     * \class RingBuffer
+     * \brief Bounded lock-free queue for one producer and one consumer thread
+     * \test test_RingBuffer.cc
+     *
+     * The elements are kept in a fixed array of slots, whose number is rounded
+     * up to a power of two; the producer advances the tail, the consumer the
+     * head, each publishing its position with release semantics, such that no
+     * locks are required as long as there is a single thread on either side.
+     *
+     * The blocking variants push() and pop() apply backpressure: the producer
+     * waits while the buffer is full and the consumer while it is empty. Once
+     * the buffer has been closed, push() fails right away, while pop() still
+     * hands out the remaining elements -- hence close() serves both to signal
+     * the end of the stream and to abort the producer.
+     *
+     * Head and tail are kept apart by explicit padding rather than by
+     * over-aligned members, which plain `new` does not honour before C++17.
+     */
+    template <typename T>
+    class RingBuffer {
+
+        /// Size of a cache line, by which the positions are kept apart
+        static const std::size_t cacheLineSize = 64;
+
+        /// Slots holding the elements
+        std::vector<T> itsSlots;
+        /// Number of slots minus one, for masking the positions
+        std::size_t itsMask;
+        /// Padding, keeping the head off the cache line of the fields above
+        char itsPadding0[cacheLineSize];
+        /// Position of the next element to pop (advanced by the consumer)
+        std::atomic<std::size_t> itsHead;
+        /// Padding, keeping head and tail on separate cache lines
+        char itsPadding1[cacheLineSize - sizeof(std::atomic<std::size_t>)];
+        /// Position of the next element to push (advanced by the producer)
+        std::atomic<std::size_t> itsTail;
+        /// Padding, keeping the tail off the cache line of the flag below
+        char itsPadding2[cacheLineSize - sizeof(std::atomic<std::size_t>)];
+        /// Has the buffer been closed?
+        std::atomic<bool> itsClosed;
+
+    public:
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param capacity -- Minimum number of elements the buffer can hold.
+         */
+        explicit RingBuffer (const std::size_t& capacity)
+            : itsHead(0),
+              itsTail(0),
+              itsClosed(false) {
+            std::size_t size = 1;
+            while (size < capacity) {
+                size *= 2;
+            }
+            itsSlots.resize(size);
+            itsMask = size - 1;
+        }
+
+        // === Parameter access ================================================
+
+        /// Get the number of elements the buffer can hold
+        inline std::size_t capacity () const {
+            return itsSlots.size();
+        }
+
+        /// Get the number of elements currently held (a snapshot only)
+        inline std::size_t size () const {
+            return itsTail.load(std::memory_order_acquire) - itsHead.load(std::memory_order_acquire);
+        }
+
+        /// Has the buffer been closed?
+        inline bool isClosed () const {
+            return itsClosed.load(std::memory_order_acquire);
+        }
+
+        // === Public methods ==================================================
+
+        /*!
+         * \brief Append an element, unless the buffer is full
+         * \param value -- Element, moved from on success.
+         * \return Has the element been appended?
+         */
+        bool tryPush (T& value) {
+            std::size_t tail = itsTail.load(std::memory_order_relaxed);
+            if (tail - itsHead.load(std::memory_order_acquire) == itsSlots.size()) {
+                return false;
+            }
+            itsSlots[tail & itsMask] = std::move(value);
+            itsTail.store(tail+1, std::memory_order_release);
+            return true;
+        }
+
+        /*!
+         * \brief Remove the first element, unless the buffer is empty
+         * \param value -- Element removed.
+         * \return Has an element been removed?
+         */
+        bool tryPop (T& value) {
+            std::size_t head = itsHead.load(std::memory_order_relaxed);
+            if (head == itsTail.load(std::memory_order_acquire)) {
+                return false;
+            }
+            value = std::move(itsSlots[head & itsMask]);
+            itsHead.store(head+1, std::memory_order_release);
+            return true;
+        }
+
+        /*!
+         * \brief Append an element, waiting while the buffer is full
+         * \param value -- Element to append.
+         * \return Has the element been appended, i.e. has the buffer not been
+         *         closed?
+         */
+        bool push (T value) {
+            while (!isClosed()) {
+                if (tryPush(value)) {
+                    return true;
+                }
+                std::this_thread::yield();
+            }
+            return false;
+        }
+
+        /*!
+         * \brief Remove the first element, waiting while the buffer is empty
+         * \param value -- Element removed.
+         * \return Has an element been removed, i.e. has the buffer not been
+         *         closed and drained?
+         */
+        bool pop (T& value) {
+            while (!tryPop(value)) {
+                if (isClosed()) {
+                    // elements pushed before closing the buffer
+                    return tryPop(value);
+                }
+                std::this_thread::yield();
+            }
+            return true;
+        }
+
+        /// Close the buffer, see push() and pop()
+        inline void close () {
+            itsClosed.store(true, std::memory_order_release);
+        }
+
+    private:
+
+        // Objects of this type are shared between threads
+        RingBuffer (const RingBuffer&);
+        RingBuffer& operator= (const RingBuffer&);
+
+    };  //  class RingBuffer -- END
+
+}  //  namespace cgi -- END
+
+#endif
@@ -0,0 +1,185 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include "ThreadPool.h"
+
+namespace cgi {
+
+    const std::size_t ThreadPool::maxNofThreads;
+
+    namespace {
+
+        /// Pool to which the current thread belongs as worker, if any
+        thread_local const ThreadPool* currentPool = NULL;
+        /// Index of the current thread within its pool
+        thread_local std::size_t currentIndex = 0;
+
+        /// Mutex guarding the process-wide pool
+        std::mutex globalMutex;
+        /// Process-wide pool, created on first use
+        std::unique_ptr<ThreadPool> globalPool;
+
+    }
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                ThreadPool
+
+    ThreadPool::ThreadPool (const std::size_t& nofThreads)
+        : itsNofQueued(0),
+          itsNext(0),
+          itsStop(false)
+    {
+        std::size_t nofWorkers = nofThreads;
+        if (nofWorkers == 0) {
+            nofWorkers = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        }
+        nofWorkers = std::min(nofWorkers, maxNofThreads) - 1;
+
+        for (std::size_t n=0; n<nofWorkers; ++n) {
+            itsQueues.push_back(std::unique_ptr<Queue>(new Queue()));
+        }
+        for (std::size_t n=0; n<nofWorkers; ++n) {
+            itsWorkers.push_back(std::thread(&ThreadPool::work, this, n));
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                               ~ThreadPool
+
+    ThreadPool::~ThreadPool ()
+    {
+        {
+            std::lock_guard<std::mutex> lock (itsMutex);
+            itsStop = true;
+        }
+        itsWakeup.notify_all();
+
+        for (auto it=itsWorkers.begin(); it!=itsWorkers.end(); ++it) {
+            it->join();
+        }
+    }
+
+    // =========================================================================
+    //
+    //  Public static methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                    global
+
+    ThreadPool& ThreadPool::global ()
+    {
+        std::lock_guard<std::mutex> lock (globalMutex);
+        if (!globalPool) {
+            globalPool.reset(new ThreadPool());
+        }
+        return *globalPool;
+    }
+
+    //__________________________________________________________________________
+    //                                                             setNofThreads
+
+    void ThreadPool::setNofThreads (const std::size_t& nofThreads)
+    {
+        std::lock_guard<std::mutex> lock (globalMutex);
+        globalPool.reset();
+        globalPool.reset(new ThreadPool(nofThreads));
+    }
+
+    // =========================================================================
+    //
+    //  Private methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                      work
+
+    void ThreadPool::work (const std::size_t& index)
+    {
+        currentPool  = this;
+        currentIndex = index;
+
+        while (true) {
+            if (runTask()) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock (itsMutex);
+            itsWakeup.wait(lock, [this] () { return itsStop || itsNofQueued > 0; });
+            if (itsStop && itsNofQueued == 0) {
+                return;
+            }
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                                    submit
+
+    void ThreadPool::submit (Task task)
+    {
+        // Workers keep their own tasks, others are spread round-robin
+        std::size_t index = (currentPool == this) ? currentIndex : itsNext++ % itsQueues.size();
+
+        {
+            std::lock_guard<std::mutex> lock (itsQueues[index]->mutex);
+            itsQueues[index]->tasks.push_back(std::move(task));
+            ++itsNofQueued;
+        }
+
+        // Pass through the mutex, such that a worker about to sleep sees the task
+        {
+            std::lock_guard<std::mutex> lock (itsMutex);
+        }
+        itsWakeup.notify_one();
+    }
+
+    //__________________________________________________________________________
+    //                                                                   runTask
+
+    bool ThreadPool::runTask ()
+    {
+        if (itsNofQueued == 0) {
+            return false;
+        }
+
+        std::size_t nofQueues = itsQueues.size();
+        bool isWorker         = (currentPool == this);
+        std::size_t first     = isWorker ? currentIndex : itsNext % nofQueues;
+        Task task;
+
+        for (std::size_t n=0; n<nofQueues && !task; ++n) {
+            Queue& queue = *itsQueues[(first + n) % nofQueues];
+            std::lock_guard<std::mutex> lock (queue.mutex);
+            if (queue.tasks.empty()) {
+                continue;
+            }
+            // Own queue from the back (most recent first), others from the front
+            if (isWorker && n == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            --itsNofQueued;
+        }
+
+        if (!task) {
+            return false;
+        }
+
+        task();
+        return true;
+    }
+
+}  //  namespace cgi -- END
@@ -0,0 +1,296 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_THREADPOOL_H
+#define CGI_THREADPOOL_H
+
+/*!
+ * \file ThreadPool.h
+ * \brief Work-stealing thread pool, with helpers for data-parallel loops
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cgi {
+
+    /*!
+     * \class ThreadPool
+     * \brief Work-stealing thread pool, with helpers for data-parallel loops
+     * \test test_ThreadPool.cc
+     *
+     * Each worker thread owns a queue of tasks: tasks submitted by a worker are
+     * pushed onto and popped from the back of its own queue, while idle workers
+     * steal from the front of the queues of the others. A thread waiting for
+     * its tasks to complete -- see parallelFor() -- does not block, but runs
+     * pending tasks itself; hence the helpers may be nested without running out
+     * of workers, and the calling thread counts as one of nofThreads().
+     *
+     * A single process-wide pool is provided by global(), sized by
+     * setNofThreads() (e.g. from the command line of an application) and shared
+     * by all parallel sections of the library; with a single thread all work is
+     * done by the calling thread, in order.
+     *
+     * Exceptions thrown by the body of a loop are passed on to the caller, once
+     * all chunks of the loop have completed.
+     */
+    class ThreadPool {
+
+        /// Type of task run by the pool
+        typedef std::function<void()> Task;
+
+        /// Queue of tasks owned by a worker thread
+        struct Queue {
+            /// Mutex guarding the access to the tasks
+            std::mutex mutex;
+            /// Pending tasks
+            std::deque<Task> tasks;
+        };
+
+        /// Queues of tasks, one per worker thread
+        std::vector<std::unique_ptr<Queue> > itsQueues;
+        /// Worker threads
+        std::vector<std::thread> itsWorkers;
+        /// Mutex for putting idle worker threads to sleep
+        std::mutex itsMutex;
+        /// Condition on which idle worker threads are waiting
+        std::condition_variable itsWakeup;
+        /// Number of tasks queued
+        std::atomic<std::size_t> itsNofQueued;
+        /// Queue to which to submit the next task from outside the pool
+        std::atomic<std::size_t> itsNext;
+        /// Shut down the worker threads?
+        bool itsStop;
+
+        /// Main loop of worker thread `index`
+        void work (const std::size_t& index);
+
+        /// Submit a task for execution
+        void submit (Task task);
+
+        /*!
+         * \brief Run a single pending task, if any
+         * \return Has a task been run?
+         */
+        bool runTask ();
+
+    public:
+
+        /// Upper limit for the number of threads
+        static const std::size_t maxNofThreads = 256;
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param nofThreads -- Number of threads, including the calling thread;
+         *        0 selects the number of hardware threads.
+         */
+        explicit ThreadPool (const std::size_t& nofThreads=0);
+
+        /// Destructor, joining the worker threads
+        ~ThreadPool ();
+
+        // === Parameter access ================================================
+
+        /// Get the number of threads, including the calling thread
+        inline std::size_t nofThreads () const {
+            return itsWorkers.size() + 1;
+        }
+
+        // === Public methods ==================================================
+
+        /*!
+         * \brief Run `body` for consecutive chunks of the range [first,last)
+         * \param first -- Begin of the range.
+         * \param last  -- End of the range.
+         * \param body  -- Function object, called as `body(begin, end)` for each
+         *        chunk [begin,end); chunks may be processed concurrently.
+         * \param grain -- Number of elements per chunk; 0 selects a size giving
+         *        a few chunks per thread.
+         */
+        template <typename Body>
+        void parallelFor (const std::size_t& first,
+                          const std::size_t& last,
+                          Body body,
+                          std::size_t grain=0) {
+            if (!(first < last)) {
+                return;
+            }
+
+            std::size_t size = last - first;
+            if (grain == 0) {
+                grain = std::max<std::size_t>(1, size/(4*nofThreads()));
+            }
+            std::size_t nofChunks = (size + grain - 1)/grain;
+
+            if (nofChunks == 1 || itsWorkers.empty()) {
+                body(first, last);
+                return;
+            }
+
+            std::atomic<std::size_t> remaining (nofChunks-1);
+            std::exception_ptr error;
+            std::mutex errorMutex;
+
+            for (std::size_t n=1; n<nofChunks; ++n) {
+                std::size_t begin = first + n*grain;
+                std::size_t end   = std::min(begin+grain, last);
+                submit([&, begin, end] () {
+                        try {
+                            body(begin, end);
+                        } catch (...) {
+                            std::lock_guard<std::mutex> lock (errorMutex);
+                            if (!error) {
+                                error = std::current_exception();
+                            }
+                        }
+                        --remaining;
+                    });
+            }
+
+            // Process the first chunk right away, then help with the others
+            try {
+                body(first, std::min(first+grain, last));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock (errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+            while (remaining > 0) {
+                if (!runTask()) {
+                    std::this_thread::yield();
+                }
+            }
+
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        /*!
+         * \brief Reduce the range [first,last) chunk by chunk
+         * \param first    -- Begin of the range.
+         * \param last     -- End of the range.
+         * \param identity -- Identity element of the reduction.
+         * \param map      -- Function object, called as `map(begin, end)` for
+         *        each chunk [begin,end), returning the result for the chunk.
+         * \param reduce   -- Function object combining two results.
+         * \param grain    -- Number of elements per chunk, see parallelFor().
+         * \return Results of the chunks, combined in order of the chunks.
+         */
+        template <typename T, typename Map, typename Reduce>
+        T parallelReduce (const std::size_t& first,
+                          const std::size_t& last,
+                          const T& identity,
+                          Map map,
+                          Reduce reduce,
+                          std::size_t grain=0) {
+            if (!(first < last)) {
+                return identity;
+            }
+            if (grain == 0) {
+                grain = std::max<std::size_t>(1, (last-first)/(4*nofThreads()));
+            }
+
+            std::size_t nofChunks = (last - first + grain - 1)/grain;
+            std::vector<T> results (nofChunks, identity);
+
+            parallelFor(0, nofChunks, [&] (std::size_t begin, std::size_t end) {
+                    for (std::size_t n=begin; n<end; ++n) {
+                        results[n] = map(first + n*grain, std::min(first + (n+1)*grain, last));
+                    }
+                }, 1);
+
+            T result = identity;
+            for (auto it=results.begin(); it!=results.end(); ++it) {
+                result = reduce(result, *it);
+            }
+
+            return result;
+        }
+
+        /*!
+         * \brief Stable sort of the range [first,last)
+         * \param first -- Random access iterator to the first element.
+         * \param last  -- Random access iterator past the last element.
+         * \param comp  -- Comparison function object.
+         *
+         * The range is split into one chunk per thread, which are sorted
+         * concurrently and then merged pairwise; small ranges are sorted by
+         * the calling thread.
+         */
+        template <typename Iterator, typename Compare>
+        void parallelSort (Iterator first,
+                           Iterator last,
+                           Compare comp) {
+            std::size_t size = last - first;
+
+            if (itsWorkers.empty() || size < 65536) {
+                std::stable_sort(first, last, comp);
+                return;
+            }
+
+            std::size_t width = (size + nofThreads() - 1)/nofThreads();
+
+            parallelFor(0, size, [&] (std::size_t begin, std::size_t end) {
+                    std::stable_sort(first+begin, first+end, comp);
+                }, width);
+
+            for (; width<size; width*=2) {
+                std::size_t nofPairs = (size + 2*width - 1)/(2*width);
+                parallelFor(0, nofPairs, [&] (std::size_t begin, std::size_t end) {
+                        for (std::size_t n=begin; n<end; ++n) {
+                            std::size_t middle = std::min(2*n*width + width, size);
+                            std::inplace_merge(first + 2*n*width,
+                                               first + middle,
+                                               first + std::min(2*n*width + 2*width, size),
+                                               comp);
+                        }
+                    }, 1);
+            }
+        }
+
+        /// Stable sort of the range [first,last), using `operator<`
+        template <typename Iterator>
+        void parallelSort (Iterator first,
+                           Iterator last) {
+            parallelSort(first, last, [] (const typename std::iterator_traits<Iterator>::value_type& a,
+                                          const typename std::iterator_traits<Iterator>::value_type& b) {
+                             return a < b;
+                         });
+        }
+
+        // === Public static methods ===========================================
+
+        /// Get the process-wide thread pool
+        static ThreadPool& global ();
+
+        /*!
+         * \brief Set the number of threads of the process-wide thread pool
+         * \param nofThreads -- Number of threads, including the calling thread;
+         *        0 selects the number of hardware threads.
+         *
+         * Replaces the process-wide pool, hence must not be called while any
+         * parallel section is running.
+         */
+        static void setNofThreads (const std::size_t& nofThreads);
+
+    };  //  class ThreadPool -- END
+
+}  //  namespace cgi -- END
+
+#endif
@@ -0,0 +1,231 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+
+#include "LogBuffer.h"
+#include "TimeIndex.h"
+
+namespace cgi {
+
+    /// Identifier at the start of the sidecar file, including format version
+    static const char sidecarMagic[8] = {'C', 'G', 'I', 'I', 'D', 'X', '0', '1'};
+
+    /*!
+     * \brief Get size and modification time of a file
+     * \return Could the information be retrieved?
+     */
+    static bool fileStatus (const std::string& filename,
+                            std::int64_t& size,
+                            std::int64_t& modified)
+    {
+        struct stat info;
+        if (stat(filename.c_str(), &info) != 0) {
+            return false;
+        }
+        size     = info.st_size;
+        modified = info.st_mtime;
+        return true;
+    }
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    TimeIndex::TimeIndex (const std::size_t& stride)
+        : itsStride(stride > 0 ? stride : 1),
+          itsFileSize(0),
+          itsModified(0),
+          itsReference(0),
+          itsIsSorted(true)
+    {
+    }
+
+    // =========================================================================
+    //
+    //  Public methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                     build
+
+    bool TimeIndex::build (const std::string& filename)
+    {
+        itsBlocks.clear();
+        itsIsSorted = true;
+
+        LogBuffer buffer (filename);
+        if (!buffer.isOpen() || !fileStatus(filename, itsFileSize, itsModified)) {
+            return false;
+        }
+        itsReference = buffer.reference();
+
+        std::size_t n           = 0;
+        std::int64_t timeBefore = 0;
+
+        for (auto it=buffer.begin(); it!=buffer.end(); ++it, ++n) {
+            LogEntryView entry = *it;
+            std::int64_t timeEntry = entry.timeEntry().rawtime();
+            std::int64_t timeExit  = entry.timeExit().rawtime();
+
+            if (n%itsStride == 0) {
+                Block block;
+                block.offset     = it.line() - buffer.data();
+                block.firstEntry = timeEntry;
+                block.maxExit    = timeExit;
+                itsBlocks.push_back(block);
+            } else {
+                itsBlocks.back().maxExit = std::max(itsBlocks.back().maxExit, timeExit);
+            }
+
+            if (n > 0 && timeEntry < timeBefore) {
+                itsIsSorted = false;
+            }
+            timeBefore = timeEntry;
+        }
+
+        return true;
+    }
+
+    //__________________________________________________________________________
+    //                                                                      load
+
+    bool TimeIndex::load (const std::string& filename)
+    {
+        std::int64_t size     = 0;
+        std::int64_t modified = 0;
+        if (!fileStatus(filename, size, modified)) {
+            return false;
+        }
+
+        std::ifstream infile (sidecarName(filename).c_str(), std::ios::binary);
+        if (!infile.is_open()) {
+            return false;
+        }
+
+        char magic[8];
+        std::int64_t header[6];
+        infile.read(magic, sizeof(magic));
+        infile.read(reinterpret_cast<char*>(header), sizeof(header));
+
+        if (!infile
+            || std::memcmp(magic, sidecarMagic, sizeof(magic)) != 0
+            || header[0] != size
+            || header[1] != modified
+            || header[2] != std::int64_t(LogEntryView::startOfDay())
+            || header[3] <= 0
+            || header[5] < 0) {
+            return false;
+        }
+
+        // The block count has to match the remainder of the sidecar exactly
+        std::streamoff offset = infile.tellg();
+        infile.seekg(0, std::ios::end);
+        std::streamoff remaining = infile.tellg() - offset;
+        infile.seekg(offset);
+        if (!infile || remaining < 0
+            || std::uint64_t(header[5]) != std::uint64_t(remaining)/sizeof(Block)
+            || std::uint64_t(remaining) % sizeof(Block) != 0) {
+            return false;
+        }
+
+        std::vector<Block> blocks (header[5]);
+        infile.read(reinterpret_cast<char*>(blocks.data()), blocks.size()*sizeof(Block));
+        if (!infile) {
+            return false;
+        }
+
+        itsFileSize  = header[0];
+        itsModified  = header[1];
+        itsReference = header[2];
+        itsStride    = header[3];
+        itsIsSorted  = header[4] != 0;
+        itsBlocks.swap(blocks);
+
+        return true;
+    }
+
+    //__________________________________________________________________________
+    //                                                                      save
+
+    bool TimeIndex::save (const std::string& filename) const
+    {
+        std::ofstream outfile (sidecarName(filename).c_str(), std::ios::binary | std::ios::trunc);
+        if (!outfile.is_open()) {
+            return false;
+        }
+
+        std::int64_t header[6] = {itsFileSize,
+                                  itsModified,
+                                  itsReference,
+                                  std::int64_t(itsStride),
+                                  itsIsSorted ? 1 : 0,
+                                  std::int64_t(itsBlocks.size())};
+
+        outfile.write(sidecarMagic, sizeof(sidecarMagic));
+        outfile.write(reinterpret_cast<const char*>(header), sizeof(header));
+        outfile.write(reinterpret_cast<const char*>(itsBlocks.data()), itsBlocks.size()*sizeof(Block));
+
+        return bool(outfile);
+    }
+
+    //__________________________________________________________________________
+    //                                                                    region
+
+    std::pair<std::size_t,std::size_t> TimeIndex::region (const TimeWindow& window) const
+    {
+        std::pair<std::size_t,std::size_t> result (0, itsFileSize);
+
+        if (!itsIsSorted || itsBlocks.empty()) {
+            return result;
+        }
+
+        // Skip leading blocks in which all visits end before the window opens
+        std::size_t first = 0;
+        while (first < itsBlocks.size() && !window.admitsExit(itsBlocks[first].maxExit)) {
+            ++first;
+        }
+
+        // Stop at the first block starting after the window closes
+        std::size_t last = first;
+        while (last < itsBlocks.size() && window.admitsEntry(itsBlocks[last].firstEntry)) {
+            ++last;
+        }
+
+        result.first  = first < itsBlocks.size() ? itsBlocks[first].offset : itsFileSize;
+        result.second = last  < itsBlocks.size() ? itsBlocks[last].offset  : itsFileSize;
+
+        return result;
+    }
+
+    // =========================================================================
+    //
+    //  Public static methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                    update
+
+    bool TimeIndex::update (const std::string& filename,
+                            const std::size_t& stride)
+    {
+        TimeIndex index (stride);
+
+        if (index.load(filename)) {
+            return true;
+        }
+
+        return index.build(filename) && index.save(filename);
+    }
+
+}  //  namespace cgi -- END
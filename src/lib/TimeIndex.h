@@ -0,0 +1,165 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_TIMEINDEX_H
+#define CGI_TIMEINDEX_H
+
+/*!
+ * \file TimeIndex.h
+ * \brief Class for a sparse index into a log file sorted by time of entry
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "TimeWindow.h"
+
+namespace cgi {
+
+    /*!
+     * \class TimeIndex
+     * \brief Sparse index into a log file sorted by time of entry
+     * \test test_TimeIndex.cc
+     *
+     * The log is split into blocks of `stride` consecutive log entries; for
+     * every block the index records the byte offset of its first line, the
+     * time of entry of its first line and the latest time of exit within the
+     * block. For a log written in order of entry time this allows to determine
+     * the region of the file holding all visits which may overlap with a given
+     * time window (see region()), such that only this region needs to be read.
+     * If the log turns out not to be sorted, the index always refers to the
+     * whole file.
+     *
+     * The index is kept as sidecar file next to the log (see sidecarName()),
+     * along with the size and modification time of the log as well as the
+     * start of the day to which times of day were referring when building the
+     * index; if any of those does not match, the index is considered stale.
+     * Times are given in seconds since the epoch.
+     */
+    class TimeIndex {
+
+    public:
+
+        /*!
+         * \struct Block
+         * \brief Entry of the index, describing a block of log entries
+         */
+        struct Block {
+            /// Byte offset of the first line of the block
+            std::int64_t offset;
+            /// Time of entry of the first log entry of the block
+            std::int64_t firstEntry;
+            /// Latest time of exit of the log entries within the block
+            std::int64_t maxExit;
+        };
+
+    private:
+
+        /// Number of log entries per block
+        std::size_t itsStride;
+        /// Size of the log file (in bytes)
+        std::int64_t itsFileSize;
+        /// Modification time of the log file
+        std::int64_t itsModified;
+        /// Start of the day, to which times of day were referring
+        std::int64_t itsReference;
+        /// Is the log sorted by time of entry?
+        bool itsIsSorted;
+        /// Blocks of log entries
+        std::vector<Block> itsBlocks;
+
+    public:
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Default constructor
+         * \param stride -- Number of log entries per block.
+         */
+        TimeIndex (const std::size_t& stride=1024);
+
+        // === Parameter access ================================================
+
+        /// Get the number of log entries per block
+        inline std::size_t stride () const {
+            return itsStride;
+        }
+
+        /// Get the size of the indexed log file (in bytes)
+        inline std::int64_t fileSize () const {
+            return itsFileSize;
+        }
+
+        /// Is the indexed log sorted by time of entry?
+        inline bool isSorted () const {
+            return itsIsSorted;
+        }
+
+        /// Get the number of blocks
+        inline std::size_t nofBlocks () const {
+            return itsBlocks.size();
+        }
+
+        /// Get block `n`
+        inline const Block& operator[] (const std::size_t& n) const {
+            return itsBlocks[n];
+        }
+
+        // === Public methods ==================================================
+
+        /*!
+         * \brief Build the index by scanning the log file
+         * \param filename -- Name of the log file.
+         * \return Could the log file be read?
+         */
+        bool build (const std::string& filename);
+
+        /*!
+         * \brief Load the index from the sidecar of the log file
+         * \param filename -- Name of the log file (not of the sidecar).
+         * \return Has an up-to-date index been found?
+         */
+        bool load (const std::string& filename);
+
+        /*!
+         * \brief Write the index to the sidecar of the log file
+         * \param filename -- Name of the log file (not of the sidecar).
+         * \return Could the sidecar be written?
+         */
+        bool save (const std::string& filename) const;
+
+        /*!
+         * \brief Get the region of the log file to read for a time window
+         * \param window -- Time window (in seconds).
+         * \return Byte range [first,last) of the log file, containing all log
+         *         entries which may overlap with the window.
+         */
+        std::pair<std::size_t,std::size_t> region (const TimeWindow& window) const;
+
+        // === Public static methods ===========================================
+
+        /// Get the name of the sidecar file for log file `filename`
+        static inline std::string sidecarName (const std::string& filename) {
+            return filename + ".idx";
+        }
+
+        /*!
+         * \brief Make sure an up-to-date sidecar exists for a log file
+         * \param filename -- Name of the log file.
+         * \param stride   -- Number of log entries per block, if (re-)built.
+         * \return Is an up-to-date sidecar available?
+         */
+        static bool update (const std::string& filename,
+                            const std::size_t& stride=1024);
+
+    };  //  class TimeIndex -- END
+
+}  //  namespace cgi -- END
+
+#endif
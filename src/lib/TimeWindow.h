@@ -0,0 +1,128 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_TIMEWINDOW_H
+#define CGI_TIMEWINDOW_H
+
+/*!
+ * \file TimeWindow.h
+ * \brief Class for a time window used to filter log entries during ingest
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+namespace cgi {
+
+    /*!
+     * \class TimeWindow
+     * \brief Time window \f$ [begin, end) \f$ used to filter log entries
+     * \test test_TimeWindow.cc
+     *
+     * Only visits overlapping with the window can affect the number of
+     * visitors within the window; all other log entries can be dropped while
+     * reading the log. The check is split in two, such that entries starting
+     * after the window are rejected based on the time of entry alone, before
+     * the remainder of the entry is decoded. Both bounds are optional; times
+     * are given in ticks of the clock used for storing the log (seconds by
+     * default, see cgi::TickClock).
+     *
+     * The number of visitors at any point in time outside the window never
+     * exceeds the number of visitors at the nearest edge of the window, hence
+     * statistics restricted to the window remain exact.
+     */
+    class TimeWindow {
+
+        /// Begin of the window (inclusive)
+        std::int64_t itsBegin;
+        /// End of the window (exclusive)
+        std::int64_t itsEnd;
+
+    public:
+
+        // === Construction ====================================================
+
+        /// Default constructor, for an unbounded window
+        TimeWindow () : itsBegin(std::numeric_limits<std::int64_t>::min()),
+                        itsEnd(std::numeric_limits<std::int64_t>::max()) {}
+
+        /*!
+         * \brief Argumented constructor
+         * \param begin -- Begin of the window (inclusive).
+         * \param end   -- End of the window (exclusive).
+         */
+        TimeWindow (const std::int64_t& begin,
+                    const std::int64_t& end) : itsBegin(begin),
+                                               itsEnd(end) {}
+
+        // === Parameter access ================================================
+
+        /// Get the begin of the window
+        inline std::int64_t begin () const {
+            return itsBegin;
+        }
+
+        /// Set the begin of the window
+        inline void setBegin (const std::int64_t& begin) {
+            itsBegin = begin;
+        }
+
+        /// Get the end of the window
+        inline std::int64_t end () const {
+            return itsEnd;
+        }
+
+        /// Set the end of the window
+        inline void setEnd (const std::int64_t& end) {
+            itsEnd = end;
+        }
+
+        /// Is the begin of the window bounded?
+        inline bool hasBegin () const {
+            return itsBegin != std::numeric_limits<std::int64_t>::min();
+        }
+
+        /// Is the end of the window bounded?
+        inline bool hasEnd () const {
+            return itsEnd != std::numeric_limits<std::int64_t>::max();
+        }
+
+        /// Is the window bounded on either side?
+        inline bool isBounded () const {
+            return hasBegin() || hasEnd();
+        }
+
+        // === Public methods ==================================================
+
+        /// Can a visit entering at `timeEntry` overlap with the window?
+        inline bool admitsEntry (const std::int64_t& timeEntry) const {
+            return timeEntry < itsEnd;
+        }
+
+        /// Can a visit leaving at `timeExit` overlap with the window?
+        inline bool admitsExit (const std::int64_t& timeExit) const {
+            return timeExit > itsBegin;
+        }
+
+        /// Does the visit \f$ [t_{entry}, t_{exit}) \f$ overlap with the window?
+        inline bool admits (const std::int64_t& timeEntry,
+                            const std::int64_t& timeExit) const {
+            return admitsEntry(timeEntry) && admitsExit(timeExit);
+        }
+
+    };  //  class TimeWindow -- END
+
+}  //  namespace cgi -- END
+
+/// Overloading of output operator for cgi::TimeWindow class
+inline std::ostream& operator<< (std::ostream& os, const cgi::TimeWindow& obj)
+{
+    os << "[" << obj.begin() << ", " << obj.end() << ")";
+
+    return os;
+}
+
+#endif
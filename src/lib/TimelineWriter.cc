@@ -0,0 +1,402 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#include <cstdint>
+
+#include "TimelineWriter.h"
+
+namespace cgi {
+
+    /// Identifier at the start of a binary timeline, including format version
+    static const char binaryMagic[8] = {'C', 'G', 'I', 'T', 'L', '0', '0', '1'};
+
+    /// Identifier at the start of binary time bins, including format version
+    static const char binaryBinsMagic[8] = {'C', 'G', 'I', 'B', 'N', '0', '0', '1'};
+
+    // =========================================================================
+    //
+    //  Construction
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                            TimelineWriter
+
+    TimelineWriter::TimelineWriter (OutputBuffer& output,
+                                    const Format& format,
+                                    const std::string& timeformat)
+        : itsOutput(output),
+          itsFormat(format),
+          itsTimeformat(timeformat),
+          itsLastTime(0)
+    {
+    }
+
+    // =========================================================================
+    //
+    //  Public methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                     write
+
+    void TimelineWriter::write (const std::vector<TimePoint>& visitorsPerTime,
+                                const IntervalSet<DateTime,int>& visitorsMax)
+    {
+        switch (itsFormat) {
+        case Csv:
+            writeCsv(visitorsPerTime, visitorsMax);
+            break;
+        case JsonLines:
+            writeJsonLines(visitorsPerTime, visitorsMax);
+            break;
+        case Binary:
+            writeBinary(visitorsPerTime, visitorsMax);
+            break;
+        default:
+            writeChallenge(visitorsPerTime, visitorsMax);
+            break;
+        };
+    }
+
+    //__________________________________________________________________________
+    //                                                                     write
+
+    void TimelineWriter::write (const OccupancyBins& bins,
+                                const IntervalSet<DateTime,int>& visitorsMax)
+    {
+        switch (itsFormat) {
+        case Csv:
+            itsOutput.write("kind,begin,end,min,mean,max\n");
+            break;
+        case Binary:
+            writeBinaryBins(bins, visitorsMax);
+            return;
+        case JsonLines:
+            break;
+        default:
+            itsOutput.write("\n Visitors per time interval (min;mean;max):\n");
+            break;
+        };
+
+        for (auto it=bins.begin(); it!=bins.end(); ++it) {
+            if (it->covered == 0) {
+                continue;
+            }
+            switch (itsFormat) {
+            case Csv:
+                itsOutput.write("bin,");
+                itsOutput.writeInt(it->begin);
+                itsOutput.put(',');
+                itsOutput.writeInt(it->end);
+                itsOutput.put(',');
+                itsOutput.writeInt(it->min);
+                itsOutput.put(',');
+                itsOutput.writeFixed(it->mean());
+                itsOutput.put(',');
+                itsOutput.writeInt(it->max);
+                itsOutput.put('\n');
+                break;
+            case JsonLines:
+                itsOutput.write("{\"kind\":\"bin\",\"begin\":");
+                itsOutput.writeInt(it->begin);
+                itsOutput.write(",\"end\":");
+                itsOutput.writeInt(it->end);
+                itsOutput.write(",\"min\":");
+                itsOutput.writeInt(it->min);
+                itsOutput.write(",\"mean\":");
+                itsOutput.writeFixed(it->mean());
+                itsOutput.write(",\"max\":");
+                itsOutput.writeInt(it->max);
+                itsOutput.write("}\n");
+                break;
+            default:
+                itsOutput.put('\t');
+                writeTime(DateTime(std::time_t(it->begin)));
+                itsOutput.put('-');
+                writeTime(DateTime(std::time_t(it->end)));
+                itsOutput.put(';');
+                itsOutput.writeInt(it->min);
+                itsOutput.put(';');
+                itsOutput.writeFixed(it->mean());
+                itsOutput.put(';');
+                itsOutput.writeInt(it->max);
+                itsOutput.put('\n');
+                break;
+            };
+        }
+
+        switch (itsFormat) {
+        case Csv:
+            writeCsvMax(visitorsMax, 3);
+            break;
+        case JsonLines:
+            writeJsonLinesMax(visitorsMax);
+            break;
+        default:
+            writeChallengeMax(visitorsMax);
+            break;
+        };
+    }
+
+    // =========================================================================
+    //
+    //  Public static methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                               parseFormat
+
+    bool TimelineWriter::parseFormat (const std::string& name,
+                                      Format& format)
+    {
+        if (name == "challenge") {
+            format = Challenge;
+        } else if (name == "csv") {
+            format = Csv;
+        } else if (name == "json") {
+            format = JsonLines;
+        } else if (name == "binary") {
+            format = Binary;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    // =========================================================================
+    //
+    //  Private methods
+    //
+    // =========================================================================
+
+    //__________________________________________________________________________
+    //                                                                 writeTime
+
+    void TimelineWriter::writeTime (const DateTime& time)
+    {
+        /* The end of a time interval is the begin of the next one, hence
+           keeping the last result halves the conversions to calendar time. */
+        if (itsLastString.empty() || time.rawtime() != itsLastTime) {
+            itsLastTime   = time.rawtime();
+            itsLastString = time.asString(itsTimeformat);
+        }
+        itsOutput.write(itsLastString);
+    }
+
+    //__________________________________________________________________________
+    //                                                            writeChallenge
+
+    void TimelineWriter::writeChallenge (const std::vector<TimePoint>& visitorsPerTime,
+                                         const IntervalSet<DateTime,int>& visitorsMax)
+    {
+        /* ------------------------------------------------------------ */
+        /*  Output 1 : Number of visitors per time interval             */
+
+        itsOutput.write("\n Visitors per time interval:\n");
+
+        for (std::size_t n=1; n<visitorsPerTime.size(); ++n) {
+            itsOutput.put('\t');
+            writeTime(visitorsPerTime[n-1].time());
+            itsOutput.put('-');
+            writeTime(visitorsPerTime[n].time());
+            itsOutput.put(';');
+            itsOutput.writeInt(visitorsPerTime[n-1].count());
+            itsOutput.put('\n');
+        }
+
+        /* ------------------------------------------------------------ */
+        /*  Output 2 : maximum number of visitors and corresponding     */
+        /*             time interval(s)                                 */
+
+        writeChallengeMax(visitorsMax);
+    }
+
+    //__________________________________________________________________________
+    //                                                         writeChallengeMax
+
+    void TimelineWriter::writeChallengeMax (const IntervalSet<DateTime,int>& visitorsMax)
+    {
+        itsOutput.write("\n Maximum number of visitors:\n");
+
+        for (auto it=visitorsMax.begin(); it!=visitorsMax.end(); ++it) {
+            writeTime(it->begin());
+            itsOutput.write(" ... ");
+            writeTime(it->end());
+            itsOutput.write("  =>  ");
+            itsOutput.writeInt(it->value());
+            itsOutput.put('\n');
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                                  writeCsv
+
+    void TimelineWriter::writeCsv (const std::vector<TimePoint>& visitorsPerTime,
+                                   const IntervalSet<DateTime,int>& visitorsMax)
+    {
+        itsOutput.write("kind,begin,end,visitors\n");
+
+        for (std::size_t n=1; n<visitorsPerTime.size(); ++n) {
+            itsOutput.write("step,");
+            itsOutput.writeInt(visitorsPerTime[n-1].time().rawtime());
+            itsOutput.put(',');
+            itsOutput.writeInt(visitorsPerTime[n].time().rawtime());
+            itsOutput.put(',');
+            itsOutput.writeInt(visitorsPerTime[n-1].count());
+            itsOutput.put('\n');
+        }
+
+        writeCsvMax(visitorsMax);
+    }
+
+    //__________________________________________________________________________
+    //                                                               writeCsvMax
+
+    void TimelineWriter::writeCsvMax (const IntervalSet<DateTime,int>& visitorsMax,
+                                      const int& columns)
+    {
+        for (auto it=visitorsMax.begin(); it!=visitorsMax.end(); ++it) {
+            itsOutput.write("max,");
+            itsOutput.writeInt(it->begin().rawtime());
+            itsOutput.put(',');
+            itsOutput.writeInt(it->end().rawtime());
+            itsOutput.put(',');
+            itsOutput.writeInt(it->value());
+            for (int n=1; n<columns; ++n) {
+                itsOutput.put(',');
+                itsOutput.writeInt(it->value());
+            }
+            itsOutput.put('\n');
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                            writeJsonLines
+
+    void TimelineWriter::writeJsonLines (const std::vector<TimePoint>& visitorsPerTime,
+                                         const IntervalSet<DateTime,int>& visitorsMax)
+    {
+        for (std::size_t n=1; n<visitorsPerTime.size(); ++n) {
+            itsOutput.write("{\"kind\":\"step\",\"begin\":");
+            itsOutput.writeInt(visitorsPerTime[n-1].time().rawtime());
+            itsOutput.write(",\"end\":");
+            itsOutput.writeInt(visitorsPerTime[n].time().rawtime());
+            itsOutput.write(",\"visitors\":");
+            itsOutput.writeInt(visitorsPerTime[n-1].count());
+            itsOutput.write("}\n");
+        }
+
+        writeJsonLinesMax(visitorsMax);
+    }
+
+    //__________________________________________________________________________
+    //                                                         writeJsonLinesMax
+
+    void TimelineWriter::writeJsonLinesMax (const IntervalSet<DateTime,int>& visitorsMax)
+    {
+        for (auto it=visitorsMax.begin(); it!=visitorsMax.end(); ++it) {
+            itsOutput.write("{\"kind\":\"max\",\"begin\":");
+            itsOutput.writeInt(it->begin().rawtime());
+            itsOutput.write(",\"end\":");
+            itsOutput.writeInt(it->end().rawtime());
+            itsOutput.write(",\"visitors\":");
+            itsOutput.writeInt(it->value());
+            itsOutput.write("}\n");
+        }
+    }
+
+    //__________________________________________________________________________
+    //                                                               writeBinary
+
+    void TimelineWriter::writeBinary (const std::vector<TimePoint>& visitorsPerTime,
+                                      const IntervalSet<DateTime,int>& visitorsMax)
+    {
+        std::size_t nofSteps = visitorsPerTime.size();
+        std::vector<std::int64_t> times (nofSteps);
+        std::vector<std::int32_t> counts (nofSteps + nofSteps%2, 0);
+
+        for (std::size_t n=0; n<nofSteps; ++n) {
+            times[n]  = visitorsPerTime[n].time().rawtime();
+            counts[n] = visitorsPerTime[n].count();
+        }
+
+        std::int64_t header[3] = { std::int64_t(nofSteps),
+                                   std::int64_t(visitorsMax.size()),
+                                   visitorsMax.empty() ? 0 : visitorsMax[0].value() };
+
+        itsOutput.write(binaryMagic, sizeof(binaryMagic));
+        itsOutput.write(reinterpret_cast<const char*>(header), sizeof(header));
+        itsOutput.write(reinterpret_cast<const char*>(times.data()),
+                        times.size()*sizeof(std::int64_t));
+        itsOutput.write(reinterpret_cast<const char*>(counts.data()),
+                        counts.size()*sizeof(std::int32_t));
+
+        writeBinaryMax(visitorsMax);
+    }
+
+    //__________________________________________________________________________
+    //                                                            writeBinaryMax
+
+    void TimelineWriter::writeBinaryMax (const IntervalSet<DateTime,int>& visitorsMax)
+    {
+        std::vector<std::int64_t> intervals;
+        intervals.reserve(2*visitorsMax.size());
+
+        for (auto it=visitorsMax.begin(); it!=visitorsMax.end(); ++it) {
+            intervals.push_back(it->begin().rawtime());
+            intervals.push_back(it->end().rawtime());
+        }
+
+        itsOutput.write(reinterpret_cast<const char*>(intervals.data()),
+                        intervals.size()*sizeof(std::int64_t));
+    }
+
+    //__________________________________________________________________________
+    //                                                           writeBinaryBins
+
+    void TimelineWriter::writeBinaryBins (const OccupancyBins& bins,
+                                          const IntervalSet<DateTime,int>& visitorsMax)
+    {
+        std::vector<std::int64_t> begins;
+        std::vector<double> means;
+        std::vector<std::int32_t> minima;
+        std::vector<std::int32_t> maxima;
+
+        // As for the text formats, bins not covered by any step are skipped
+        for (auto it=bins.begin(); it!=bins.end(); ++it) {
+            if (it->covered == 0) {
+                continue;
+            }
+            begins.push_back(it->begin);
+            means.push_back(it->mean());
+            minima.push_back(it->min);
+            maxima.push_back(it->max);
+        }
+
+        std::size_t nofBins = begins.size();
+
+        std::int64_t header[4] = { std::int64_t(nofBins),
+                                   std::int64_t(visitorsMax.size()),
+                                   visitorsMax.empty() ? 0 : visitorsMax[0].value(),
+                                   bins.width() };
+
+        itsOutput.write(binaryBinsMagic, sizeof(binaryBinsMagic));
+        itsOutput.write(reinterpret_cast<const char*>(header), sizeof(header));
+        itsOutput.write(reinterpret_cast<const char*>(begins.data()),
+                        begins.size()*sizeof(std::int64_t));
+        itsOutput.write(reinterpret_cast<const char*>(means.data()),
+                        means.size()*sizeof(double));
+        itsOutput.write(reinterpret_cast<const char*>(minima.data()),
+                        minima.size()*sizeof(std::int32_t));
+        itsOutput.write(reinterpret_cast<const char*>(maxima.data()),
+                        maxima.size()*sizeof(std::int32_t));
+
+        writeBinaryMax(visitorsMax);
+    }
+
+}  //  namespace cgi -- END
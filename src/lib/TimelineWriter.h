@@ -0,0 +1,198 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_TIMELINEWRITER_H
+#define CGI_TIMELINEWRITER_H
+
+/*!
+ * \file TimelineWriter.h
+ * \brief Class for writing visitor statistics in one of several formats
+ */
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "DateTime.h"
+#include "IntervalSet.h"
+#include "OccupancyBins.h"
+#include "OutputBuffer.h"
+#include "TimePoint.h"
+
+namespace cgi {
+
+    /*!
+     * \class TimelineWriter
+     * \brief Write the number of visitors per time interval and the maxima
+     * \test test_TimelineWriter.cc
+     *
+     * The statistics -- the number of visitors per point in time, as recorded
+     * by cgi::OccupancySweep, and the time intervals with the maximum number
+     * of visitors -- are written to a cgi::OutputBuffer in one of the formats
+     *
+     * \li `Challenge`: the human-readable layout of the programming challenge,
+     *     i.e. one `start-end;count` row per time interval, followed by the
+     *     maxima; times are formatted as per timeformat().
+     * \li `Csv`: a table `kind,begin,end,visitors`, with one `step` row per
+     *     time interval followed by one `max` row per maximum.
+     * \li `JsonLines`: the same rows as one JSON object per line.
+     * \li `Binary`: the raw timeline, see writeBinary().
+     *
+     * In the machine-readable formats times are given as seconds since the
+     * epoch, which avoids any conversion to calendar time.
+     *
+     * Instead of one row per point in time, the number of visitors can also be
+     * written downsampled to time bins (see cgi::OccupancyBins), with one row
+     * `start-end;min;mean;max` -- resp. columns `min,mean,max` -- per bin.
+     */
+    class TimelineWriter {
+
+    public:
+
+        /// Output formats
+        enum Format {
+            /// Layout of the programming challenge
+            Challenge,
+            /// Comma-separated values
+            Csv,
+            /// One JSON object per line
+            JsonLines,
+            /// Raw binary timeline
+            Binary
+        };
+
+    private:
+
+        /// Buffer to write to
+        OutputBuffer& itsOutput;
+        /// Output format
+        Format itsFormat;
+        /// Format specification for times in the challenge layout
+        std::string itsTimeformat;
+        /// Point in time most recently formatted
+        std::time_t itsLastTime;
+        /// Formatted representation of itsLastTime
+        std::string itsLastString;
+
+        /// Write a point in time, as per the time format
+        void writeTime (const DateTime& time);
+
+        /// Write in the layout of the programming challenge
+        void writeChallenge (const std::vector<TimePoint>& visitorsPerTime,
+                             const IntervalSet<DateTime,int>& visitorsMax);
+
+        /// Write as comma-separated values
+        void writeCsv (const std::vector<TimePoint>& visitorsPerTime,
+                       const IntervalSet<DateTime,int>& visitorsMax);
+
+        /// Write as one JSON object per line
+        void writeJsonLines (const std::vector<TimePoint>& visitorsPerTime,
+                             const IntervalSet<DateTime,int>& visitorsMax);
+
+        /*!
+         * \brief Write the raw binary timeline
+         *
+         * All values are stored in native byte order: the identifier
+         * ``CGITL001`` (8 bytes), the number of points in time \f$ N \f$, the
+         * number of maxima \f$ M \f$ and the maximum number of visitors (as
+         * 64-bit integers), followed by the \f$ N \f$ times (64-bit), the
+         * \f$ N \f$ numbers of visitors (32-bit, padded to a multiple of 8 bytes)
+         * and the \f$ M \f$ pairs of begin and end of the maxima (64-bit).
+         */
+        void writeBinary (const std::vector<TimePoint>& visitorsPerTime,
+                          const IntervalSet<DateTime,int>& visitorsMax);
+
+        /// Write the maxima in the layout of the programming challenge
+        void writeChallengeMax (const IntervalSet<DateTime,int>& visitorsMax);
+
+        /// Write the maxima as comma-separated values, with `columns` value columns
+        void writeCsvMax (const IntervalSet<DateTime,int>& visitorsMax,
+                          const int& columns=1);
+
+        /// Write the maxima as JSON objects
+        void writeJsonLinesMax (const IntervalSet<DateTime,int>& visitorsMax);
+
+        /// Write the maxima as pairs of 64-bit begin and end
+        void writeBinaryMax (const IntervalSet<DateTime,int>& visitorsMax);
+
+        /*!
+         * \brief Write time bins as raw binary data
+         *
+         * As for writeBinary(), but with identifier ``CGIBN001``, followed by
+         * the number of bins \f$ N \f$, the number of maxima \f$ M \f$, the
+         * maximum number of visitors and the width of the bins (as 64-bit
+         * integers); then the \f$ N \f$ begins of the bins (64-bit), their
+         * means (64-bit floating point), minima and maxima (32-bit each) and
+         * the \f$ M \f$ pairs of begin and end of the maxima (64-bit). As for
+         * the text formats, bins not covered by any step are skipped.
+         */
+        void writeBinaryBins (const OccupancyBins& bins,
+                              const IntervalSet<DateTime,int>& visitorsMax);
+
+    public:
+
+        // === Construction ====================================================
+
+        /*!
+         * \brief Argumented constructor
+         * \param output     -- Buffer to write to; required to outlive the writer.
+         * \param format     -- Output format.
+         * \param timeformat -- Format specification for times in the challenge
+         *        layout (see ``strftime``).
+         */
+        TimelineWriter (OutputBuffer& output,
+                        const Format& format=Challenge,
+                        const std::string& timeformat="%H:%M");
+
+        // === Parameter access ================================================
+
+        /// Get the output format
+        inline Format format () const {
+            return itsFormat;
+        }
+
+        /// Get the format specification for times in the challenge layout
+        inline const std::string& timeformat () const {
+            return itsTimeformat;
+        }
+
+        // === Public methods ==================================================
+
+        /*!
+         * \brief Write visitor statistics
+         * \param visitorsPerTime -- Number of visitors per point in time.
+         * \param visitorsMax     -- Time intervals with the maximum number of
+         *        visitors.
+         */
+        void write (const std::vector<TimePoint>& visitorsPerTime,
+                    const IntervalSet<DateTime,int>& visitorsMax);
+
+        /*!
+         * \brief Write visitor statistics, downsampled to time bins
+         * \param bins        -- Minimum, mean and maximum number of visitors
+         *        per time bin; bins not covered by any step are skipped.
+         * \param visitorsMax -- Time intervals with the maximum number of
+         *        visitors.
+         */
+        void write (const OccupancyBins& bins,
+                    const IntervalSet<DateTime,int>& visitorsMax);
+
+        // === Public static methods ===========================================
+
+        /*!
+         * \brief Get the output format from its name
+         * \param name   -- Name of the format: `challenge`, `csv`, `json` or
+         *        `binary`.
+         * \param format -- Output format.
+         * \return Is `name` a known format?
+         */
+        static bool parseFormat (const std::string& name,
+                                 Format& format);
+
+    };  //  class TimelineWriter -- END
+
+}  //  namespace cgi -- END
+
+#endif
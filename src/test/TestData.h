@@ -0,0 +1,43 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CGI_TESTDATA_H
+#define CGI_TESTDATA_H
+
+/*!
+ * \file TestData.h
+ * \brief Fixtures shared by the collections of tests
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <TimeIndex.h>
+
+//______________________________________________________________________________
+//                                                               write_test_data
+
+/*!
+ * \brief Write log data to a file in the working directory, returning its name
+ * \param filename -- Name of the file to write.
+ * \param lines    -- Log entries, one per line.
+ *
+ * A time index left over from a previous run (see cgi::TimeIndex) is removed,
+ * such that it does not refer to outdated contents.
+ */
+inline std::string write_test_data (const std::string& filename,
+                                    const std::vector<std::string>& lines)
+{
+    std::ofstream outfile (filename);
+    for (auto it=lines.begin(); it!=lines.end(); ++it) {
+        outfile << *it << "\n";
+    }
+    std::remove(cgi::TimeIndex::sidecarName(filename).c_str());
+    return filename;
+}
+
+#endif
@@ -0,0 +1,66 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_Clock.cc
+ * \brief A collection of tests for the cgi::TickClock class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_Clock
+
+#include <cstring>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <Clock.h>
+
+/// Parse string as time, using clock `C`
+template <typename C>
+typename C::tick_type parse (const std::string& str,
+                             const std::time_t& reference=0)
+{
+    return C::parse(str.data(), str.data()+str.size(), reference);
+}
+
+//______________________________________________________________________________
+//                                                                   Clock_parse
+
+/// Test parsing of time fields
+BOOST_AUTO_TEST_CASE(Clock_parse)
+{
+    BOOST_CHECK_EQUAL (parse<cgi::SecondsClock>("01:02:03"), 3723);
+    BOOST_CHECK_EQUAL (parse<cgi::SecondsClock>("01:02:03.9"), 3723);
+    BOOST_CHECK_EQUAL (parse<cgi::SecondsClock>("01:02", 100), 3820);
+
+    BOOST_CHECK_EQUAL (parse<cgi::MillisecondsClock>("01:02:03"), 3723000);
+    BOOST_CHECK_EQUAL (parse<cgi::MillisecondsClock>("01:02:03.5"), 3723500);
+    BOOST_CHECK_EQUAL (parse<cgi::MillisecondsClock>("01:02:03.123"), 3723123);
+    BOOST_CHECK_EQUAL (parse<cgi::MillisecondsClock>("01:02:03.1239"), 3723123);
+    BOOST_CHECK_EQUAL (parse<cgi::MillisecondsClock>("01:02:03."), 3723000);
+
+    /* ISO 8601 timestamps, independent of the reference */
+    std::string iso = "2026-10-17T14:03:22.123456789Z";
+    BOOST_CHECK_EQUAL (parse<cgi::SecondsClock>(iso, 100), 1792245802);
+    BOOST_CHECK_EQUAL (parse<cgi::MillisecondsClock>(iso), 1792245802123);
+    BOOST_CHECK_EQUAL (parse<cgi::NanosecondsClock>(iso), 1792245802123456789);
+}
+
+//______________________________________________________________________________
+//                                                              Clock_conversion
+
+/// Test conversion from and to cgi::DateTime
+BOOST_AUTO_TEST_CASE(Clock_conversion)
+{
+    cgi::DateTime dt (2015, 1, 2, 3, 4, 5);
+
+    BOOST_CHECK_EQUAL (cgi::SecondsClock::fromDateTime(dt), dt.rawtime());
+    BOOST_CHECK_EQUAL (cgi::MillisecondsClock::fromDateTime(dt), 1000*dt.rawtime());
+
+    BOOST_CHECK (cgi::SecondsClock::toDateTime(dt.rawtime()) == dt);
+    BOOST_CHECK (cgi::MillisecondsClock::toDateTime(1000*dt.rawtime()+999) == dt);
+
+    /* Truncation towards the past */
+    BOOST_CHECK_EQUAL (cgi::MillisecondsClock::toDateTime(-1).rawtime(), -1);
+}
@@ -0,0 +1,67 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_Dictionary.cc
+ * \brief A collection of tests for the cgi::Dictionary class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_Dictionary
+
+#include <iostream>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <Dictionary.h>
+
+//______________________________________________________________________________
+//                                                             Dictionary_encode
+
+/// Test encoding of values
+BOOST_AUTO_TEST_CASE(Dictionary_encode)
+{
+    cgi::Dictionary dict;
+    BOOST_CHECK (dict.empty());
+
+    /* Codes are assigned in order of first appearance */
+    BOOST_CHECK_EQUAL (dict.encode("staff"), 0u);
+    BOOST_CHECK_EQUAL (dict.encode("visitor"), 1u);
+    BOOST_CHECK_EQUAL (dict.encode("visitor"), 1u);
+    BOOST_CHECK_EQUAL (dict.encode("staff"), 0u);
+    BOOST_CHECK_EQUAL (dict.encode(""), 2u);
+    BOOST_CHECK_EQUAL (dict.size(), 3u);
+
+    /* Encoding from a character range */
+    std::string line = "08:00,10:00,visitor,gate-a";
+    BOOST_CHECK_EQUAL (dict.encode(line.data()+12, line.data()+19), 1u);
+    BOOST_CHECK_EQUAL (dict.encode(line.data()+12, line.data()+18), 3u);
+    BOOST_CHECK_EQUAL (dict[3], "visito");
+
+    /* Decoding */
+    BOOST_CHECK_EQUAL (dict[0], "staff");
+    BOOST_CHECK_EQUAL (dict.values()[1], "visitor");
+
+    std::cout << dict;
+}
+
+//______________________________________________________________________________
+//                                                               Dictionary_find
+
+/// Test lookup without insertion
+BOOST_AUTO_TEST_CASE(Dictionary_find)
+{
+    cgi::Dictionary dict;
+    dict.encode("gate-a");
+    dict.encode("gate-b");
+
+    BOOST_CHECK_EQUAL (dict.find("gate-b"), 1u);
+    BOOST_CHECK_EQUAL (dict.find("gate-c"), cgi::Dictionary::npos);
+    BOOST_CHECK_EQUAL (dict.size(), 2u);
+
+    dict.clear();
+    BOOST_CHECK (dict.empty());
+    BOOST_CHECK_EQUAL (dict.find("gate-a"), cgi::Dictionary::npos);
+    BOOST_CHECK_EQUAL (dict.encode("gate-b"), 0u);
+}
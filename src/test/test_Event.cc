@@ -0,0 +1,76 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_Event.cc
+ * \brief A collection of tests for the cgi::Event class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_Event
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Event.h>
+
+//______________________________________________________________________________
+//                                                             Event_constructor
+
+/// Test creation of object
+BOOST_AUTO_TEST_CASE (Event_constructor)
+{
+    std::int64_t time = 1451606400;
+
+    cgi::Event ev1 = cgi::Event();
+    BOOST_CHECK_EQUAL (ev1.key(), 0);
+
+    cgi::Event ev2 = cgi::Event(time, true);
+    BOOST_CHECK_EQUAL (ev2.time(), time);
+    BOOST_CHECK (ev2.isEntry());
+    BOOST_CHECK_EQUAL (ev2.delta(), +1);
+
+    cgi::Event ev3 = cgi::Event(time, false);
+    BOOST_CHECK_EQUAL (ev3.time(), time);
+    BOOST_CHECK (!ev3.isEntry());
+    BOOST_CHECK_EQUAL (ev3.delta(), -1);
+
+    /* Times before 1970 */
+    cgi::Event ev4 = cgi::Event(-time, true);
+    BOOST_CHECK_EQUAL (ev4.time(), -time);
+    BOOST_CHECK (ev4.isEntry());
+    BOOST_CHECK (cgi::Event(-time, false) < ev4);
+    BOOST_CHECK (ev4 < cgi::Event(-time+1, false));
+    BOOST_CHECK (ev4 < ev3);
+}
+
+//______________________________________________________________________________
+//                                                              Event_op_compare
+
+/// Test ordering of events
+BOOST_AUTO_TEST_CASE (Event_op_compare)
+{
+    cgi::Event entry1 (100, true);
+    cgi::Event exit1  (100, false);
+    cgi::Event entry2 (101, true);
+
+    BOOST_CHECK (exit1 < entry1);   /*  Simultaneous events: exit first */
+    BOOST_CHECK (entry1 < entry2);
+    BOOST_CHECK (entry2 > exit1);
+    BOOST_CHECK (entry1 == cgi::Event(100, true));
+
+    std::vector<cgi::Event> events;
+    events.push_back(entry2);
+    events.push_back(entry1);
+    events.push_back(exit1);
+    std::sort(events.begin(), events.end());
+
+    BOOST_CHECK (events[0] == exit1);
+    BOOST_CHECK (events[1] == entry1);
+    BOOST_CHECK (events[2] == entry2);
+}
@@ -0,0 +1,166 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_ExternalSort.cc
+ * \brief A collection of tests for the cgi::ExternalSort class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_ExternalSort
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <ExternalSort.h>
+#include <LogData.h>
+#include <OccupancySweep.h>
+
+//______________________________________________________________________________
+//                                                      ExternalSort_constructor
+
+/// Test creation of object
+BOOST_AUTO_TEST_CASE (ExternalSort_constructor)
+{
+    cgi::ExternalSort sort (1024, ".");
+
+    BOOST_CHECK_EQUAL (sort.memoryBudget(), 1024u);
+    BOOST_CHECK_EQUAL (sort.nofEvents(), 0u);
+    BOOST_CHECK_EQUAL (sort.nofRuns(), 0u);
+}
+
+//______________________________________________________________________________
+//                                                           ExternalSort_merge
+
+/// Test k-way merge of the sorted runs
+BOOST_AUTO_TEST_CASE (ExternalSort_merge)
+{
+    /* A budget of zero is raised to the minimum run size */
+    cgi::ExternalSort sort (0, ".");
+    const std::size_t nofEvents = 10*cgi::ExternalSort::minBufferSize + 7;
+
+    for (std::size_t n=0; n<nofEvents; ++n) {
+        sort.insert(cgi::Event((n*37)%10007, n%2 == 0));
+    }
+
+    BOOST_CHECK_EQUAL (sort.nofEvents(), nofEvents);
+    BOOST_CHECK_EQUAL (sort.nofRuns(), 10u);
+
+    std::vector<cgi::Event> merged;
+    sort.merge([&merged] (const cgi::Event& event) {
+            merged.push_back(event);
+        });
+
+    BOOST_CHECK_EQUAL (merged.size(), nofEvents);
+    for (std::size_t n=1; n<merged.size(); ++n) {
+        BOOST_CHECK (!(merged[n] < merged[n-1]));
+    }
+}
+
+//______________________________________________________________________________
+//                                                      ExternalSort_mergePasses
+
+/// Test merging more runs than can be merged at once
+BOOST_AUTO_TEST_CASE (ExternalSort_mergePasses)
+{
+    cgi::ExternalSort sort (0, ".");
+    sort.setMaxFanIn(3);
+    BOOST_CHECK_EQUAL (sort.maxFanIn(), 3u);
+
+    const std::size_t nofEvents = 10*cgi::ExternalSort::minBufferSize;
+    std::vector<cgi::Event> expected;
+    for (std::size_t n=0; n<nofEvents; ++n) {
+        expected.push_back(cgi::Event((n*7919)%10009, n%3 == 0));
+        sort.insert(expected.back());
+    }
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<cgi::Event> merged;
+    sort.merge([&merged] (const cgi::Event& event) {
+            merged.push_back(event);
+        });
+
+    BOOST_CHECK (merged == expected);
+    /* Intermediate runs are merged into a single one at most */
+    BOOST_CHECK (sort.nofRuns() <= sort.maxFanIn());
+}
+
+//______________________________________________________________________________
+//                                                         ExternalSort_readData
+
+/// Test results against processing of the log held in memory
+BOOST_AUTO_TEST_CASE (ExternalSort_readData)
+{
+    std::string filename = "test_ExternalSort.txt";
+    {
+        /* Enough log entries to fill several sorted runs */
+        std::ofstream outfile (filename);
+        for (std::size_t n=0; n<2*cgi::ExternalSort::minBufferSize; ++n) {
+            int entry = 8*60 + (n*37)%480;
+            int exit  = entry + 10 + (n*13)%120;
+            outfile << std::setfill('0') << std::setw(2) << entry/60 << ":"
+                    << std::setw(2) << entry%60 << ","
+                    << std::setw(2) << exit/60 << ":" << std::setw(2) << exit%60 << "\n";
+        }
+    }
+
+    /* Out-of-core: minimum budget */
+    cgi::ExternalSort sort (0, ".");
+    cgi::OccupancySweep sweepExternal;
+    sort.readData(filename);
+    sort.merge([&sweepExternal] (const cgi::Event& event) {
+            sweepExternal.add(event);
+        });
+    sweepExternal.finish();
+
+    BOOST_CHECK_EQUAL (sort.nofEvents(), 4*cgi::ExternalSort::minBufferSize);
+    BOOST_CHECK (sort.nofRuns() >= 2);
+
+    /* In-memory */
+    cgi::LogData log (filename);
+    std::vector<cgi::Event> events = log.events();
+    cgi::OccupancySweep sweep;
+    for (auto it=events.begin(); it!=events.end(); ++it) {
+        sweep.add(*it);
+    }
+    sweep.finish();
+
+    BOOST_CHECK_EQUAL (sweepExternal.maxNofVisitors(), log.maxNofVisitors());
+    BOOST_CHECK_EQUAL (sweepExternal.maxNofVisitors(), sweep.maxNofVisitors());
+    BOOST_CHECK_EQUAL (sweepExternal.timeline().size(), sweep.timeline().size());
+    BOOST_CHECK_EQUAL (sweepExternal.maxIntervals().size(), sweep.maxIntervals().size());
+    for (std::size_t n=0; n<sweep.timeline().size(); ++n) {
+        BOOST_CHECK_EQUAL (sweepExternal.timeline()[n].time(), sweep.timeline()[n].time());
+        BOOST_CHECK_EQUAL (sweepExternal.timeline()[n].count(), sweep.timeline()[n].count());
+    }
+}
+
+//______________________________________________________________________________
+//                                                       ExternalSort_timeWindow
+
+/// Test skipping of log entries outside the time window while reading
+BOOST_AUTO_TEST_CASE (ExternalSort_timeWindow)
+{
+    std::string filename = "test_ExternalSort_timeWindow.txt";
+    {
+        std::ofstream outfile (filename);
+        outfile << "08:00,09:00\n" << "08:30,10:30\n" << "10:00,11:00\n"
+                << "11:00,12:00\n";
+    }
+
+    cgi::ExternalSort sort (1024, ".");
+    sort.setTimeWindow(cgi::TimeWindow(cgi::DateTime("09:00", "%H:%M").rawtime(),
+                                       cgi::DateTime("11:00", "%H:%M").rawtime()));
+    sort.readData(filename);
+
+    BOOST_CHECK_EQUAL (sort.nofEvents(), 4u);
+}
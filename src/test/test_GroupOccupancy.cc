@@ -0,0 +1,59 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_GroupOccupancy.cc
+ * \brief A collection of tests for the cgi::GroupOccupancy class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_GroupOccupancy
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <GroupOccupancy.h>
+
+#include "TestData.h"
+
+//______________________________________________________________________________
+//                                                          GroupOccupancy_sweep
+
+/// Test per-group maxima from a single sweep
+BOOST_AUTO_TEST_CASE(GroupOccupancy_sweep)
+{
+    std::vector<std::string> lines;
+    lines.push_back("08:00,11:00,staff");
+    lines.push_back("09:00,12:00,visitor");
+    lines.push_back("10:00,13:00,visitor");
+    lines.push_back("08:30,10:30,staff");
+    lines.push_back("12:00,12:30,visitor");
+    cgi::LogData log (write_test_data("test_GroupOccupancy_sweep.txt", lines));
+
+    cgi::GroupOccupancy groups (log, 0);
+    BOOST_CHECK_EQUAL (groups.nofGroups(), 2u);
+    BOOST_CHECK_EQUAL (groups.name(0), "staff");
+    BOOST_CHECK_EQUAL (groups.name(1), "visitor");
+
+    BOOST_CHECK_EQUAL (groups.maxNofVisitors(0), 2);
+    BOOST_CHECK_EQUAL (groups.maxIntervals(0).size(), 1u);
+    BOOST_CHECK (groups.maxIntervals(0)[0].begin() == cgi::DateTime("08:30", "%H:%M"));
+    BOOST_CHECK (groups.maxIntervals(0)[0].end()   == cgi::DateTime("10:30", "%H:%M"));
+
+    /* Visitor leaving at 12:00 while another one enters: plateau 10:00-12:30 */
+    BOOST_CHECK_EQUAL (groups.maxNofVisitors(1), 2);
+    BOOST_CHECK_EQUAL (groups.maxIntervals(1).size(), 1u);
+    BOOST_CHECK (groups.maxIntervals(1)[0].begin() == cgi::DateTime("10:00", "%H:%M"));
+    BOOST_CHECK (groups.maxIntervals(1)[0].end()   == cgi::DateTime("12:30", "%H:%M"));
+
+    std::cout << groups;
+
+    /* Invalid column */
+    BOOST_CHECK_THROW (cgi::GroupOccupancy(log, 1), const char*);
+}
@@ -0,0 +1,112 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_IntervalSet.cc
+ * \brief A collection of tests for the cgi::IntervalSet class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_IntervalSet
+
+#include <iostream>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <IntervalSet.h>
+
+//______________________________________________________________________________
+//                                                         IntervalSet_coalesce
+
+/// Test merging of adjacent intervals with equal value
+BOOST_AUTO_TEST_CASE(IntervalSet_coalesce)
+{
+    cgi::IntervalSet<int,int> set;
+    BOOST_CHECK (set.empty());
+
+    set.insert(0, 10, 1);
+    set.insert(10, 20, 1);    /*  adjacent, same value -> merged */
+    set.insert(20, 30, 2);    /*  adjacent, other value */
+    set.insert(40, 50, 2);    /*  gap */
+    set.insert(50, 50, 2);    /*  empty, ignored */
+
+    BOOST_CHECK_EQUAL (set.size(), 3u);
+    BOOST_CHECK_EQUAL (set[0].begin(), 0);
+    BOOST_CHECK_EQUAL (set[0].end(),   20);
+    BOOST_CHECK_EQUAL (set[1].begin(), 20);
+    BOOST_CHECK_EQUAL (set[1].end(),   30);
+    BOOST_CHECK_EQUAL (set[2].begin(), 40);
+
+    /* Filling the gap, with the value of both neighbours */
+    set.insert(30, 40, 2);
+    BOOST_CHECK_EQUAL (set.size(), 2u);
+    BOOST_CHECK_EQUAL (set[1].begin(), 20);
+    BOOST_CHECK_EQUAL (set[1].end(),   50);
+
+    /* Inserting out of order */
+    set.insert(-10, 0, 1);
+    BOOST_CHECK_EQUAL (set.size(), 2u);
+    BOOST_CHECK_EQUAL (set[0].begin(), -10);
+
+    std::cout << set;
+}
+
+//______________________________________________________________________________
+//                                                          IntervalSet_overlap
+
+/// Test insertion of intervals overlapping existing ones
+BOOST_AUTO_TEST_CASE(IntervalSet_overlap)
+{
+    cgi::IntervalSet<int,std::string> set;
+
+    set.insert(0, 100, "a");
+    set.insert(40, 60, "b");  /*  splits the existing interval */
+
+    BOOST_CHECK_EQUAL (set.size(), 3u);
+    BOOST_CHECK_EQUAL (set[0].end(),   40);
+    BOOST_CHECK_EQUAL (set[1].value(), "b");
+    BOOST_CHECK_EQUAL (set[2].begin(), 60);
+    BOOST_CHECK_EQUAL (set[2].end(),   100);
+    BOOST_CHECK_EQUAL (set[2].value(), "a");
+
+    set.insert(30, 70, "a");  /*  overlaps all three, same value as outer ones */
+    BOOST_CHECK_EQUAL (set.size(), 1u);
+    BOOST_CHECK_EQUAL (set[0].begin(), 0);
+    BOOST_CHECK_EQUAL (set[0].end(),   100);
+}
+
+//______________________________________________________________________________
+//                                                           IntervalSet_lookup
+
+/// Test lookup by point and by range
+BOOST_AUTO_TEST_CASE(IntervalSet_lookup)
+{
+    cgi::IntervalSet<int,int> set;
+    for (int n=0; n<100; ++n) {
+        set.insert(10*n, 10*n+5, n);
+    }
+    BOOST_CHECK_EQUAL (set.size(), 100u);
+
+    BOOST_CHECK (set.contains(0));
+    BOOST_CHECK (set.contains(504));
+    BOOST_CHECK (!set.contains(505));
+    BOOST_CHECK (!set.contains(-1));
+    BOOST_CHECK_EQUAL (set.find(423)->value(), 42);
+    BOOST_CHECK (set.find(1000) == set.end());
+
+    BOOST_CHECK (set.overlaps(4, 6));
+    BOOST_CHECK (!set.overlaps(5, 10));
+    BOOST_CHECK (!set.overlaps(7, 7));
+
+    auto range = set.overlapping(12, 34);
+    BOOST_CHECK_EQUAL (range.second - range.first, 3);
+    BOOST_CHECK_EQUAL (range.first->value(), 1);
+
+    cgi::IntervalSet<int,int> clipped = set.clip(12, 34);
+    BOOST_CHECK_EQUAL (clipped.size(), 3u);
+    BOOST_CHECK_EQUAL (clipped[0].begin(), 12);
+    BOOST_CHECK_EQUAL (clipped[0].end(),   15);
+    BOOST_CHECK_EQUAL (clipped[2].begin(), 30);
+    BOOST_CHECK_EQUAL (clipped[2].end(),   34);
+}
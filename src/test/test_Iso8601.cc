@@ -0,0 +1,95 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_Iso8601.cc
+ * \brief A collection of tests for the cgi::Iso8601 class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_Iso8601
+
+#include <cstdint>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <Iso8601.h>
+
+/// Parse string as timestamp
+bool parse (const std::string& str,
+            std::int64_t& seconds,
+            std::int64_t& nanoseconds)
+{
+    return cgi::Iso8601::parse(str.data(), str.data()+str.size(), seconds, nanoseconds);
+}
+
+//______________________________________________________________________________
+//                                                         Iso8601_daysFromCivil
+
+/// Test conversion of calendar dates
+BOOST_AUTO_TEST_CASE(Iso8601_daysFromCivil)
+{
+    BOOST_CHECK_EQUAL (cgi::Iso8601::daysFromCivil(1970, 1, 1), 0);
+    BOOST_CHECK_EQUAL (cgi::Iso8601::daysFromCivil(1970, 1, 2), 1);
+    BOOST_CHECK_EQUAL (cgi::Iso8601::daysFromCivil(1969, 12, 31), -1);
+    BOOST_CHECK_EQUAL (cgi::Iso8601::daysFromCivil(2000, 3, 1), 11017);
+    BOOST_CHECK_EQUAL (cgi::Iso8601::daysFromCivil(2000, 2, 29), 11016);
+}
+
+//______________________________________________________________________________
+//                                                                 Iso8601_parse
+
+/// Test parsing of timestamps
+BOOST_AUTO_TEST_CASE(Iso8601_parse)
+{
+    std::int64_t seconds     = 0;
+    std::int64_t nanoseconds = 0;
+
+    BOOST_CHECK (parse("2015-01-02T03:04:05Z", seconds, nanoseconds));
+    BOOST_CHECK_EQUAL (seconds, 1420167845);
+    BOOST_CHECK_EQUAL (nanoseconds, 0);
+
+    BOOST_CHECK (parse("2026-10-17T14:03:22.123456789Z", seconds, nanoseconds));
+    BOOST_CHECK_EQUAL (seconds, 1792245802);
+    BOOST_CHECK_EQUAL (nanoseconds, 123456789);
+
+    /* Truncation beyond nanoseconds, short fractions */
+    BOOST_CHECK (parse("2026-10-17T14:03:22.1234567891Z", seconds, nanoseconds));
+    BOOST_CHECK_EQUAL (nanoseconds, 123456789);
+    BOOST_CHECK (parse("2026-10-17T14:03:22.5", seconds, nanoseconds));
+    BOOST_CHECK_EQUAL (nanoseconds, 500000000);
+
+    /* UTC offsets */
+    BOOST_CHECK (parse("2026-10-17T16:03:22+02:00", seconds, nanoseconds));
+    BOOST_CHECK_EQUAL (seconds, 1792245802);
+    BOOST_CHECK (parse("2026-10-17T08:33:22-0530", seconds, nanoseconds));
+    BOOST_CHECK_EQUAL (seconds, 1792245802);
+
+    /* Date only, space as separator */
+    BOOST_CHECK (parse("2026-10-17", seconds, nanoseconds));
+    BOOST_CHECK_EQUAL (seconds, 1792195200);
+    BOOST_CHECK (parse("2026-10-17 14:03", seconds, nanoseconds));
+    BOOST_CHECK_EQUAL (seconds, 1792245780);
+}
+
+//______________________________________________________________________________
+//                                                               Iso8601_invalid
+
+/// Test rejection of malformed input
+BOOST_AUTO_TEST_CASE(Iso8601_invalid)
+{
+    std::int64_t seconds     = 42;
+    std::int64_t nanoseconds = 42;
+
+    BOOST_CHECK (!parse("14:03", seconds, nanoseconds));
+    BOOST_CHECK (!parse("2026-13-17", seconds, nanoseconds));
+    BOOST_CHECK (!parse("2026-10-17T14", seconds, nanoseconds));
+    BOOST_CHECK (!parse("2026-10-17T14:03:22X", seconds, nanoseconds));
+    BOOST_CHECK (!parse("2026-10-17T14:03+1", seconds, nanoseconds));
+    BOOST_CHECK_EQUAL (seconds, 42);
+    BOOST_CHECK_EQUAL (nanoseconds, 42);
+
+    BOOST_CHECK (cgi::Iso8601::isDate("2026-10-17", "2026-10-17"+10));
+    BOOST_CHECK (!cgi::Iso8601::isDate("14:03:22.5", "14:03:22.5"+10));
+}
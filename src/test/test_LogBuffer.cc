@@ -0,0 +1,109 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_LogBuffer.cc
+ * \brief A collection of tests for the cgi::LogBuffer class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_LogBuffer
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <LogBuffer.h>
+
+//______________________________________________________________________________
+//                                                            LogBuffer_iterator
+
+/// Test iteration over the log entries of an existing buffer
+BOOST_AUTO_TEST_CASE(LogBuffer_iterator)
+{
+    const char* data = "08:00,09:00\n\n10:00,11:00\r\n\r\n12:00,13:00";
+
+    cgi::LogBuffer buffer (data, std::strlen(data));
+    BOOST_CHECK (buffer.isOpen());
+
+    std::vector<std::string> lines;
+    for (auto it=buffer.begin(); it!=buffer.end(); ++it) {
+        cgi::LogEntryView entry = *it;
+        /* The view refers to the bytes of the buffer */
+        BOOST_CHECK (entry.data() >= data && entry.data() < data+std::strlen(data));
+        lines.push_back(entry.str());
+    }
+
+    BOOST_CHECK_EQUAL (lines.size(), 3u);
+    BOOST_CHECK_EQUAL (lines[0], "08:00,09:00");
+    BOOST_CHECK_EQUAL (lines[1], "10:00,11:00");
+    BOOST_CHECK_EQUAL (lines[2], "12:00,13:00");
+}
+
+//______________________________________________________________________________
+//                                                                LogBuffer_file
+
+/// Test mapping the contents of a file
+BOOST_AUTO_TEST_CASE(LogBuffer_file)
+{
+    std::string filename = "test_LogBuffer.txt";
+    {
+        std::ofstream outfile (filename);
+        outfile << "08:00,09:00\n" << "10:00,11:00\n";
+    }
+
+    cgi::LogBuffer buffer (filename);
+    BOOST_CHECK (buffer.isOpen());
+    BOOST_CHECK_EQUAL (buffer.size(), 24u);
+
+    std::size_t nofEntries = 0;
+    for (auto it=buffer.begin(); it!=buffer.end(); ++it) {
+        ++nofEntries;
+    }
+    BOOST_CHECK_EQUAL (nofEntries, 2u);
+
+    cgi::LogBuffer missing ("test_LogBuffer_missing.txt");
+    BOOST_CHECK (!missing.isOpen());
+    BOOST_CHECK (missing.begin() == missing.end());
+}
+
+//______________________________________________________________________________
+//                                                                LogBuffer_pipe
+
+/// Test reading from an input source which cannot be mapped into memory
+BOOST_AUTO_TEST_CASE(LogBuffer_pipe)
+{
+    std::string filename = "test_LogBuffer.fifo";
+    unlink(filename.c_str());
+    BOOST_REQUIRE (mkfifo(filename.c_str(), 0600) == 0);
+
+    std::thread writer ([&filename] () {
+            std::ofstream outfile (filename);
+            outfile << "08:00,09:00\n" << "10:00,11:00\n" << "12:00,13:00\n";
+        });
+
+    /* Skip the first log entry */
+    cgi::LogBuffer buffer (filename, 12);
+    writer.join();
+    unlink(filename.c_str());
+
+    BOOST_CHECK (buffer.isOpen());
+    BOOST_CHECK_EQUAL (buffer.size(), 24u);
+
+    std::vector<std::string> lines;
+    for (auto it=buffer.begin(); it!=buffer.end(); ++it) {
+        lines.push_back((*it).str());
+    }
+    BOOST_CHECK_EQUAL (lines.size(), 2u);
+    BOOST_CHECK_EQUAL (lines[0], "10:00,11:00");
+    BOOST_CHECK_EQUAL (lines[1], "12:00,13:00");
+}
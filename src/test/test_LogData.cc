@@ -11,6 +11,9 @@
 /// Name of Boost test module
 #define BOOST_TEST_MODULE test_LogData
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <set>
 #include <string>
@@ -19,6 +22,9 @@
 #include <boost/test/unit_test.hpp>
 
 #include <LogData.h>
+#include <MonotonicArena.h>
+
+#include "TestData.h"
 
 //______________________________________________________________________________
 //                                                           LogData_constructor
@@ -27,4 +33,517 @@
 BOOST_AUTO_TEST_CASE(LogData_constructor)
 {
     cgi::LogData log = cgi::LogData();
+
+    BOOST_CHECK (log.empty());
+    BOOST_CHECK_EQUAL (log.size(), 0u);
+    BOOST_CHECK (!log.keepRawData());
+}
+
+//______________________________________________________________________________
+//                                                                LogData_events
+
+/// Test generation of the time-ordered list of events
+BOOST_AUTO_TEST_CASE(LogData_events)
+{
+    std::vector<std::string> lines;
+    lines.push_back("08:00,10:00");
+    lines.push_back("10:00,12:00");
+
+    cgi::LogData log (write_test_data("test_LogData_events.txt", lines));
+    std::vector<cgi::Event> events = log.events();
+
+    BOOST_CHECK_EQUAL (events.size(), 4u);
+    for (std::size_t n=1; n<events.size(); ++n) {
+        BOOST_CHECK (!(events[n] < events[n-1]));
+    }
+    /* At 10:00 the exit is placed before the entry */
+    BOOST_CHECK_EQUAL (events[1].time(), events[2].time());
+    BOOST_CHECK_EQUAL (events[1].delta(), -1);
+    BOOST_CHECK_EQUAL (events[2].delta(), +1);
+
+    /* The cached list holds the same events, without making a copy */
+    const cgi::LogData::EventArray& sorted = log.sortedEvents();
+    BOOST_CHECK (std::equal(events.begin(), events.end(), sorted.begin()));
+    BOOST_CHECK_EQUAL (&log.sortedEvents(), &sorted);
+}
+
+//______________________________________________________________________________
+//                                                           LogData_nofVisitors
+
+/// Test batch evaluation of the number of visitors at given points in time
+BOOST_AUTO_TEST_CASE(LogData_nofVisitors)
+{
+    std::vector<std::string> lines;
+    lines.push_back("08:00,11:00");
+    lines.push_back("09:00,12:00");
+    lines.push_back("10:00,13:00");
+
+    cgi::LogData log (write_test_data("test_LogData_nofVisitors.txt", lines));
+
+    std::vector<cgi::DateTime> probes;
+    probes.push_back(cgi::DateTime("10:30", "%H:%M"));
+    probes.push_back(cgi::DateTime("07:59", "%H:%M"));
+    probes.push_back(cgi::DateTime("13:00", "%H:%M"));
+    probes.push_back(cgi::DateTime("08:00", "%H:%M"));
+    probes.push_back(cgi::DateTime("11:00", "%H:%M"));
+
+    std::vector<int> visitors = log.nofVisitors(probes);
+
+    BOOST_CHECK_EQUAL (visitors.size(), probes.size());
+    BOOST_CHECK_EQUAL (visitors[0], 3);
+    BOOST_CHECK_EQUAL (visitors[1], 0);
+    BOOST_CHECK_EQUAL (visitors[2], 0);
+    BOOST_CHECK_EQUAL (visitors[3], 1);
+    BOOST_CHECK_EQUAL (visitors[4], 2);
+}
+
+//______________________________________________________________________________
+//                                                        LogData_duplicateEntry
+
+/// Test that visitors entering at the same time are all retained
+BOOST_AUTO_TEST_CASE(LogData_duplicateEntry)
+{
+    std::vector<std::string> lines;
+    lines.push_back("12:29,12:42");
+    lines.push_back("09:00,10:00");
+    lines.push_back("12:29,12:53");
+
+    cgi::LogData log (write_test_data("test_LogData_duplicateEntry.txt", lines));
+
+    BOOST_CHECK_EQUAL (log.size(), 3u);
+    BOOST_CHECK_EQUAL (log.maxNofVisitors(), 2);
+
+    /* Sorted by time of entry, original order retained for equal entries */
+    std::vector<cgi::LogEntry> entries = log.data();
+    BOOST_CHECK_EQUAL (entries.size(), 3u);
+    BOOST_CHECK (entries[0].timeEntry() < entries[1].timeEntry());
+    BOOST_CHECK (entries[1].timeEntry() == entries[2].timeEntry());
+    BOOST_CHECK (entries[1].timeExit() < entries[2].timeExit());
+}
+
+//______________________________________________________________________________
+//                                                            LogData_appendData
+
+/// Test appending data from a further input source
+BOOST_AUTO_TEST_CASE(LogData_appendData)
+{
+    std::vector<std::string> lines1;
+    lines1.push_back("08:00,09:00");
+    lines1.push_back("12:00,13:00");
+
+    std::vector<std::string> lines2;
+    lines2.push_back("14:00,15:00");
+    lines2.push_back("10:00,11:00");
+
+    cgi::LogData log (write_test_data("test_LogData_append1.txt", lines1), true);
+    log.readData(write_test_data("test_LogData_append2.txt", lines2), false);
+
+    BOOST_CHECK_EQUAL (log.size(), 4u);
+    BOOST_CHECK_EQUAL (log.dataSources().size(), 2u);
+
+    cgi::LogData::TimeArray timesEntry = log.timesEntry();
+    for (std::size_t n=1; n<timesEntry.size(); ++n) {
+        BOOST_CHECK (timesEntry[n-1] < timesEntry[n]);
+    }
+
+    /* Raw data are moved along with the times */
+    std::vector<cgi::LogEntry> entries = log.data();
+    BOOST_CHECK_EQUAL (entries[0].data(), "08:00,09:00");
+    BOOST_CHECK_EQUAL (entries[1].data(), "10:00,11:00");
+    BOOST_CHECK_EQUAL (entries[2].data(), "12:00,13:00");
+    BOOST_CHECK_EQUAL (entries[3].data(), "14:00,15:00");
+
+    /* Overwriting the data */
+    log.readData(write_test_data("test_LogData_append2.txt", lines2), true);
+    BOOST_CHECK_EQUAL (log.size(), 2u);
+    BOOST_CHECK_EQUAL (log.dataSources().size(), 1u);
+}
+
+//______________________________________________________________________________
+//                                                              LogData_resource
+
+/// Test use of a memory resource for storage and temporaries
+BOOST_AUTO_TEST_CASE(LogData_resource)
+{
+    std::vector<std::string> lines;
+    lines.push_back("08:00,11:00");
+    lines.push_back("09:00,12:00");
+    lines.push_back("10:00,13:00");
+
+    cgi::MonotonicArena arena;
+    cgi::LogData log (write_test_data("test_LogData_resource.txt", lines), false, &arena);
+
+    BOOST_CHECK (log.resource() == &arena);
+    BOOST_CHECK_EQUAL (log.size(), 3u);
+    BOOST_CHECK_EQUAL (log.maxNofVisitors(), 3);
+
+    cgi::MonotonicArena arenaTimepoints;
+    cgi::LogData::TimepointMap timepoints = log.entranceTimepoints(&arenaTimepoints);
+    std::multimap<cgi::DateTime,int> timepointsHeap = log.entranceTimepoints();
+
+    BOOST_CHECK_EQUAL (timepoints.size(), 6u);
+    BOOST_CHECK (std::equal(timepoints.begin(), timepoints.end(), timepointsHeap.begin()));
+    BOOST_CHECK (arenaTimepoints.nofChunks() > 0);
+
+    cgi::LogData::EventArray events = log.events(&arena);
+    std::vector<cgi::Event> eventsHeap = log.events();
+    BOOST_CHECK (std::equal(events.begin(), events.end(), eventsHeap.begin()));
+}
+
+//______________________________________________________________________________
+//                                                              LogData_iterator
+
+/// Test access to the log entries without copying the data
+BOOST_AUTO_TEST_CASE(LogData_iterator)
+{
+    std::vector<std::string> lines;
+    lines.push_back("10:00,13:00");
+    lines.push_back("08:00,11:00");
+    lines.push_back("09:00,12:00");
+    lines.push_back("11:00,11:30");
+    lines.push_back("12:00,12:30");
+
+    cgi::LogData log (write_test_data("test_LogData_iterator.txt", lines), true);
+
+    /* Iteration via begin/end */
+    std::vector<std::string> entries;
+    for (auto it=log.begin(); it!=log.end(); ++it) {
+        entries.push_back((*it).str());
+    }
+    BOOST_CHECK_EQUAL (entries.size(), 5u);
+    BOOST_CHECK_EQUAL (entries[0], "08:00,11:00");
+    BOOST_CHECK_EQUAL (entries[4], "12:00,12:30");
+    BOOST_CHECK_EQUAL (log.end() - log.begin(), 5);
+    BOOST_CHECK ((*(log.begin()+2)).timeEntry() == log[2].timeEntry());
+
+    /* The views refer to the data held by the LogData object */
+    BOOST_CHECK (log[0].data() == log[0].data());
+
+    /* Iteration via visitor */
+    std::size_t nofEntries = 0;
+    log.forEach([&nofEntries] (const cgi::LogEntryView& entry) {
+            BOOST_CHECK (entry.timeEntry() < entry.timeExit());
+            ++nofEntries;
+        });
+    BOOST_CHECK_EQUAL (nofEntries, 5u);
+
+    /* Split into chunks */
+    std::vector<cgi::LogData::Range> chunks = log.chunks(2);
+    BOOST_CHECK_EQUAL (chunks.size(), 2u);
+    BOOST_CHECK_EQUAL (chunks[0].size() + chunks[1].size(), 5u);
+    BOOST_CHECK (chunks[0].begin() == log.begin());
+    BOOST_CHECK (chunks[0].end() == chunks[1].begin());
+    BOOST_CHECK (chunks[1].end() == log.end());
+
+    BOOST_CHECK_EQUAL (log.chunks(10).size(), 5u);
+    BOOST_CHECK (log.chunks(0).empty());
+
+    std::cout << log;
+}
+
+//______________________________________________________________________________
+//                                                                LogData_layout
+
+/// Minimal record type, as an alternative to cgi::LogEntryView
+struct TimesOnly {
+    cgi::DateTime timeEntry;
+    cgi::DateTime timeExit;
+
+    TimesOnly (const char*, std::size_t,
+               const cgi::DateTime& entry,
+               const cgi::DateTime& exit) : timeEntry(entry), timeExit(exit) {}
+};
+
+/// Test instantiation for different record type and clock
+BOOST_AUTO_TEST_CASE(LogData_layout)
+{
+    std::vector<std::string> lines;
+    lines.push_back("08:00:00.250,08:00:00.500");
+    lines.push_back("08:00:00.500,08:00:01");
+    lines.push_back("08:00:00.100,08:00:00.400");
+    std::string filename = write_test_data("test_LogData_layout.txt", lines);
+
+    typedef cgi::BasicLogData<TimesOnly, cgi::MillisecondsClock> LogDataMs;
+
+    LogDataMs log (filename);
+    BOOST_CHECK_EQUAL (log.size(), 3u);
+
+    /* Times are stored in milliseconds */
+    LogDataMs::TimeArray timesEntry = log.timesEntry();
+    BOOST_CHECK_EQUAL (timesEntry[1] - timesEntry[0], 150);
+    BOOST_CHECK_EQUAL (log.timesExit()[2] - timesEntry[2], 500);
+
+    /* Overlapping visits are resolved below the second */
+    BOOST_CHECK_EQUAL (log.maxNofVisitors(), 2);
+
+    /* Entries are handed out as the requested record type */
+    TimesOnly entry = log[0];
+    BOOST_CHECK (entry.timeEntry == log[2].timeEntry);
+
+    /* Same file in the default layout: all visits within the same second */
+    cgi::LogData logSeconds (filename);
+    BOOST_CHECK_EQUAL (logSeconds.maxNofVisitors(), 1);
+}
+
+//______________________________________________________________________________
+//                                                           LogData_nanoseconds
+
+/// Test ordering of ISO 8601 timestamps with nanosecond resolution
+BOOST_AUTO_TEST_CASE(LogData_nanoseconds)
+{
+    std::vector<std::string> lines;
+    lines.push_back("2026-10-17T14:03:22.000000002Z,2026-10-17T14:03:22.000000004Z");
+    lines.push_back("2026-10-17T14:03:22.000000001Z,2026-10-17T14:03:22.000000002Z");
+    lines.push_back("2026-10-17T16:03:22.000000003+02:00,2026-10-17T14:03:22.000000005Z");
+    std::string filename = write_test_data("test_LogData_nanoseconds.txt", lines);
+
+    cgi::BasicLogData<cgi::LogEntryView, cgi::NanosecondsClock> log (filename);
+    BOOST_CHECK_EQUAL (log.size(), 3u);
+    BOOST_CHECK_EQUAL (log.timesEntry()[0], 1792245802000000001);
+    BOOST_CHECK_EQUAL (log.timesEntry()[2], 1792245802000000003);
+
+    /* Exit and entry at the same nanosecond do not overlap */
+    std::vector<cgi::Event> events = log.events();
+    BOOST_CHECK_EQUAL (events.size(), 6u);
+    BOOST_CHECK_EQUAL (events[1].time(), 1792245802000000002);
+    BOOST_CHECK (!events[1].isEntry());
+    BOOST_CHECK_EQUAL (log.maxNofVisitors(), 2);
+
+    /* In the default layout all visits collapse onto the same second */
+    cgi::LogData logSeconds (filename);
+    BOOST_CHECK_EQUAL (logSeconds.timesEntry()[0], logSeconds.timesEntry()[2]);
+    BOOST_CHECK_EQUAL (logSeconds.maxNofVisitors(), 0);
+}
+
+//______________________________________________________________________________
+//                                                               LogData_columns
+
+/// Test dictionary encoding of additional columns
+BOOST_AUTO_TEST_CASE(LogData_columns)
+{
+    std::vector<std::string> lines;
+    lines.push_back("10:00,11:00,visitor,gate-a");
+    lines.push_back("08:00,09:00,staff,gate-b");
+    lines.push_back("09:00,10:30,visitor");
+    std::string filename = write_test_data("test_LogData_columns.txt", lines);
+
+    cgi::LogData log (filename);
+    BOOST_CHECK_EQUAL (log.nofColumns(), 2u);
+    BOOST_CHECK_EQUAL (log.dictionary(0).size(), 2u);
+
+    /* Columns are sorted along with the times of entry */
+    const cgi::LogData::CodeArray& type = log.column(0);
+    BOOST_CHECK_EQUAL (log.dictionary(0)[type[0]], "staff");
+    BOOST_CHECK_EQUAL (log.dictionary(0)[type[1]], "visitor");
+    BOOST_CHECK_EQUAL (log.dictionary(0)[type[2]], "visitor");
+    BOOST_CHECK_EQUAL (log.dictionary(1)[log.column(1)[1]], "");
+
+    /* Times of exit are not affected by further fields */
+    BOOST_CHECK (log[2].timeExit() == cgi::DateTime("11:00", "%H:%M"));
+
+    /* Appending data without additional columns */
+    lines.clear();
+    lines.push_back("07:00,08:00");
+    log.readData(write_test_data("test_LogData_columns2.txt", lines), false);
+    BOOST_CHECK_EQUAL (log.size(), 4u);
+    BOOST_CHECK_EQUAL (log.column(0).size(), 4u);
+    BOOST_CHECK_EQUAL (log.dictionary(0)[log.column(0)[0]], "");
+    BOOST_CHECK_EQUAL (log.dictionary(0)[log.column(0)[1]], "staff");
+
+    /* Overwriting drops the columns */
+    log.readData("test_LogData_columns2.txt");
+    BOOST_CHECK_EQUAL (log.nofColumns(), 0u);
+}
+
+//______________________________________________________________________________
+//                                                            LogData_timeWindow
+
+/// Test skipping of log entries outside the time window while reading
+BOOST_AUTO_TEST_CASE(LogData_timeWindow)
+{
+    std::vector<std::string> lines;
+    lines.push_back("08:00,09:00,a");
+    lines.push_back("08:30,10:30,b");
+    lines.push_back("10:00,11:00,c");
+    lines.push_back("11:00,12:00,d");
+    std::string filename = write_test_data("test_LogData_timeWindow.txt", lines);
+
+    cgi::LogData log;
+    BOOST_CHECK (!log.timeWindow().isBounded());
+
+    log.setTimeWindow(cgi::DateTime("09:00", "%H:%M"), cgi::DateTime("11:00", "%H:%M"));
+    log.readData(filename);
+
+    /* Visits leaving at 09:00 or entering at 11:00 do not overlap */
+    BOOST_CHECK_EQUAL (log.size(), 2u);
+    BOOST_CHECK_EQUAL (log.nofColumns(), 1u);
+    BOOST_CHECK_EQUAL (log.dictionary(0).size(), 2u);
+    BOOST_CHECK_EQUAL (log.dictionary(0)[log.column(0)[0]], "b");
+    BOOST_CHECK_EQUAL (log.maxNofVisitors(), 2);
+}
+
+//______________________________________________________________________________
+//                                                      LogData_partialAggregate
+
+/// Test computing the statistics for a time shard from the shard's input only
+BOOST_AUTO_TEST_CASE(LogData_partialAggregate)
+{
+    std::vector<std::string> lines;
+    lines.push_back("08:00,09:00");
+    lines.push_back("08:30,10:30");
+    lines.push_back("10:00,11:00");
+    lines.push_back("11:00,12:00");
+    std::string filename = write_test_data("test_LogData_partialAggregate.txt", lines);
+
+    cgi::LogData log (filename);
+    cgi::PartialAggregate whole = log.partialAggregate();
+
+    /* Shards 09:00-10:15 and 10:15-, each read by its own instance */
+    cgi::DateTime split ("10:15", "%H:%M");
+    std::vector<cgi::TimeWindow> windows;
+    windows.push_back(cgi::TimeWindow(cgi::DateTime("09:00", "%H:%M").rawtime(), split.rawtime()));
+    windows.push_back(cgi::TimeWindow(split.rawtime(), std::numeric_limits<std::int64_t>::max()));
+
+    std::vector<cgi::PartialAggregate> shards;
+    shards.push_back(log.partialAggregate(cgi::TimeWindow(std::numeric_limits<std::int64_t>::min(),
+                                                          windows[0].begin())));
+    for (auto it=windows.begin(); it!=windows.end(); ++it) {
+        cgi::LogData shard;
+        shard.setTimeWindow(cgi::PartialAggregate::inputWindow(*it));
+        shard.readData(filename);
+        shards.push_back(shard.partialAggregate(*it));
+    }
+
+    cgi::PartialAggregate merged = cgi::PartialAggregate::merge(shards);
+
+    BOOST_CHECK_EQUAL (whole.maxNofVisitors(), 2);
+    BOOST_CHECK_EQUAL (merged.maxNofVisitors(), whole.maxNofVisitors());
+    BOOST_CHECK_EQUAL (merged.maxIntervals().size(), whole.maxIntervals().size());
+    BOOST_CHECK_EQUAL (merged.maxIntervals()[0].begin(), whole.maxIntervals()[0].begin());
+    BOOST_CHECK_EQUAL (merged.maxIntervals()[1].end(), whole.maxIntervals()[1].end());
+}
+
+//______________________________________________________________________________
+//                                                          LogData_denseMaximum
+
+/// Test the maximum number of visitors for a log which is dense in time
+BOOST_AUTO_TEST_CASE(LogData_denseMaximum)
+{
+    std::vector<std::string> lines;
+    lines.push_back("10:00:00,10:00:30");
+    lines.push_back("10:00:10,10:00:20");
+    lines.push_back("10:00:20,10:00:40");
+    lines.push_back("10:00:25,10:00:30");
+    lines.push_back("10:00:30,10:00:35");
+    lines.push_back("10:00:40,10:00:45");
+    cgi::LogData log (write_test_data("test_LogData_denseMaximum.txt", lines));
+
+    /* Same result as the sweep along the sorted events */
+    std::vector<cgi::Event> events = log.events();
+    int current = 0;
+    int max     = 0;
+    for (auto it=events.begin(); it!=events.end(); ++it) {
+        current += it->delta();
+        max = std::max(max, current);
+    }
+
+    BOOST_CHECK_EQUAL (log.maxNofVisitors(), 3);
+    BOOST_CHECK_EQUAL (log.maxNofVisitors(), max);
+}
+
+//______________________________________________________________________________
+//                                                                 LogData_cache
+
+/// Test maintenance of the cached quantities when appending/overwriting data
+BOOST_AUTO_TEST_CASE(LogData_cache)
+{
+    std::vector<std::string> lines1;
+    lines1.push_back("08:00,10:00");
+    lines1.push_back("09:00,11:00");
+
+    std::vector<std::string> lines2;
+    lines2.push_back("12:00,13:00");
+
+    std::vector<std::string> lines3;
+    lines3.push_back("09:30,10:30");
+    lines3.push_back("07:00,14:00");
+
+    std::string file1 = write_test_data("test_LogData_cache1.txt", lines1);
+    std::string file2 = write_test_data("test_LogData_cache2.txt", lines2);
+    std::string file3 = write_test_data("test_LogData_cache3.txt", lines3);
+
+    cgi::LogData log (file1);
+    BOOST_CHECK_EQUAL (log.maxNofVisitors(), 2);
+    BOOST_CHECK_EQUAL (log.events().size(), 4u);
+
+    /* Appending later entries continues the sweep */
+    log.readData(file2, false);
+    BOOST_CHECK_EQUAL (log.events().size(), 6u);
+    BOOST_CHECK_EQUAL (log.maxNofVisitors(), 2);
+    BOOST_CHECK_EQUAL (log.rangeOfTimes().second.asString("%H:%M"), "13:00");
+
+    /* Appending overlapping entries merges them into the cached events */
+    log.readData(file3, false);
+    BOOST_CHECK_EQUAL (log.maxNofVisitors(), 4);
+    BOOST_CHECK_EQUAL (log.rangeOfTimes().first.asString("%H:%M"), "07:00");
+    BOOST_CHECK_EQUAL (log.rangeOfTimes().second.asString("%H:%M"), "14:00");
+
+    /* Same results as when reading from scratch */
+    cgi::LogData reference (file1);
+    reference.readData(file3, false);
+    reference.readData(file2, false);
+
+    std::vector<cgi::Event> events   = log.events();
+    std::vector<cgi::Event> expected = reference.events();
+    BOOST_CHECK_EQUAL (events.size(), expected.size());
+    BOOST_CHECK (std::equal(events.begin(), events.end(), expected.begin()));
+    BOOST_CHECK_EQUAL (log.maxNofVisitors(), reference.maxNofVisitors());
+
+    /* Overwriting the data invalidates the cache */
+    log.readData(file2, true);
+    BOOST_CHECK_EQUAL (log.events().size(), 2u);
+    BOOST_CHECK_EQUAL (log.maxNofVisitors(), 1);
+    BOOST_CHECK_EQUAL (log.rangeOfTimes().first.asString("%H:%M"), "12:00");
+}
+
+//______________________________________________________________________________
+//                                                              LogData_pipeline
+
+/// Test reading a log spanning several blocks with concurrent parser stages
+BOOST_AUTO_TEST_CASE(LogData_pipeline)
+{
+    const char* groups[] = {"visitor", "staff", "guide"};
+    std::vector<std::string> lines;
+    char line[64];
+    for (std::size_t n=0; n<120000; ++n) {
+        std::size_t entry = (n*7919) % 80000;
+        std::size_t exit  = entry + 1 + n % 3600;
+        std::snprintf(line, sizeof(line), "%02zu:%02zu:%02zu,%02zu:%02zu:%02zu,%s",
+                      entry/3600, entry/60%60, entry%60,
+                      exit/3600, exit/60%60, exit%60, groups[(n/5) % 3]);
+        lines.push_back(line);
+    }
+    std::string filename = write_test_data("test_LogData_pipeline.txt", lines);
+
+    cgi::ThreadPool::setNofThreads(1);
+    cgi::LogData expected (filename, true);
+
+    cgi::ThreadPool::setNofThreads(4);
+    cgi::LogData log (filename, true);
+    cgi::ThreadPool::setNofThreads(0);
+
+    BOOST_CHECK_EQUAL (log.size(), lines.size());
+    BOOST_CHECK_EQUAL (log.size(), expected.size());
+    BOOST_CHECK (std::equal(log.begin(), log.end(), expected.begin(),
+                            [] (const cgi::LogEntryView& a, const cgi::LogEntryView& b) {
+                                return a.str() == b.str()
+                                    && a.timeEntry() == b.timeEntry()
+                                    && a.timeExit() == b.timeExit();
+                            }));
+
+    /* Dictionary codes are assigned in the order of the input */
+    BOOST_CHECK_EQUAL (log.dictionary(0)[0], "visitor");
+    BOOST_CHECK_EQUAL (log.dictionary(0)[1], "staff");
+    BOOST_CHECK (log.column(0) == expected.column(0));
+    BOOST_CHECK_EQUAL (log.maxNofVisitors(), expected.maxNofVisitors());
 }
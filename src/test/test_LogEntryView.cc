@@ -0,0 +1,106 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_LogEntryView.cc
+ * \brief A collection of tests for the cgi::LogEntryView class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_LogEntryView
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <LogEntry.h>
+#include <LogEntryView.h>
+
+//______________________________________________________________________________
+//                                                      LogEntryView_constructor
+
+/// Test creation of object
+BOOST_AUTO_TEST_CASE(LogEntryView_constructor)
+{
+    const char* line = "11:16,11:41\r\n";
+
+    cgi::LogEntryView view (line, std::strlen(line)-1);
+
+    BOOST_CHECK (view.data() == line);
+    BOOST_CHECK_EQUAL (view.size(), 11u);
+    BOOST_CHECK_EQUAL (view.str(), "11:16,11:41");
+
+    std::cout << view << std::endl;
+}
+
+//______________________________________________________________________________
+//                                                          LogEntryView_compare
+
+/// Test decoded times against the ones obtained via cgi::LogEntry
+BOOST_AUTO_TEST_CASE(LogEntryView_compare)
+{
+    const char* lines[] = {"11:16,11:41", "00:00,23:59", "08:05:30,09:10:15", "9:05,10:00"};
+
+    for (std::size_t n=0; n<sizeof(lines)/sizeof(lines[0]); ++n) {
+        cgi::LogEntryView view (lines[n], std::strlen(lines[n]));
+        cgi::LogEntry entry (lines[n]);
+        entry.setData(lines[n], n == 2 ? "%H:%M:%S" : "%H:%M");
+        BOOST_CHECK_EQUAL (view.timeEntry(), entry.timeEntry());
+        BOOST_CHECK_EQUAL (view.timeExit(),  entry.timeExit());
+    }
+}
+
+//______________________________________________________________________________
+//                                                           LogEntryView_isTime
+
+/// Test telling valid times from arbitrary text
+BOOST_AUTO_TEST_CASE(LogEntryView_isTime)
+{
+    const char* valid[]   = {"11:16", "9:05", "08:05:30", "2015-10-12T09:30:00Z"};
+    const char* invalid[] = {"", "foo", "25:99", "9h30", "11:16x", "2015-13-45T00:00:00"};
+
+    for (std::size_t n=0; n<sizeof(valid)/sizeof(valid[0]); ++n) {
+        BOOST_CHECK (cgi::LogEntryView::isTime(valid[n], valid[n]+std::strlen(valid[n])));
+    }
+    for (std::size_t n=0; n<sizeof(invalid)/sizeof(invalid[0]); ++n) {
+        BOOST_CHECK (!cgi::LogEntryView::isTime(invalid[n], invalid[n]+std::strlen(invalid[n])));
+    }
+}
+
+//______________________________________________________________________________
+//                                                      LogEntryView_daylightSaving
+
+/// Test times of day on days on which daylight saving time begins or ends
+BOOST_AUTO_TEST_CASE(LogEntryView_daylightSaving)
+{
+    const char* tz = std::getenv("TZ");
+    std::string previous = tz ? tz : "";
+    setenv("TZ", "CET-1CEST,M3.5.0,M10.5.0/3", 1);
+    tzset();
+
+    /* Regular day, end and begin of daylight saving time */
+    int days[3][3] = { {2026, 10, 19}, {2026, 10, 25}, {2026, 3, 29} };
+    for (int n=0; n<3; ++n) {
+        std::time_t reference = cgi::DateTime(days[n][0], days[n][1], days[n][2], 0, 0, 0).rawtime();
+        for (int hour=0; hour<24; hour+=3) {
+            std::time_t expected = cgi::DateTime(days[n][0], days[n][1], days[n][2], hour, 30, 0).rawtime();
+            char buffer[6];
+            std::snprintf(buffer, sizeof(buffer), "%02d:30", hour);
+            BOOST_CHECK_EQUAL (cgi::LogEntryView::parseTime(buffer, buffer+5, reference), expected);
+        }
+    }
+
+    if (tz) {
+        setenv("TZ", previous.c_str(), 1);
+    } else {
+        unsetenv("TZ");
+    }
+    tzset();
+}
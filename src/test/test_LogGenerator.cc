@@ -0,0 +1,148 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_LogGenerator.cc
+ * \brief A collection of tests for the cgi::LogGenerator class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_LogGenerator
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <LogData.h>
+#include <LogGenerator.h>
+
+#include "TestData.h"
+
+/// Test log, with an empty line, a line terminated by CRLF and a further column
+std::vector<std::string> test_lines ()
+{
+    std::vector<std::string> lines;
+    lines.push_back("10:00,13:00,visitor");
+    lines.push_back("08:00,11:00,staff");
+    lines.push_back("");
+    lines.push_back("09:00,12:00,visitor\r");
+    lines.push_back("11:00,12:00,guide");
+    return lines;
+}
+
+//______________________________________________________________________________
+//                                                          LogGenerator_entries
+
+/// Test lazy decoding of the log entries
+BOOST_AUTO_TEST_CASE (LogGenerator_entries)
+{
+    std::string filename = write_test_data("test_LogGenerator_entries.txt", test_lines());
+    std::time_t day      = cgi::LogEntryView::startOfDay();
+
+    cgi::EntryGenerator generator = cgi::entries(filename);
+    BOOST_CHECK (generator.isOpen());
+
+    std::vector<std::string> lines;
+    std::vector<std::time_t> times;
+    for (const cgi::LogEntryView& entry : generator) {
+        lines.push_back(entry.str());
+        times.push_back(entry.timeEntry().rawtime() - day);
+    }
+
+    /* Order of the log, skipping empty lines and line terminators */
+    BOOST_CHECK_EQUAL (lines.size(), 4u);
+    BOOST_CHECK_EQUAL (lines[0], "10:00,13:00,visitor");
+    BOOST_CHECK_EQUAL (lines[2], "09:00,12:00,visitor");
+    BOOST_CHECK_EQUAL (times[0], 10*3600);
+    BOOST_CHECK_EQUAL (times[1],  8*3600);
+    BOOST_CHECK_EQUAL (times[3], 11*3600);
+
+    /* Iterating again starts over */
+    BOOST_CHECK_EQUAL (std::distance(generator.begin(), generator.end()), 4);
+
+    /* Restricted to the visits overlapping with a time window */
+    cgi::TimeWindow window (day + 8*3600 + 1800, day + 9*3600 + 1800);
+    lines.clear();
+    for (const cgi::LogEntryView& entry : cgi::entries(filename, window)) {
+        lines.push_back(entry.str());
+    }
+    BOOST_CHECK_EQUAL (lines.size(), 2u);
+    BOOST_CHECK_EQUAL (lines[0], "08:00,11:00,staff");
+    BOOST_CHECK_EQUAL (lines[1], "09:00,12:00,visitor");
+
+    std::remove(filename.c_str());
+}
+
+//______________________________________________________________________________
+//                                                           LogGenerator_events
+
+/// Test lazy decoding of the events, against the events held by cgi::LogData
+BOOST_AUTO_TEST_CASE (LogGenerator_events)
+{
+    std::string filename = write_test_data("test_LogGenerator_events.txt", test_lines());
+
+    std::vector<cgi::Event> events;
+    for (const cgi::Event& event : cgi::events(filename)) {
+        events.push_back(event);
+    }
+
+    /* Entry and exit per log entry, in the order of the log */
+    BOOST_CHECK_EQUAL (events.size(), 8u);
+    BOOST_CHECK (events[0].isEntry());
+    BOOST_CHECK (!events[1].isEntry());
+    BOOST_CHECK_EQUAL (events[1].time() - events[0].time(), 3*3600);
+    BOOST_CHECK_EQUAL (events[3].time() - events[2].time(), 3*3600);
+
+    cgi::LogData data;
+    data.readData(filename);
+    std::vector<cgi::Event> expected = data.events();
+
+    std::sort(events.begin(), events.end());
+    BOOST_CHECK (events == expected);
+
+    std::remove(filename.c_str());
+}
+
+//______________________________________________________________________________
+//                                                           LogGenerator_filter
+
+/// Test composition of generators and filters
+BOOST_AUTO_TEST_CASE (LogGenerator_filter)
+{
+    std::string filename = write_test_data("test_LogGenerator_filter.txt", test_lines());
+
+    /* Visitors only */
+    auto visitors = cgi::filter(cgi::entries(filename),
+                                [] (const cgi::LogEntryView& entry) {
+                                    return entry.size() > 8
+                                        && entry.str().find("visitor") != std::string::npos;
+                                });
+    BOOST_CHECK_EQUAL (std::distance(visitors.begin(), visitors.end()), 2);
+
+    /* Nested filters: entries before noon */
+    std::time_t noon = cgi::LogEntryView::startOfDay() + 12*3600;
+    auto entries     = cgi::filter(cgi::events(filename),
+                                   [] (const cgi::Event& event) {
+                                       return event.isEntry();
+                                   });
+    auto morning     = cgi::filter(entries,
+                                   [noon] (const cgi::Event& event) {
+                                       return event.time() < noon - 2*3600;
+                                   });
+
+    BOOST_CHECK_EQUAL (std::distance(entries.begin(), entries.end()), 4);
+    BOOST_CHECK_EQUAL (std::distance(morning.begin(), morning.end()), 2);
+
+    /* Nothing to iterate over for a missing file */
+    cgi::EventGenerator missing = cgi::events("test_LogGenerator_missing.txt");
+    BOOST_CHECK (!missing.isOpen());
+    BOOST_CHECK (missing.begin() == missing.end());
+
+    std::remove(filename.c_str());
+}
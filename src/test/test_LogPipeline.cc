@@ -0,0 +1,153 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_LogPipeline.cc
+ * \brief A collection of tests for the cgi::LogPipeline class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_LogPipeline
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <LogPipeline.h>
+
+/// Batch produced by the tests: the lines of a block
+typedef std::vector<std::string> Lines;
+
+//______________________________________________________________________________
+//                                                                    make_input
+
+/// Create an input buffer with `nofLines` numbered lines
+std::string make_input (const std::size_t& nofLines)
+{
+    std::string result;
+    for (std::size_t n=0; n<nofLines; ++n) {
+        result += "line-" + std::to_string(n) + "\n";
+    }
+    return result;
+}
+
+//______________________________________________________________________________
+//                                                                   split_lines
+
+/// Split the block [begin,end) into lines
+void split_lines (const char* begin,
+                  const char* end,
+                  Lines& batch)
+{
+    while (begin < end) {
+        const char* eol = static_cast<const char*>(std::memchr(begin, '\n', end-begin));
+        if (eol == NULL) {
+            eol = end;
+        }
+        batch.push_back(std::string(begin, eol));
+        begin = eol+1;
+    }
+}
+
+//______________________________________________________________________________
+//                                                       LogPipeline_constructor
+
+/// Test creation of object
+BOOST_AUTO_TEST_CASE (LogPipeline_constructor)
+{
+    cgi::LogPipeline<Lines> pipeline (3);
+
+    BOOST_CHECK_EQUAL (pipeline.nofParsers(), 3u);
+    BOOST_CHECK_EQUAL (pipeline.blockSize(), 1024u*1024u);
+    BOOST_CHECK_EQUAL (pipeline.depth(), 4u);
+}
+
+//______________________________________________________________________________
+//                                                       LogPipeline_nextBlock
+
+/// Test that blocks end at line breaks
+BOOST_AUTO_TEST_CASE (LogPipeline_nextBlock)
+{
+    std::string input   = "abc\ndefgh\nij\n";
+    const char* data    = input.data();
+    const char* last    = data + input.size();
+
+    BOOST_CHECK (cgi::LogPipeline<Lines>::nextBlock(data, last, 100) == last);
+    BOOST_CHECK (cgi::LogPipeline<Lines>::nextBlock(data, last, 2) == data+4);
+    BOOST_CHECK (cgi::LogPipeline<Lines>::nextBlock(data, last, 4) == data+4);
+    BOOST_CHECK (cgi::LogPipeline<Lines>::nextBlock(data, last, 5) == data+10);
+    BOOST_CHECK (cgi::LogPipeline<Lines>::nextBlock(data+10, last, 1) == last);
+}
+
+//______________________________________________________________________________
+//                                                             LogPipeline_run
+
+/// Test that all lines are consumed once and in order
+BOOST_AUTO_TEST_CASE (LogPipeline_run)
+{
+    std::string input = make_input(20000);
+
+    for (std::size_t nofParsers=0; nofParsers<=4; ++nofParsers) {
+        for (std::size_t depth=1; depth<=3; depth+=2) {
+            cgi::LogPipeline<Lines> pipeline (nofParsers, 1000, depth);
+            std::size_t nofBatches = 0;
+            Lines lines;
+
+            pipeline.run(input.data(), input.size(), split_lines,
+                         [&] (Lines& batch) {
+                             ++nofBatches;
+                             lines.insert(lines.end(), batch.begin(), batch.end());
+                         });
+
+            BOOST_CHECK (nofBatches > 100u);
+            BOOST_CHECK_EQUAL (lines.size(), 20000u);
+            bool ordered = true;
+            for (std::size_t n=0; n<lines.size(); ++n) {
+                ordered = ordered && lines[n] == "line-" + std::to_string(n);
+            }
+            BOOST_CHECK (ordered);
+        }
+    }
+
+    /* Empty input */
+    cgi::LogPipeline<Lines> pipeline (2, 16);
+    std::size_t nofBatches = 0;
+    pipeline.run(input.data(), 0, split_lines, [&] (Lines&) { ++nofBatches; });
+    BOOST_CHECK_EQUAL (nofBatches, 0u);
+}
+
+//______________________________________________________________________________
+//                                                         LogPipeline_exception
+
+/// Test that exceptions thrown by either stage are passed on to the caller
+BOOST_AUTO_TEST_CASE (LogPipeline_exception)
+{
+    std::string input = make_input(20000);
+    cgi::LogPipeline<Lines> pipeline (3, 1000, 2);
+
+    /* Parser stage */
+    BOOST_CHECK_THROW (pipeline.run(input.data(), input.size(),
+                                    [] (const char* begin, const char* end, Lines& batch) {
+                                        split_lines(begin, end, batch);
+                                        for (std::size_t n=0; n<batch.size(); ++n) {
+                                            if (batch[n] == "line-12345") {
+                                                throw "ERROR [test_LogPipeline] Parser failed";
+                                            }
+                                        }
+                                    },
+                                    [] (Lines&) {}), const char*);
+
+    /* Consumer stage */
+    std::size_t nofBatches = 0;
+    BOOST_CHECK_THROW (pipeline.run(input.data(), input.size(), split_lines,
+                                    [&] (Lines&) {
+                                        if (++nofBatches == 10) {
+                                            throw "ERROR [test_LogPipeline] Consumer failed";
+                                        }
+                                    }), const char*);
+    BOOST_CHECK_EQUAL (nofBatches, 10u);
+}
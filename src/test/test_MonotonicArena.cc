@@ -0,0 +1,100 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_MonotonicArena.cc
+ * \brief A collection of tests for the cgi::MonotonicArena class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_MonotonicArena
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <MonotonicArena.h>
+#include <PolymorphicAllocator.h>
+
+//______________________________________________________________________________
+//                                                    MonotonicArena_constructor
+
+/// Test creation of object
+BOOST_AUTO_TEST_CASE (MonotonicArena_constructor)
+{
+    cgi::MonotonicArena arena;
+
+    BOOST_CHECK_EQUAL (arena.nofChunks(), 0u);
+    BOOST_CHECK (arena.upstream() == cgi::newDeleteResource());
+    BOOST_CHECK (arena.isEqual(arena));
+    BOOST_CHECK (!arena.isEqual(*cgi::newDeleteResource()));
+}
+
+//______________________________________________________________________________
+//                                                      MonotonicArena_allocate
+
+/// Test alignment and growth of the arena
+BOOST_AUTO_TEST_CASE (MonotonicArena_allocate)
+{
+    cgi::MonotonicArena arena (128);
+
+    void* p1 = arena.allocate(1, 1);
+    void* p2 = arena.allocate(8, 8);
+    void* p3 = arena.allocate(16, 16);
+
+    BOOST_CHECK_EQUAL (arena.nofChunks(), 1u);
+    BOOST_CHECK (p1 != p2 && p2 != p3);
+    BOOST_CHECK_EQUAL (reinterpret_cast<std::uintptr_t>(p2) % 8,  0u);
+    BOOST_CHECK_EQUAL (reinterpret_cast<std::uintptr_t>(p3) % 16, 0u);
+
+    /* Request larger than the remaining chunk */
+    arena.allocate(1000);
+    BOOST_CHECK_EQUAL (arena.nofChunks(), 2u);
+
+    arena.release();
+    BOOST_CHECK_EQUAL (arena.nofChunks(), 0u);
+}
+
+//______________________________________________________________________________
+//                                                 MonotonicArena_initialBuffer
+
+/// Test use of an initial buffer before turning to upstream
+BOOST_AUTO_TEST_CASE (MonotonicArena_initialBuffer)
+{
+    char buffer[256];
+    cgi::MonotonicArena arena (buffer, sizeof(buffer));
+
+    char* p = static_cast<char*>(arena.allocate(64));
+    BOOST_CHECK (p >= buffer && p < buffer+sizeof(buffer));
+    BOOST_CHECK_EQUAL (arena.nofChunks(), 0u);
+
+    arena.allocate(512);
+    BOOST_CHECK_EQUAL (arena.nofChunks(), 1u);
+}
+
+//______________________________________________________________________________
+//                                                    MonotonicArena_containers
+
+/// Test node-based container drawing its memory from the arena
+BOOST_AUTO_TEST_CASE (MonotonicArena_containers)
+{
+    typedef std::multimap<int, int, std::less<int>,
+                          cgi::PolymorphicAllocator<std::pair<const int,int> > > Map;
+
+    cgi::MonotonicArena arena (1024);
+    {
+        Map map (std::less<int>(), &arena);
+        for (int n=0; n<10000; ++n) {
+            map.insert(std::make_pair(n%100, n));
+        }
+        BOOST_CHECK_EQUAL (map.size(), 10000u);
+        BOOST_CHECK_EQUAL (map.count(42), 100u);
+    }
+
+    /* Geometric growth: a handful of chunks for 10000 nodes */
+    BOOST_CHECK (arena.nofChunks() < 16);
+}
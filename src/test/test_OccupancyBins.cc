@@ -0,0 +1,143 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_OccupancyBins.cc
+ * \brief A collection of tests for the cgi::OccupancyBins class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_OccupancyBins
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <OccupancyBins.h>
+#include <OccupancySweep.h>
+
+//______________________________________________________________________________
+//                                                   OccupancyBins_constructor
+
+/// Test creation of object
+BOOST_AUTO_TEST_CASE (OccupancyBins_constructor)
+{
+    cgi::OccupancyBins bins (60, 30);
+
+    BOOST_CHECK_EQUAL (bins.width(), 60);
+    BOOST_CHECK_EQUAL (bins.origin(), 30);
+    BOOST_CHECK (bins.empty());
+    BOOST_CHECK (!bins.timeWindow().isBounded());
+}
+
+//______________________________________________________________________________
+//                                                          OccupancyBins_steps
+
+/// Test min/mean/max of steps spanning one or several bins
+BOOST_AUTO_TEST_CASE (OccupancyBins_steps)
+{
+    /* Bins of 10, aligned to 5: [5,15), [15,25), [25,35) */
+    cgi::OccupancyBins bins (10, 5);
+
+    bins.add(8, 12, 2);
+    bins.add(12, 20, 4);
+    bins.add(20, 30, 1);
+
+    BOOST_REQUIRE_EQUAL (bins.size(), 3u);
+
+    BOOST_CHECK_EQUAL (bins[0].begin, 5);
+    BOOST_CHECK_EQUAL (bins[0].end,   15);
+    BOOST_CHECK_EQUAL (bins[0].min, 2);
+    BOOST_CHECK_EQUAL (bins[0].max, 4);
+    BOOST_CHECK_EQUAL (bins[0].covered, 7);
+    BOOST_CHECK_CLOSE (bins[0].mean(), (4*2 + 3*4)/7.0, 1e-9);
+
+    BOOST_CHECK_EQUAL (bins[1].min, 1);
+    BOOST_CHECK_EQUAL (bins[1].max, 4);
+    BOOST_CHECK_CLOSE (bins[1].mean(), (5*4 + 5*1)/10.0, 1e-9);
+
+    BOOST_CHECK_EQUAL (bins[2].covered, 5);
+    BOOST_CHECK_CLOSE (bins[2].mean(), 1.0, 1e-9);
+
+    /* Steps before the first bin, and times before the origin */
+    bins.add(-20, -12, 3);
+    BOOST_REQUIRE_EQUAL (bins.size(), 6u);
+    BOOST_CHECK_EQUAL (bins[0].begin, -25);
+    BOOST_CHECK_EQUAL (bins[0].covered, 5);
+    BOOST_CHECK_EQUAL (bins[1].covered, 3);
+    BOOST_CHECK_EQUAL (bins[2].covered, 0);
+    BOOST_CHECK_EQUAL (bins[3].begin, 5);
+    BOOST_CHECK_EQUAL (bins[3].max, 4);
+}
+
+//______________________________________________________________________________
+//                                                         OccupancyBins_window
+
+/// Test restriction of the steps to a time window
+BOOST_AUTO_TEST_CASE (OccupancyBins_window)
+{
+    cgi::OccupancyBins bins (10, 0, cgi::TimeWindow(15, 25));
+
+    bins.add(0, 18, 5);
+    bins.add(18, 40, 1);
+    bins.add(40, 50, 7);
+
+    BOOST_REQUIRE_EQUAL (bins.size(), 2u);
+    BOOST_CHECK_EQUAL (bins[0].begin, 10);
+    BOOST_CHECK_EQUAL (bins[0].covered, 5);
+    BOOST_CHECK_EQUAL (bins[0].max, 5);
+    BOOST_CHECK_EQUAL (bins[1].covered, 5);
+    BOOST_CHECK_EQUAL (bins[1].max, 1);
+}
+
+//______________________________________________________________________________
+//                                                          OccupancyBins_sweep
+
+/// Test filling the bins along with a sweep, against the recorded timeline
+BOOST_AUTO_TEST_CASE (OccupancyBins_sweep)
+{
+    /* 08:00-11:00, 09:00-12:00, 10:00-13:00 and 11:00-12:00 (in minutes) */
+    std::vector<cgi::Event> events;
+    events.push_back(cgi::Event(480, true));
+    events.push_back(cgi::Event(660, false));
+    events.push_back(cgi::Event(540, true));
+    events.push_back(cgi::Event(720, false));
+    events.push_back(cgi::Event(600, true));
+    events.push_back(cgi::Event(780, false));
+    events.push_back(cgi::Event(660, true));
+    events.push_back(cgi::Event(720, false));
+    std::sort(events.begin(), events.end());
+
+    cgi::OccupancyBins bins (90);
+    cgi::OccupancySweep sweep;
+    sweep.setBins(&bins);
+    for (auto it=events.begin(); it!=events.end(); ++it) {
+        sweep.add(*it);
+    }
+    sweep.finish();
+
+    cgi::OccupancyBins fromTimeline (90);
+    fromTimeline.add(sweep.timeline());
+
+    /* [450,540), [540,630), [630,720), [720,810) */
+    BOOST_REQUIRE_EQUAL (bins.size(), 4u);
+    BOOST_REQUIRE_EQUAL (fromTimeline.size(), 4u);
+    for (std::size_t n=0; n<bins.size(); ++n) {
+        BOOST_CHECK_EQUAL (bins[n].begin,   fromTimeline[n].begin);
+        BOOST_CHECK_EQUAL (bins[n].min,     fromTimeline[n].min);
+        BOOST_CHECK_EQUAL (bins[n].max,     fromTimeline[n].max);
+        BOOST_CHECK_EQUAL (bins[n].sum,     fromTimeline[n].sum);
+        BOOST_CHECK_EQUAL (bins[n].covered, fromTimeline[n].covered);
+    }
+
+    BOOST_CHECK_EQUAL (bins[1].min, 2);
+    BOOST_CHECK_EQUAL (bins[1].max, 3);
+    BOOST_CHECK_EQUAL (bins[2].min, 3);
+    BOOST_CHECK_EQUAL (bins[2].max, 3);
+    BOOST_CHECK_EQUAL (bins[3].min, 1);
+    BOOST_CHECK_CLOSE (bins[3].mean(), 1.0, 1e-9);
+}
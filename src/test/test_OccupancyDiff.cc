@@ -0,0 +1,76 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_OccupancyDiff.cc
+ * \brief A collection of tests for the cgi::OccupancyDiff class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_OccupancyDiff
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <OccupancyDiff.h>
+
+#include "TestData.h"
+
+//______________________________________________________________________________
+//                                                       OccupancyDiff_identical
+
+/// Test comparison of a log against itself
+BOOST_AUTO_TEST_CASE (OccupancyDiff_identical)
+{
+    std::vector<std::string> lines;
+    lines.push_back("08:00,11:00");
+    lines.push_back("09:00,12:00");
+
+    cgi::LogData log (write_test_data("test_OccupancyDiff_identical.txt", lines));
+    cgi::OccupancyDiff diff (log, log);
+
+    BOOST_CHECK (diff.isEqual());
+    BOOST_CHECK_EQUAL (diff.nofIntervals(), 0u);
+    BOOST_CHECK_EQUAL (diff.duration(), 0);
+    BOOST_CHECK_EQUAL (diff.maxDifference(), 0);
+}
+
+//______________________________________________________________________________
+//                                                       OccupancyDiff_intervals
+
+/// Test detection of the intervals during which the occupancy differs
+BOOST_AUTO_TEST_CASE (OccupancyDiff_intervals)
+{
+    std::vector<std::string> lines1;
+    lines1.push_back("08:00,11:00");
+    lines1.push_back("09:00,12:00");
+    lines1.push_back("10:00,13:00");
+
+    std::vector<std::string> lines2;
+    lines2.push_back("08:00,11:00");
+    lines2.push_back("10:00,13:00");
+    lines2.push_back("12:00,15:00");
+
+    cgi::LogData log1 (write_test_data("test_OccupancyDiff_1.txt", lines1));
+    cgi::LogData log2 (write_test_data("test_OccupancyDiff_2.txt", lines2));
+    cgi::OccupancyDiff diff (log1, log2);
+
+    std::cout << diff;
+
+    /* 09:00-12:00 : +1, 12:00-15:00 : -1 */
+    BOOST_CHECK_EQUAL (diff.nofIntervals(), 2u);
+    BOOST_CHECK_EQUAL (diff.intervals()[0].value(), +1);
+    BOOST_CHECK_EQUAL (diff.intervals()[1].value(), -1);
+    BOOST_CHECK_EQUAL (diff.intervals()[0].begin().hourAsString(), "09");
+    BOOST_CHECK_EQUAL (diff.intervals()[0].end().hourAsString(),   "12");
+    BOOST_CHECK_EQUAL (diff.intervals()[1].end().hourAsString(),   "15");
+    BOOST_CHECK_EQUAL (diff.duration(), 6*3600);
+    BOOST_CHECK_EQUAL (diff.netDifference(), 0);
+    BOOST_CHECK_EQUAL (std::abs(diff.maxDifference()), 1);
+}
@@ -0,0 +1,134 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_OccupancyProfile.cc
+ * \brief A collection of tests for the cgi::OccupancyProfile class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_OccupancyProfile
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <OccupancyProfile.h>
+
+//______________________________________________________________________________
+//                                                  OccupancyProfile_constructor
+
+/// Test creation of object
+BOOST_AUTO_TEST_CASE (OccupancyProfile_constructor)
+{
+    cgi::OccupancyProfile profile;
+
+    BOOST_CHECK_EQUAL (profile.size(), 0u);
+    BOOST_CHECK_EQUAL (profile.at(10), 0);
+    BOOST_CHECK_EQUAL (profile.maxNofVisitors(), 0);
+    BOOST_CHECK (profile.maxIntervals().empty());
+}
+
+//______________________________________________________________________________
+//                                                      OccupancyProfile_queries
+
+/// Test the queries against counting the visits tick by tick
+BOOST_AUTO_TEST_CASE (OccupancyProfile_queries)
+{
+    std::srand(42);
+
+    std::vector<std::int64_t> timesEntry;
+    std::vector<std::int64_t> timesExit;
+    std::vector<cgi::Event> events;
+    for (std::size_t n=0; n<40; ++n) {
+        timesEntry.push_back(std::rand() % 90);
+        timesExit.push_back(timesEntry.back() + 1 + std::rand() % 10);
+        events.push_back(cgi::Event(timesEntry.back(), true));
+        events.push_back(cgi::Event(timesExit.back(), false));
+    }
+    std::sort(events.begin(), events.end());
+
+    /* Number of visitors per tick */
+    std::vector<int> counts (110, 0);
+    for (std::size_t n=0; n<timesEntry.size(); ++n) {
+        for (std::int64_t t=timesEntry[n]; t<timesExit[n]; ++t) {
+            ++counts[t];
+        }
+    }
+
+    cgi::OccupancyProfile profile (events);
+
+    for (std::int64_t t=0; t<110; ++t) {
+        BOOST_CHECK_EQUAL (profile.at(t), counts[t]);
+    }
+    BOOST_CHECK_EQUAL (profile.at(-5), 0);
+    BOOST_CHECK_EQUAL (profile.maxNofVisitors(), *std::max_element(counts.begin(), counts.end()));
+
+    /* Time windows of various sizes */
+    for (std::int64_t begin=0; begin<110; begin+=7) {
+        for (std::int64_t end=begin+1; end<=110; end+=11) {
+            int max = *std::max_element(counts.begin()+begin, counts.begin()+end);
+            BOOST_CHECK_EQUAL (profile.maxNofVisitors(begin, end), max);
+
+            cgi::IntervalSet<std::int64_t,int> expected;
+            if (max > 0) {
+                for (std::int64_t t=begin; t<end; ++t) {
+                    if (counts[t] == max) {
+                        expected.insert(t, t+1, max);
+                    }
+                }
+            }
+
+            cgi::IntervalSet<std::int64_t,int> intervals = profile.maxIntervals(begin, end);
+            BOOST_CHECK_EQUAL (intervals.size(), expected.size());
+            for (std::size_t n=0; n<intervals.size() && n<expected.size(); ++n) {
+                BOOST_CHECK_EQUAL (intervals[n].begin(), expected[n].begin());
+                BOOST_CHECK_EQUAL (intervals[n].end(), expected[n].end());
+                BOOST_CHECK_EQUAL (intervals[n].value(), max);
+            }
+        }
+    }
+}
+
+//______________________________________________________________________________
+//                                                         OccupancyProfile_view
+
+/// Test profiles referring to existing arrays, and copies of profiles
+BOOST_AUTO_TEST_CASE (OccupancyProfile_view)
+{
+    std::vector<cgi::Event> events;
+    events.push_back(cgi::Event(10, true));
+    events.push_back(cgi::Event(20, true));
+    events.push_back(cgi::Event(30, false));
+    events.push_back(cgi::Event(40, false));
+
+    cgi::OccupancyProfile* profile = new cgi::OccupancyProfile(events);
+    BOOST_CHECK_EQUAL (profile->treeSize(), 8u);
+
+    /* View onto the arrays of the profile */
+    cgi::OccupancyProfile view (profile->times(), profile->counts(), profile->size(), profile->tree());
+    BOOST_CHECK_EQUAL (view.size(), 4u);
+    BOOST_CHECK_EQUAL (view.at(25), 2);
+    BOOST_CHECK_EQUAL (view.maxNofVisitors(0, 20), 1);
+    BOOST_CHECK_EQUAL (view.maxIntervals().size(), 1u);
+
+    /* A copy owns its arrays, independent of the original */
+    cgi::OccupancyProfile copy (*profile);
+    delete profile;
+    BOOST_CHECK_EQUAL (copy.at(25), 2);
+    BOOST_CHECK_EQUAL (copy.maxNofVisitors(), 2);
+
+    cgi::OccupancyProfile assigned;
+    assigned = copy;
+    copy     = cgi::OccupancyProfile();
+    BOOST_CHECK_EQUAL (assigned.at(35), 1);
+    BOOST_CHECK_EQUAL (copy.maxNofVisitors(), 0);
+
+    BOOST_CHECK_EQUAL (cgi::OccupancyProfile::nofLeaves(0), 1u);
+    BOOST_CHECK_EQUAL (cgi::OccupancyProfile::nofLeaves(5), 8u);
+}
@@ -0,0 +1,176 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_OccupancySnapshot.cc
+ * \brief A collection of tests for the cgi::OccupancySnapshot class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_OccupancySnapshot
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <OccupancySnapshot.h>
+
+#include "TestData.h"
+
+/// Test log, with an additional column
+std::vector<std::string> test_log ()
+{
+    std::vector<std::string> lines;
+    lines.push_back("10:00,13:00,visitor");
+    lines.push_back("08:00,11:00,staff");
+    lines.push_back("09:00,12:00,visitor");
+    lines.push_back("11:00,12:00,guide");
+    lines.push_back("12:30,12:45");
+    return lines;
+}
+
+//______________________________________________________________________________
+//                                                 OccupancySnapshot_constructor
+
+/// Test creation of object
+BOOST_AUTO_TEST_CASE (OccupancySnapshot_constructor)
+{
+    cgi::OccupancySnapshot snapshot;
+    BOOST_CHECK (!snapshot.isOpen());
+    BOOST_CHECK (!snapshot.isCurrent("test_OccupancySnapshot_missing.txt"));
+
+    cgi::OccupancySnapshot missing ("test_OccupancySnapshot_missing.snap");
+    BOOST_CHECK (!missing.isOpen());
+}
+
+//______________________________________________________________________________
+//                                                      OccupancySnapshot_write
+
+/// Test that the mapped snapshot reproduces log data and profile
+BOOST_AUTO_TEST_CASE (OccupancySnapshot_write)
+{
+    std::string filename = write_test_data("test_OccupancySnapshot_write.txt", test_log());
+    std::string snapname = "test_OccupancySnapshot_write.snap";
+
+    cgi::LogData data (filename);
+    cgi::OccupancyProfile profile (data.events());
+    BOOST_CHECK (cgi::OccupancySnapshot::write(snapname, filename, data, profile));
+
+    cgi::OccupancySnapshot snapshot (snapname);
+    BOOST_CHECK (snapshot.isOpen());
+    BOOST_CHECK (snapshot.isCurrent(filename));
+    BOOST_CHECK_EQUAL (snapshot.ticksPerSecond(), 1);
+    BOOST_CHECK (!snapshot.timeWindow().isBounded());
+
+    /* Log data */
+    BOOST_CHECK_EQUAL (snapshot.size(), data.size());
+    BOOST_CHECK (std::equal(data.timesEntry().begin(), data.timesEntry().end(), snapshot.timesEntry()));
+    BOOST_CHECK (std::equal(data.timesExit().begin(), data.timesExit().end(), snapshot.timesExit()));
+    BOOST_CHECK_EQUAL (snapshot.rangeOfTimes().first, data.timesEntry().front());
+    BOOST_CHECK_EQUAL (snapshot.rangeOfTimes().second,
+                       cgi::LogData::clock_type::fromDateTime(data.rangeOfTimes().second));
+
+    /* Additional columns */
+    BOOST_CHECK_EQUAL (snapshot.nofColumns(), 1u);
+    BOOST_CHECK_EQUAL (snapshot.dictionarySize(0), data.dictionary(0).size());
+    for (std::size_t n=0; n<data.size(); ++n) {
+        BOOST_CHECK_EQUAL (snapshot.column(0)[n], data.column(0)[n]);
+        BOOST_CHECK_EQUAL (snapshot.dictionaryValue(0, snapshot.column(0)[n]),
+                           data.dictionary(0)[data.column(0)[n]]);
+    }
+    BOOST_CHECK_THROW (snapshot.dictionaryValue(0, 17), const char*);
+
+    /* Profile, referring to the mapping */
+    const cgi::OccupancyProfile& mapped = snapshot.profile();
+    BOOST_CHECK_EQUAL (mapped.size(), profile.size());
+    BOOST_CHECK_EQUAL (mapped.maxNofVisitors(), profile.maxNofVisitors());
+    BOOST_CHECK_EQUAL (mapped.maxNofVisitors(), 3);
+    cgi::IntervalSet<std::int64_t,int> intervals = mapped.maxIntervals();
+    cgi::IntervalSet<std::int64_t,int> expected  = profile.maxIntervals();
+    BOOST_CHECK_EQUAL (intervals.size(), expected.size());
+    for (std::size_t n=0; n<std::min(intervals.size(), expected.size()); ++n) {
+        BOOST_CHECK_EQUAL (intervals[n].begin(), expected[n].begin());
+        BOOST_CHECK_EQUAL (intervals[n].end(), expected[n].end());
+    }
+    std::int64_t first = data.timesEntry().front();
+    for (std::int64_t t=first-600; t<first+6*3600; t+=300) {
+        BOOST_CHECK_EQUAL (mapped.at(t), profile.at(t));
+        BOOST_CHECK_EQUAL (mapped.maxNofVisitors(first, t), profile.maxNofVisitors(first, t));
+    }
+}
+
+//______________________________________________________________________________
+//                                                    OccupancySnapshot_isCurrent
+
+/// Test detection of snapshots not matching the log
+BOOST_AUTO_TEST_CASE (OccupancySnapshot_isCurrent)
+{
+    std::vector<std::string> lines = test_log();
+    std::string filename = write_test_data("test_OccupancySnapshot_current.txt", lines);
+    std::string snapname = "test_OccupancySnapshot_current.snap";
+
+    cgi::TimeWindow window (0, cgi::LogEntryView::startOfDay() + 12*3600);
+    cgi::LogData data;
+    data.setTimeWindow(cgi::DateTime(window.begin()), cgi::DateTime(window.end()));
+    data.readData(filename);
+    BOOST_CHECK (cgi::OccupancySnapshot::write(snapname, filename, data,
+                                               cgi::OccupancyProfile(data.events()), window));
+
+    cgi::OccupancySnapshot snapshot (snapname);
+    BOOST_CHECK_EQUAL (snapshot.size(), 4u);
+    BOOST_CHECK (snapshot.isCurrent(filename, window));
+    BOOST_CHECK (!snapshot.isCurrent(filename));
+    BOOST_CHECK (!snapshot.isCurrent(filename, window, 1000));
+
+    /* Modified log */
+    lines.push_back("14:00,15:00");
+    write_test_data(filename, lines);
+    BOOST_CHECK (!snapshot.isCurrent(filename, window));
+}
+
+//______________________________________________________________________________
+//                                                      OccupancySnapshot_invalid
+
+/// Test rejection of files other than valid snapshots
+BOOST_AUTO_TEST_CASE (OccupancySnapshot_invalid)
+{
+    std::string filename = write_test_data("test_OccupancySnapshot_invalid.txt", test_log());
+    std::string snapname = "test_OccupancySnapshot_invalid.snap";
+
+    /* Not a snapshot at all */
+    cgi::OccupancySnapshot snapshot;
+    BOOST_CHECK (!snapshot.open(filename));
+    BOOST_CHECK (!snapshot.isOpen());
+
+    cgi::LogData data (filename);
+    BOOST_CHECK (cgi::OccupancySnapshot::write(snapname, filename, data,
+                                               cgi::OccupancyProfile(data.events())));
+    BOOST_CHECK (snapshot.open(snapname));
+
+    std::string contents;
+    {
+        std::ifstream infile (snapname.c_str(), std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(infile), std::istreambuf_iterator<char>());
+    }
+
+    /* Other format version */
+    std::string modified = contents;
+    modified[8] += 1;
+    std::ofstream (snapname.c_str(), std::ios::binary) << modified;
+    BOOST_CHECK (!snapshot.open(snapname));
+
+    /* Truncated file */
+    std::ofstream (snapname.c_str(), std::ios::binary) << contents.substr(0, contents.size()-8);
+    BOOST_CHECK (!snapshot.open(snapname));
+
+    /* Original file */
+    std::ofstream (snapname.c_str(), std::ios::binary) << contents;
+    BOOST_CHECK (snapshot.open(snapname));
+    BOOST_CHECK_EQUAL (snapshot.profile().maxNofVisitors(), 3);
+}
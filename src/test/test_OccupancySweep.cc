@@ -0,0 +1,133 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_OccupancySweep.cc
+ * \brief A collection of tests for the cgi::OccupancySweep class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_OccupancySweep
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <OccupancySweep.h>
+
+//______________________________________________________________________________
+//                                                    OccupancySweep_constructor
+
+/// Test creation of object
+BOOST_AUTO_TEST_CASE (OccupancySweep_constructor)
+{
+    cgi::OccupancySweep sweep;
+    sweep.finish();
+
+    BOOST_CHECK_EQUAL (sweep.maxNofVisitors(), 0);
+    BOOST_CHECK (sweep.timeline().empty());
+    BOOST_CHECK (sweep.maxIntervals().empty());
+}
+
+//______________________________________________________________________________
+//                                                          OccupancySweep_steps
+
+/// Test sweep along the events for build-up and turnover of visitors
+BOOST_AUTO_TEST_CASE (OccupancySweep_steps)
+{
+    /* 08:00-11:00, 09:00-12:00, 10:00-13:00 and 11:00-12:00 (in hours) */
+    std::vector<cgi::Event> events;
+    events.push_back(cgi::Event(8, true));
+    events.push_back(cgi::Event(11, false));
+    events.push_back(cgi::Event(9, true));
+    events.push_back(cgi::Event(12, false));
+    events.push_back(cgi::Event(10, true));
+    events.push_back(cgi::Event(13, false));
+    events.push_back(cgi::Event(11, true));
+    events.push_back(cgi::Event(12, false));
+    std::sort(events.begin(), events.end());
+
+    cgi::OccupancySweep sweep;
+    for (auto it=events.begin(); it!=events.end(); ++it) {
+        sweep.add(*it);
+    }
+    sweep.finish();
+
+    std::vector<cgi::TimePoint> timeline = sweep.timeline();
+
+    BOOST_CHECK_EQUAL (timeline.size(), 6u);
+    BOOST_CHECK_EQUAL (timeline[0].count(), 1);
+    BOOST_CHECK_EQUAL (timeline[1].count(), 2);
+    BOOST_CHECK_EQUAL (timeline[2].count(), 3);
+    BOOST_CHECK_EQUAL (timeline[3].count(), 3);
+    BOOST_CHECK_EQUAL (timeline[4].count(), 1);
+    BOOST_CHECK_EQUAL (timeline[5].count(), 0);
+
+    BOOST_CHECK_EQUAL (sweep.maxNofVisitors(), 3);
+    /* Plateau from 10 to 12, with a visitor leaving and one entering at 11 */
+    BOOST_CHECK_EQUAL (sweep.maxIntervals().size(), 1u);
+    BOOST_CHECK_EQUAL (sweep.maxIntervals()[0].begin().rawtime(), 10);
+    BOOST_CHECK_EQUAL (sweep.maxIntervals()[0].end().rawtime(),   12);
+
+    /* Without recording of the timeline */
+    cgi::OccupancySweep sweep2 (false);
+    for (auto it=events.begin(); it!=events.end(); ++it) {
+        sweep2.add(*it);
+    }
+    sweep2.finish();
+
+    BOOST_CHECK (sweep2.timeline().empty());
+    BOOST_CHECK_EQUAL (sweep2.maxNofVisitors(), 3);
+}
+
+//______________________________________________________________________________
+//                                                     OccupancySweep_writeRead
+
+/// Test saving and restoring the outcome of a sweep
+BOOST_AUTO_TEST_CASE (OccupancySweep_writeRead)
+{
+    /* 08:00-10:00, 09:00-11:00 and 12:00-13:00 (in hours) */
+    std::vector<cgi::Event> events;
+    events.push_back(cgi::Event(8, true));
+    events.push_back(cgi::Event(9, true));
+    events.push_back(cgi::Event(10, false));
+    events.push_back(cgi::Event(11, false));
+    events.push_back(cgi::Event(12, true));
+    events.push_back(cgi::Event(13, false));
+
+    cgi::OccupancySweep sweep;
+    for (auto it=events.begin(); it!=events.end(); ++it) {
+        sweep.add(*it);
+    }
+    sweep.finish();
+
+    std::stringstream buffer;
+    sweep.write(buffer);
+
+    cgi::OccupancySweep restored = cgi::OccupancySweep::read(buffer);
+
+    BOOST_CHECK_EQUAL (restored.maxNofVisitors(), sweep.maxNofVisitors());
+    BOOST_CHECK_EQUAL (restored.timeline().size(), sweep.timeline().size());
+    for (std::size_t n=0; n<sweep.timeline().size(); ++n) {
+        BOOST_CHECK_EQUAL (restored.timeline()[n].time().rawtime(),
+                           sweep.timeline()[n].time().rawtime());
+        BOOST_CHECK_EQUAL (restored.timeline()[n].count(),
+                           sweep.timeline()[n].count());
+    }
+    BOOST_CHECK_EQUAL (restored.maxIntervals().size(), 1u);
+    BOOST_CHECK_EQUAL (restored.maxIntervals()[0].begin().rawtime(), 9);
+    BOOST_CHECK_EQUAL (restored.maxIntervals()[0].end().rawtime(),   10);
+
+    /* Anything else is rejected */
+    std::stringstream garbage ("CGISWEEP 1\nmax 2\ntimeline 3\n8 1\n");
+    BOOST_CHECK_THROW (cgi::OccupancySweep::read(garbage), const char*);
+
+    /* A corrupted size is reported as truncated, not as lack of memory */
+    std::stringstream corrupted ("CGISWEEP 1\nmax 2\ntimeline 999999999999999\n8 1\n");
+    BOOST_CHECK_THROW (cgi::OccupancySweep::read(corrupted), const char*);
+}
@@ -0,0 +1,133 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_OutputBuffer.cc
+ * \brief A collection of tests for the cgi::OutputBuffer class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_OutputBuffer
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <OutputBuffer.h>
+
+//______________________________________________________________________________
+//                                                                read_test_data
+
+/// Read back the contents of a file
+std::string read_test_data (const std::string& filename)
+{
+    std::ifstream infile (filename.c_str(), std::ios::binary);
+    std::ostringstream os;
+    os << infile.rdbuf();
+    return os.str();
+}
+
+/// Open a file for writing, returning its file descriptor
+int open_test_data (const std::string& filename)
+{
+    return open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
+//______________________________________________________________________________
+//                                                        OutputBuffer_constructor
+
+/// Test creation of object
+BOOST_AUTO_TEST_CASE (OutputBuffer_constructor)
+{
+    cgi::OutputBuffer output (1, 4096);
+
+    BOOST_CHECK_EQUAL (output.fd(), 1);
+    BOOST_CHECK_EQUAL (output.capacity(), 4096u);
+    BOOST_CHECK_EQUAL (output.size(), 0u);
+    BOOST_CHECK_EQUAL (output.bytesWritten(), 0u);
+    BOOST_CHECK (output.good());
+}
+
+//______________________________________________________________________________
+//                                                            OutputBuffer_write
+
+/// Test buffering of output, without writing before the buffer is full
+BOOST_AUTO_TEST_CASE (OutputBuffer_write)
+{
+    std::string filename ("test_OutputBuffer_write.txt");
+    int fd = open_test_data(filename);
+    BOOST_REQUIRE (fd >= 0);
+
+    {
+        cgi::OutputBuffer output (fd, 16);
+
+        output.write("08:00-09:00;");
+        output.writeInt(3);
+        output.put('\n');
+        BOOST_CHECK_EQUAL (output.size(), 14u);
+        BOOST_CHECK_EQUAL (output.bytesWritten(), 0u);
+
+        /* Exceeding the capacity hands the buffer over */
+        output.write("09:00-10:00;");
+        BOOST_CHECK_EQUAL (output.bytesWritten(), 14u);
+        BOOST_CHECK_EQUAL (output.size(), 12u);
+
+        output.writeInt(-12);
+        output.put('\n');
+        output.writeInt(0);
+        output.writeInt(std::numeric_limits<std::int64_t>::min());
+        output.put(';');
+        output.writeFixed(7.125);
+        output.put(';');
+        output.writeFixed(-0.5, 3);
+        output.put(';');
+        output.writeFixed(2.0, 0);
+    }
+    close(fd);
+
+    BOOST_CHECK_EQUAL (read_test_data(filename),
+                       "08:00-09:00;3\n09:00-10:00;-12\n0-9223372036854775808;7.13;-0.500;2");
+
+    std::remove(filename.c_str());
+}
+
+//______________________________________________________________________________
+//                                                       OutputBuffer_writeLarge
+
+/// Test writing of blocks larger than the buffer, along with its contents
+BOOST_AUTO_TEST_CASE (OutputBuffer_writeLarge)
+{
+    std::string filename ("test_OutputBuffer_large.txt");
+    int fd = open_test_data(filename);
+    BOOST_REQUIRE (fd >= 0);
+
+    std::string block (100000, 'x');
+    for (std::size_t n=0; n<block.size(); n+=7) {
+        block[n] = char('a' + n%26);
+    }
+
+    {
+        cgi::OutputBuffer output (fd, 64);
+        output.write("head;");
+        output.write(block);
+        BOOST_CHECK_EQUAL (output.size(), 0u);
+        BOOST_CHECK_EQUAL (output.bytesWritten(), 5u + block.size());
+        output.write(";tail");
+        output.flush();
+        BOOST_CHECK (output.good());
+    }
+    close(fd);
+
+    BOOST_CHECK (read_test_data(filename) == "head;" + block + ";tail");
+
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,193 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_PartialAggregate.cc
+ * \brief A collection of tests for the cgi::PartialAggregate class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_PartialAggregate
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <OccupancySweep.h>
+#include <PartialAggregate.h>
+
+/// Events for 08:00-11:00, 09:00-12:00, 10:00-13:00 and 11:00-12:00 (in hours)
+std::vector<cgi::Event> test_events ()
+{
+    std::vector<cgi::Event> events;
+    events.push_back(cgi::Event(8, true));
+    events.push_back(cgi::Event(11, false));
+    events.push_back(cgi::Event(9, true));
+    events.push_back(cgi::Event(12, false));
+    events.push_back(cgi::Event(10, true));
+    events.push_back(cgi::Event(13, false));
+    events.push_back(cgi::Event(11, true));
+    events.push_back(cgi::Event(12, false));
+    std::sort(events.begin(), events.end());
+
+    return events;
+}
+
+/// Compute the partial aggregate for a time shard
+cgi::PartialAggregate aggregate (const std::vector<cgi::Event>& events,
+                                 const cgi::TimeWindow& shard)
+{
+    cgi::PartialAggregate result (shard);
+    for (auto it=events.begin(); it!=events.end(); ++it) {
+        result.add(*it);
+    }
+    result.finish();
+
+    return result;
+}
+
+//______________________________________________________________________________
+//                                                  PartialAggregate_constructor
+
+/// Test creation of object
+BOOST_AUTO_TEST_CASE (PartialAggregate_constructor)
+{
+    cgi::PartialAggregate partial;
+    partial.finish();
+
+    BOOST_CHECK (!partial.window().isBounded());
+    BOOST_CHECK_EQUAL (partial.startCount(), 0);
+    BOOST_CHECK_EQUAL (partial.netDelta(), 0);
+    BOOST_CHECK_EQUAL (partial.maxNofVisitors(), 0);
+    BOOST_CHECK (partial.maxIntervals().empty());
+}
+
+//______________________________________________________________________________
+//                                                      PartialAggregate_shard
+
+/// Test the statistics for a single time shard
+BOOST_AUTO_TEST_CASE (PartialAggregate_shard)
+{
+    cgi::PartialAggregate partial = aggregate(test_events(), cgi::TimeWindow(10, 12));
+
+    /* 2 visitors at 10:00, 3 during 10:00-12:00, 1 at 12:00 */
+    BOOST_CHECK_EQUAL (partial.startCount(), 2);
+    BOOST_CHECK_EQUAL (partial.netDelta(), 1);
+    BOOST_CHECK_EQUAL (partial.peak(), 1);
+    BOOST_CHECK_EQUAL (partial.maxNofVisitors(), 3);
+
+    cgi::IntervalSet<std::int64_t,int> intervals = partial.maxIntervals();
+    BOOST_CHECK_EQUAL (intervals.size(), 1u);
+    BOOST_CHECK_EQUAL (intervals[0].begin(), 10);
+    BOOST_CHECK_EQUAL (intervals[0].end(), 12);
+    BOOST_CHECK_EQUAL (intervals[0].value(), 3);
+
+    /* Shard without any events: constant number of visitors */
+    partial = aggregate(test_events(), cgi::TimeWindow(14, 16));
+    BOOST_CHECK_EQUAL (partial.startCount(), 0);
+    BOOST_CHECK_EQUAL (partial.maxNofVisitors(), 0);
+    BOOST_CHECK (partial.maxIntervals().empty());
+}
+
+//______________________________________________________________________________
+//                                                       PartialAggregate_merge
+
+/// Test merging the shards reproduces the statistics for the data as a whole
+BOOST_AUTO_TEST_CASE (PartialAggregate_merge)
+{
+    std::vector<cgi::Event> events = test_events();
+
+    cgi::OccupancySweep sweep (false);
+    for (auto it=events.begin(); it!=events.end(); ++it) {
+        sweep.add(*it);
+    }
+    sweep.finish();
+
+    /* Split at every pair of points in time, including inside the plateau */
+    for (std::int64_t first=7; first<=14; ++first) {
+        for (std::int64_t second=first; second<=14; ++second) {
+            std::vector<cgi::PartialAggregate> shards;
+            shards.push_back(aggregate(events, cgi::TimeWindow(second, std::numeric_limits<std::int64_t>::max())));
+            shards.push_back(aggregate(events, cgi::TimeWindow(std::numeric_limits<std::int64_t>::min(), first)));
+            shards.push_back(aggregate(events, cgi::TimeWindow(first, second)));
+
+            cgi::PartialAggregate merged = cgi::PartialAggregate::merge(shards);
+            BOOST_CHECK (!merged.window().isBounded());
+            BOOST_CHECK_EQUAL (merged.startCount(), 0);
+            BOOST_CHECK_EQUAL (merged.netDelta(), 0);
+            BOOST_CHECK_EQUAL (merged.maxNofVisitors(), sweep.maxNofVisitors());
+
+            cgi::IntervalSet<std::int64_t,int> intervals = merged.maxIntervals();
+            BOOST_CHECK_EQUAL (intervals.size(), sweep.maxIntervals().size());
+            for (std::size_t n=0; n<intervals.size(); ++n) {
+                BOOST_CHECK_EQUAL (intervals[n].begin(), sweep.maxIntervals()[n].begin().rawtime());
+                BOOST_CHECK_EQUAL (intervals[n].end(), sweep.maxIntervals()[n].end().rawtime());
+                BOOST_CHECK_EQUAL (intervals[n].value(), sweep.maxIntervals()[n].value());
+            }
+        }
+    }
+
+    /* Shards not adjacent to each other */
+    cgi::PartialAggregate a = aggregate(events, cgi::TimeWindow(8, 10));
+    cgi::PartialAggregate b = aggregate(events, cgi::TimeWindow(11, 12));
+    BOOST_CHECK_THROW (a.merge(b), const char*);
+
+    /* Shards computed from different data */
+    events.push_back(cgi::Event(9, true));
+    events.push_back(cgi::Event(10, false));
+    std::sort(events.begin(), events.end());
+    b = aggregate(events, cgi::TimeWindow(10, 12));
+    BOOST_CHECK_THROW (a.merge(b), const char*);
+}
+
+//______________________________________________________________________________
+//                                                 PartialAggregate_inputWindow
+
+/// Test the time window required as input for a shard
+BOOST_AUTO_TEST_CASE (PartialAggregate_inputWindow)
+{
+    cgi::TimeWindow window = cgi::PartialAggregate::inputWindow(cgi::TimeWindow(11, 12));
+
+    /* Visit ending at the begin of the shard is part of the boundary occupancy */
+    BOOST_CHECK (window.admits(8, 11));
+    BOOST_CHECK (!window.admits(8, 10));
+    BOOST_CHECK (!window.admits(12, 13));
+
+    window = cgi::PartialAggregate::inputWindow(cgi::TimeWindow());
+    BOOST_CHECK (!window.hasBegin());
+    BOOST_CHECK (!window.hasEnd());
+}
+
+//______________________________________________________________________________
+//                                                     PartialAggregate_readWrite
+
+/// Test round trip through the serialization format
+BOOST_AUTO_TEST_CASE (PartialAggregate_readWrite)
+{
+    cgi::PartialAggregate partial = aggregate(test_events(), cgi::TimeWindow(9, 12));
+
+    std::stringstream stream;
+    partial.write(stream);
+    std::cout << stream.str();
+
+    cgi::PartialAggregate copy = cgi::PartialAggregate::read(stream);
+    BOOST_CHECK_EQUAL (copy.window().begin(), 9);
+    BOOST_CHECK_EQUAL (copy.window().end(), 12);
+    BOOST_CHECK_EQUAL (copy.startCount(), partial.startCount());
+    BOOST_CHECK_EQUAL (copy.netDelta(), partial.netDelta());
+    BOOST_CHECK_EQUAL (copy.peak(), partial.peak());
+    BOOST_CHECK_EQUAL (copy.peakIntervals().size(), partial.peakIntervals().size());
+    BOOST_CHECK_EQUAL (copy.maxIntervals()[0].begin(), partial.maxIntervals()[0].begin());
+    BOOST_CHECK_EQUAL (copy.maxIntervals()[0].end(), partial.maxIntervals()[0].end());
+
+    std::stringstream garbage ("CGIPARTIAL 1\nwindow 9\n");
+    BOOST_CHECK_THROW (cgi::PartialAggregate::read(garbage), const char*);
+
+    std::stringstream unknown ("something else\n");
+    BOOST_CHECK_THROW (cgi::PartialAggregate::read(unknown), const char*);
+}
@@ -0,0 +1,63 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_PolymorphicAllocator.cc
+ * \brief A collection of tests for the cgi::PolymorphicAllocator class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_PolymorphicAllocator
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <MonotonicArena.h>
+#include <PolymorphicAllocator.h>
+
+//______________________________________________________________________________
+//                                              PolymorphicAllocator_constructor
+
+/// Test creation of object
+BOOST_AUTO_TEST_CASE (PolymorphicAllocator_constructor)
+{
+    cgi::MonotonicArena arena;
+
+    cgi::PolymorphicAllocator<int> alloc1;
+    BOOST_CHECK (alloc1.resource() == cgi::newDeleteResource());
+
+    cgi::PolymorphicAllocator<int> alloc2 (&arena);
+    BOOST_CHECK (alloc2.resource() == &arena);
+
+    cgi::PolymorphicAllocator<double> alloc3 (alloc2);
+    BOOST_CHECK (alloc3.resource() == &arena);
+
+    BOOST_CHECK (alloc2 == alloc3);
+    BOOST_CHECK (alloc1 != alloc2);
+}
+
+//______________________________________________________________________________
+//                                                   PolymorphicAllocator_vector
+
+/// Test use of the allocator with a container
+BOOST_AUTO_TEST_CASE (PolymorphicAllocator_vector)
+{
+    typedef std::vector<int, cgi::PolymorphicAllocator<int> > Vector;
+
+    cgi::MonotonicArena arena;
+    Vector vec (&arena);
+
+    for (int n=0; n<1000; ++n) {
+        vec.push_back(n);
+    }
+    BOOST_CHECK_EQUAL (vec.size(), 1000u);
+    BOOST_CHECK (vec.get_allocator().resource() == &arena);
+
+    /* A copy does not inherit the resource of the original */
+    Vector copy (vec);
+    BOOST_CHECK (copy.get_allocator().resource() == cgi::newDeleteResource());
+    BOOST_CHECK (copy == vec);
+}
@@ -0,0 +1,105 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_PrefixScan.cc
+ * \brief A collection of tests for the cgi::PrefixScan class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_PrefixScan
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <PrefixScan.h>
+
+//______________________________________________________________________________
+//                                                             PrefixScan_kernel
+
+/// Test selection of the kernel
+BOOST_AUTO_TEST_CASE (PrefixScan_kernel)
+{
+    cgi::PrefixScan::Kernel kernel = cgi::PrefixScan::kernel();
+    std::cout << "Kernel: " << cgi::PrefixScan::name(kernel) << std::endl;
+
+    BOOST_CHECK (cgi::PrefixScan::isSupported(cgi::PrefixScan::Scalar));
+    BOOST_CHECK (cgi::PrefixScan::isSupported(kernel));
+    BOOST_CHECK_EQUAL (std::string(cgi::PrefixScan::name(cgi::PrefixScan::AVX2)), "avx2");
+}
+
+//______________________________________________________________________________
+//                                                               PrefixScan_scan
+
+/// Test running sum and maximum for a small array
+BOOST_AUTO_TEST_CASE (PrefixScan_scan)
+{
+    cgi::IntervalSet<std::size_t,std::int32_t> runs;
+
+    /* Empty array */
+    BOOST_CHECK_EQUAL (cgi::PrefixScan::scan(NULL, NULL, 0, runs), 0);
+    BOOST_CHECK (runs.empty());
+
+    /* Two plateaus at the maximum, with carry-in of one visitor */
+    std::int32_t delta[] = { 1, 1, 0, -1, 1, 0, -2, 0 };
+    std::int32_t sum[8];
+    std::int32_t expected[] = { 2, 3, 3, 2, 3, 3, 1, 1 };
+
+    BOOST_CHECK_EQUAL (cgi::PrefixScan::scan(delta, sum, 8, runs, 1), 3);
+    for (std::size_t n=0; n<8; ++n) {
+        BOOST_CHECK_EQUAL (sum[n], expected[n]);
+    }
+    BOOST_CHECK_EQUAL (runs.size(), 2u);
+    BOOST_CHECK_EQUAL (runs[0].begin(), 1u);
+    BOOST_CHECK_EQUAL (runs[0].end(), 3u);
+    BOOST_CHECK_EQUAL (runs[1].begin(), 4u);
+    BOOST_CHECK_EQUAL (runs[1].end(), 6u);
+    BOOST_CHECK_EQUAL (runs[1].value(), 3);
+}
+
+//______________________________________________________________________________
+//                                                            PrefixScan_kernels
+
+/// Test the vectorized kernels against the scalar one
+BOOST_AUTO_TEST_CASE (PrefixScan_kernels)
+{
+    cgi::PrefixScan::Kernel kernels[] = { cgi::PrefixScan::AVX2, cgi::PrefixScan::AVX512 };
+    std::size_t sizes[]               = { 1, 7, 8, 9, 15, 16, 17, 33, 1000, 4099 };
+
+    std::srand(42);
+
+    for (std::size_t s=0; s<sizeof(sizes)/sizeof(sizes[0]); ++s) {
+        /* Random walk with small steps, such that the maximum is reached repeatedly */
+        std::vector<std::int32_t> delta (sizes[s]);
+        for (std::size_t n=0; n<delta.size(); ++n) {
+            delta[n] = std::rand() % 3 - 1;
+        }
+
+        std::vector<std::int32_t> expected (delta.size());
+        cgi::IntervalSet<std::size_t,std::int32_t> runsExpected;
+        std::int32_t maxExpected = cgi::PrefixScan::scan(cgi::PrefixScan::Scalar,
+                                                         delta.data(), expected.data(),
+                                                         delta.size(), runsExpected, 5);
+
+        for (std::size_t k=0; k<2; ++k) {
+            /* in-place, as done by cgi::LogData::maxNofVisitors() */
+            std::vector<std::int32_t> sum (delta);
+            cgi::IntervalSet<std::size_t,std::int32_t> runs;
+            std::int32_t max = cgi::PrefixScan::scan(kernels[k], sum.data(), sum.data(),
+                                                     sum.size(), runs, 5);
+
+            BOOST_CHECK_EQUAL (max, maxExpected);
+            BOOST_CHECK (sum == expected);
+            BOOST_CHECK_EQUAL (runs.size(), runsExpected.size());
+            for (std::size_t n=0; n<runs.size() && n<runsExpected.size(); ++n) {
+                BOOST_CHECK_EQUAL (runs[n].begin(), runsExpected[n].begin());
+                BOOST_CHECK_EQUAL (runs[n].end(), runsExpected[n].end());
+            }
+        }
+    }
+}
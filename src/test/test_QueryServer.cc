@@ -0,0 +1,286 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_QueryServer.cc
+ * \brief A collection of tests for the cgi::QueryServer class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_QueryServer
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <QueryServer.h>
+
+#include "TestData.h"
+
+/// Test log: 08:00-11:00, 09:00-12:00, 10:00-13:00 and 11:00-12:00
+std::vector<std::string> test_log ()
+{
+    std::vector<std::string> lines;
+    lines.push_back("08:00,11:00");
+    lines.push_back("09:00,12:00");
+    lines.push_back("10:00,13:00");
+    lines.push_back("11:00,12:00");
+    return lines;
+}
+
+/// Connect to the server at `path`, waiting for it to come up
+int connect_client (const std::string& path)
+{
+    struct sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path)-1);
+
+    int client = -1;
+    for (int n=0; n<100 && client < 0; ++n) {
+        client = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connect(client, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+            close(client);
+            client = -1;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    return client;
+}
+
+/// Get the ISO 8601 timestamp for a time of day, as used in responses
+std::string timestamp (const std::string& time)
+{
+    std::ostringstream os;
+    os << cgi::DateTime(time, "%H:%M");
+    return os.str();
+}
+
+//______________________________________________________________________________
+//                                                            QueryServer_answer
+
+/// Test answering of requests
+BOOST_AUTO_TEST_CASE (QueryServer_answer)
+{
+    cgi::QueryServer server (write_test_data("test_QueryServer_answer.txt", test_log()));
+
+    BOOST_CHECK_EQUAL (server.generation(), 1u);
+    BOOST_CHECK_EQUAL (server.answer("MAX"),
+                       "OK 3 " + timestamp("10:00") + "/" + timestamp("12:00"));
+    BOOST_CHECK_EQUAL (server.answer("AT 08:30"), "OK 1");
+    BOOST_CHECK_EQUAL (server.answer("at 12:00"), "OK 1");
+    BOOST_CHECK_EQUAL (server.answer("RANGE 08:00 09:30"),
+                       "OK 2 " + timestamp("09:00") + "/" + timestamp("09:30"));
+    BOOST_CHECK_EQUAL (server.answer("INFO"),
+                       "OK 4 " + timestamp("08:00") + "/" + timestamp("13:00") + " 1");
+
+    BOOST_CHECK_EQUAL (server.answer("AT"), "ERR Missing time");
+    BOOST_CHECK_EQUAL (server.answer("AT foo"), "ERR Invalid time");
+    BOOST_CHECK_EQUAL (server.answer("AT 25:99"), "ERR Invalid time");
+    BOOST_CHECK_EQUAL (server.answer("HELLO"), "ERR Unknown request");
+
+    /* Nothing to reload for an unchanged file */
+    BOOST_CHECK (!server.reload());
+}
+
+//______________________________________________________________________________
+//                                                            QueryServer_reload
+
+/// Test reloading the log once the file has changed
+BOOST_AUTO_TEST_CASE (QueryServer_reload)
+{
+    std::vector<std::string> lines = test_log();
+    std::string filename = write_test_data("test_QueryServer_reload.txt", lines);
+    cgi::QueryServer server (filename);
+    BOOST_CHECK_EQUAL (server.answer("AT 11:30"), "OK 3");
+
+    lines.push_back("11:15,11:45");
+    write_test_data(filename, lines);
+
+    BOOST_CHECK (server.reload());
+    BOOST_CHECK_EQUAL (server.generation(), 2u);
+    BOOST_CHECK_EQUAL (server.answer("AT 11:30"), "OK 4");
+}
+
+//______________________________________________________________________________
+//                                                          QueryServer_snapshot
+
+/// Test starting from a snapshot file instead of reading the log
+BOOST_AUTO_TEST_CASE (QueryServer_snapshot)
+{
+    std::string filename = write_test_data("test_QueryServer_snapshot.txt", test_log());
+    std::string snapshot = "test_QueryServer_snapshot.snap";
+    std::remove(snapshot.c_str());
+
+    std::string max;
+    std::string info;
+    {
+        cgi::QueryServer server (filename, cgi::TimeWindow(), 1000, snapshot);
+        max  = server.answer("MAX");
+        info = server.answer("INFO");
+    }
+
+    /* Up-to-date snapshot is mapped, answers are the same */
+    cgi::OccupancySnapshot mapped (snapshot);
+    BOOST_CHECK (mapped.isCurrent(filename));
+
+    cgi::QueryServer server (filename, cgi::TimeWindow(), 1000, snapshot);
+    BOOST_CHECK_EQUAL (server.answer("MAX"), max);
+    BOOST_CHECK_EQUAL (server.answer("INFO"), info);
+    BOOST_CHECK_EQUAL (server.answer("AT 11:30"), "OK 3");
+
+    /* A different time window does not match the snapshot */
+    cgi::TimeWindow window (mapped.rangeOfTimes().first + 3*3600, mapped.rangeOfTimes().second);
+    BOOST_CHECK (!mapped.isCurrent(filename, window));
+    cgi::QueryServer restricted (filename, window, 1000, snapshot);
+    BOOST_CHECK_EQUAL (restricted.answer("AT 08:30"), "OK 0");
+}
+
+//______________________________________________________________________________
+//                                                             QueryServer_serve
+
+/// Test serving requests over a Unix domain socket
+BOOST_AUTO_TEST_CASE (QueryServer_serve)
+{
+    std::string filename = write_test_data("test_QueryServer_serve.txt", test_log());
+    std::string path     = "test_QueryServer_serve.sock";
+    cgi::QueryServer server (filename, cgi::TimeWindow(), 100);
+
+    int status = -1;
+    std::thread thread ([&] () {
+            status = server.serve(path);
+        });
+
+    /* Wait for the server to come up */
+    int client = connect_client(path);
+    BOOST_REQUIRE (client >= 0);
+
+    /* Two requests in one go, with response per line */
+    std::string request = "AT 10:30\nAT 11:30\n";
+    BOOST_CHECK_EQUAL (send(client, request.data(), request.size(), 0), ssize_t(request.size()));
+
+    std::string response;
+    char data[256];
+    auto start = std::chrono::steady_clock::now();
+    while (std::count(response.begin(), response.end(), '\n') < 2) {
+        ssize_t n = recv(client, data, sizeof(data), 0);
+        BOOST_REQUIRE (n > 0);
+        response.append(data, n);
+    }
+    double ms = std::chrono::duration<double,std::milli>(std::chrono::steady_clock::now()-start).count();
+    std::cout << "Round trip for two requests: " << ms << " ms" << std::endl;
+
+    BOOST_CHECK_EQUAL (response, "OK 3\nOK 3\n");
+
+    /* Changes to the log are picked up in the background */
+    std::vector<std::string> lines = test_log();
+    lines.push_back("11:15,11:45");
+    write_test_data(filename, lines);
+    for (int n=0; n<100 && server.generation() < 2; ++n) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    BOOST_CHECK_EQUAL (server.generation(), 2u);
+
+    /* A request line exceeding the limit gets the client disconnected */
+    request = std::string(cgi::QueryServer::maxRequestSize+1, 'A');
+    BOOST_CHECK_EQUAL (send(client, request.data(), request.size(), 0), ssize_t(request.size()));
+    response.clear();
+    for (ssize_t n=1; n > 0; ) {
+        n = recv(client, data, sizeof(data), 0);
+        if (n > 0) {
+            response.append(data, n);
+        }
+    }
+    BOOST_CHECK_EQUAL (response, "ERR Request too long\n");
+
+    close(client);
+    server.stop();
+    thread.join();
+
+    BOOST_CHECK_EQUAL (status, 0);
+    BOOST_CHECK (access(path.c_str(), F_OK) != 0);
+}
+
+//______________________________________________________________________________
+//                                                        QueryServer_slowClient
+
+/// Test that a client not reading its responses does not stall the others
+BOOST_AUTO_TEST_CASE (QueryServer_slowClient)
+{
+    std::string filename = write_test_data("test_QueryServer_slowClient.txt", test_log());
+    std::string path     = "test_QueryServer_slowClient.sock";
+    cgi::QueryServer server (filename, cgi::TimeWindow(), 1000);
+
+    int status = -1;
+    std::thread thread ([&] () {
+            status = server.serve(path);
+        });
+
+    int slow = connect_client(path);
+    BOOST_REQUIRE (slow >= 0);
+    struct timeval timeout = { 5, 0 };
+    setsockopt(slow, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    /* Far more responses than socket buffers and pending output can hold */
+    std::string request;
+    for (std::size_t n=0; n<cgi::QueryServer::maxPendingSize/16; ++n) {
+        request += "MAX\n";
+    }
+    std::size_t sent = 0;
+    while (sent < request.size()) {
+        ssize_t n = send(slow, request.data()+sent, request.size()-sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            break;
+        }
+        sent += n;
+    }
+
+    /* Another client is answered meanwhile, rather than timing out */
+    int client = connect_client(path);
+    BOOST_REQUIRE (client >= 0);
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    std::string line = "AT 10:30\n";
+    BOOST_CHECK_EQUAL (send(client, line.data(), line.size(), 0), ssize_t(line.size()));
+
+    std::string response;
+    char data[256];
+    while (response.find('\n') == std::string::npos) {
+        ssize_t n = recv(client, data, sizeof(data), 0);
+        BOOST_REQUIRE (n > 0);
+        response.append(data, n);
+    }
+    BOOST_CHECK_EQUAL (response, "OK 3\n");
+
+    /* The slow client has been disconnected, short of its responses */
+    std::size_t received = 0;
+    for (ssize_t n=1; n > 0; ) {
+        n = recv(slow, data, sizeof(data), 0);
+        if (n > 0) {
+            received += n;
+        }
+    }
+    BOOST_CHECK (received < 4*request.size());
+
+    close(slow);
+    close(client);
+    server.stop();
+    thread.join();
+
+    BOOST_CHECK_EQUAL (status, 0);
+}
@@ -0,0 +1,192 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_ResultCache.cc
+ * \brief A collection of tests for the cgi::ResultCache class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_ResultCache
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/time.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <ResultCache.h>
+
+#include "TestData.h"
+
+/// Remove all entries from the cache in `directory`
+void clear_cache (const std::string& directory)
+{
+    cgi::ResultCache (directory, 0).evict();
+}
+
+//______________________________________________________________________________
+//                                                             ResultCache_hash
+
+/// Test hashing of byte sequences
+BOOST_AUTO_TEST_CASE (ResultCache_hash)
+{
+    std::string text ("08:00,11:00\n09:00,12:00\n10:00,13:00\n");
+
+    /* Stable across calls, sensitive to content, length and seed */
+    BOOST_CHECK_EQUAL (cgi::ResultCache::hash(text.data(), text.size()),
+                       cgi::ResultCache::hash(text.data(), text.size()));
+    BOOST_CHECK (cgi::ResultCache::hash(text.data(), text.size())
+                 != cgi::ResultCache::hash(text.data(), text.size()-1));
+    BOOST_CHECK (cgi::ResultCache::hash(text.data(), text.size())
+                 != cgi::ResultCache::hash(text.data(), text.size(), 1));
+
+    std::string other (text);
+    other[3] = '1';
+    BOOST_CHECK (cgi::ResultCache::hash(text.data(), text.size())
+                 != cgi::ResultCache::hash(other.data(), other.size()));
+
+    /* Any length, including the tail of less than eight bytes */
+    for (std::size_t n=1; n<=16; ++n) {
+        BOOST_CHECK (cgi::ResultCache::hash(text.data(), n)
+                     != cgi::ResultCache::hash(text.data(), n-1));
+    }
+}
+
+//______________________________________________________________________________
+//                                                              ResultCache_key
+
+/// Test keys derived from the contents of a file and the options
+BOOST_AUTO_TEST_CASE (ResultCache_key)
+{
+    std::vector<std::string> lines;
+    lines.push_back("08:00,11:00");
+    lines.push_back("09:00,12:00");
+
+    std::string key = cgi::ResultCache::key(write_test_data("test_ResultCache_a.txt", lines), "");
+
+    BOOST_CHECK_EQUAL (key.size(), 32u);
+    BOOST_CHECK_EQUAL (cgi::ResultCache::key("test_ResultCache_missing.txt", ""), "");
+
+    /* Same contents under a different name */
+    BOOST_CHECK_EQUAL (cgi::ResultCache::key(write_test_data("test_ResultCache_b.txt", lines), ""),
+                       key);
+
+    /* Different options */
+    BOOST_CHECK (cgi::ResultCache::key("test_ResultCache_a.txt", "from=0") != key);
+
+    /* Different contents */
+    lines.push_back("10:00,13:00");
+    BOOST_CHECK (cgi::ResultCache::key(write_test_data("test_ResultCache_a.txt", lines), "")
+                 != key);
+
+    std::remove("test_ResultCache_a.txt");
+    std::remove("test_ResultCache_b.txt");
+}
+
+//______________________________________________________________________________
+//                                                        ResultCache_storeLoad
+
+/// Test storing and looking up entries
+BOOST_AUTO_TEST_CASE (ResultCache_storeLoad)
+{
+    cgi::ResultCache cache ("test_ResultCache.d");
+    clear_cache(cache.directory());
+
+    std::string value;
+
+    BOOST_CHECK_EQUAL (cache.nofEntries(), 0u);
+    BOOST_CHECK (!cache.load("0123", value));
+    BOOST_CHECK (!cache.store("", "value"));
+
+    BOOST_CHECK (cache.store("0123", "first value"));
+    BOOST_CHECK (cache.store("4567", "second value"));
+    BOOST_CHECK_EQUAL (cache.nofEntries(), 2u);
+    BOOST_CHECK_EQUAL (cache.size(), 23u);
+
+    BOOST_CHECK (cache.load("0123", value));
+    BOOST_CHECK_EQUAL (value, "first value");
+    BOOST_CHECK (cache.load("4567", value));
+    BOOST_CHECK_EQUAL (value, "second value");
+
+    /* Replacing an entry */
+    BOOST_CHECK (cache.store("0123", "replaced"));
+    BOOST_CHECK (cache.load("0123", value));
+    BOOST_CHECK_EQUAL (value, "replaced");
+    BOOST_CHECK_EQUAL (cache.nofEntries(), 2u);
+
+    /* Entries persist across instances */
+    cgi::ResultCache other ("test_ResultCache.d");
+    BOOST_CHECK (other.load("4567", value));
+    BOOST_CHECK_EQUAL (value, "second value");
+
+    /* Removing an entry */
+    BOOST_CHECK (cache.remove("0123"));
+    BOOST_CHECK (!cache.remove("0123"));
+    BOOST_CHECK (!cache.load("0123", value));
+    BOOST_CHECK_EQUAL (cache.nofEntries(), 1u);
+
+    clear_cache(cache.directory());
+    BOOST_CHECK_EQUAL (cache.nofEntries(), 0u);
+}
+
+//______________________________________________________________________________
+//                                                            ResultCache_evict
+
+/// Test eviction of the least recently used entries
+BOOST_AUTO_TEST_CASE (ResultCache_evict)
+{
+    cgi::ResultCache cache ("test_ResultCache.d", 30);
+    clear_cache(cache.directory());
+
+    std::string value;
+
+    /* Entries of 10 bytes each; keep the times of use apart */
+    cache.store("a", "0123456789");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    cache.store("b", "0123456789");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    cache.store("c", "0123456789");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    BOOST_CHECK_EQUAL (cache.nofEntries(), 3u);
+
+    /* Using "a" makes "b" the least recently used entry */
+    BOOST_CHECK (cache.load("a", value));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    cache.store("d", "0123456789");
+    BOOST_CHECK_EQUAL (cache.nofEntries(), 3u);
+    BOOST_CHECK (cache.size() <= cache.maxSize());
+    BOOST_CHECK (!cache.load("b", value));
+    BOOST_CHECK (cache.load("a", value));
+    BOOST_CHECK (cache.load("c", value));
+    BOOST_CHECK (cache.load("d", value));
+
+    /* An entry larger than the cache itself is not retained */
+    cache.store("e", std::string(40, 'x'));
+    BOOST_CHECK (!cache.load("e", value));
+    BOOST_CHECK (cache.size() <= cache.maxSize());
+
+    /* Temporary files left behind by an interrupted store are evicted too,
+       while those possibly still being written are neither counted nor removed */
+    std::string leftover = cache.directory() + "/f.result.abc123.tmp";
+    std::string writing  = cache.directory() + "/g.result.def456.tmp";
+    std::ofstream (leftover.c_str()) << std::string(40, 'x');
+    std::ofstream (writing.c_str()) << std::string(40, 'x');
+    struct timeval old[2] = { { 1000000000, 0 }, { 1000000000, 0 } };
+    utimes(leftover.c_str(), old);
+    cache.store("f", "0123456789");
+    BOOST_CHECK (!std::ifstream(leftover.c_str()).is_open());
+    BOOST_CHECK (std::ifstream(writing.c_str()).is_open());
+    BOOST_CHECK (cache.load("f", value));
+
+    std::remove(writing.c_str());
+    clear_cache(cache.directory());
+}
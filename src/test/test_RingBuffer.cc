@@ -0,0 +1,120 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_RingBuffer.cc
+ * \brief A collection of tests for the cgi::RingBuffer class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_RingBuffer
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <RingBuffer.h>
+
+//______________________________________________________________________________
+//                                                        RingBuffer_constructor
+
+/// Test creation of object
+BOOST_AUTO_TEST_CASE (RingBuffer_constructor)
+{
+    cgi::RingBuffer<int> ring1 (1);
+    BOOST_CHECK_EQUAL (ring1.capacity(), 1u);
+    BOOST_CHECK_EQUAL (ring1.size(), 0u);
+    BOOST_CHECK (!ring1.isClosed());
+
+    /* Capacity is rounded up to a power of two */
+    cgi::RingBuffer<int> ring5 (5);
+    BOOST_CHECK_EQUAL (ring5.capacity(), 8u);
+}
+
+//______________________________________________________________________________
+//                                                           RingBuffer_tryPush
+
+/// Test the non-blocking operations on a single thread
+BOOST_AUTO_TEST_CASE (RingBuffer_tryPush)
+{
+    cgi::RingBuffer<std::string> ring (4);
+    std::string value;
+
+    BOOST_CHECK (!ring.tryPop(value));
+
+    /* Fill up, wrapping around the end of the slots */
+    for (int round=0; round<3; ++round) {
+        for (int n=0; n<4; ++n) {
+            value = std::to_string(n);
+            BOOST_CHECK (ring.tryPush(value));
+        }
+        value = "overflow";
+        BOOST_CHECK (!ring.tryPush(value));
+        BOOST_CHECK_EQUAL (value, "overflow");
+        BOOST_CHECK_EQUAL (ring.size(), 4u);
+
+        for (int n=0; n<4; ++n) {
+            BOOST_CHECK (ring.tryPop(value));
+            BOOST_CHECK_EQUAL (value, std::to_string(n));
+        }
+        BOOST_CHECK (!ring.tryPop(value));
+    }
+}
+
+//______________________________________________________________________________
+//                                                              RingBuffer_close
+
+/// Test that closing drains the remaining elements and rejects new ones
+BOOST_AUTO_TEST_CASE (RingBuffer_close)
+{
+    cgi::RingBuffer<int> ring (4);
+    int value = 0;
+
+    BOOST_CHECK (ring.push(1));
+    BOOST_CHECK (ring.push(2));
+    ring.close();
+
+    BOOST_CHECK (ring.isClosed());
+    BOOST_CHECK (!ring.push(3));
+    BOOST_CHECK (ring.pop(value));
+    BOOST_CHECK_EQUAL (value, 1);
+    BOOST_CHECK (ring.pop(value));
+    BOOST_CHECK_EQUAL (value, 2);
+    BOOST_CHECK (!ring.pop(value));
+}
+
+//______________________________________________________________________________
+//                                                            RingBuffer_threads
+
+/// Test passing elements from a producer to a consumer thread
+BOOST_AUTO_TEST_CASE (RingBuffer_threads)
+{
+    const int nofElements = 100000;
+    cgi::RingBuffer<int> ring (16);
+
+    std::thread producer ([&ring] () {
+            for (int n=0; n<nofElements; ++n) {
+                ring.push(n);
+            }
+            ring.close();
+        });
+
+    /* Elements arrive complete and in order */
+    std::vector<int> received;
+    int value = 0;
+    while (ring.pop(value)) {
+        received.push_back(value);
+    }
+    producer.join();
+
+    BOOST_CHECK_EQUAL (received.size(), std::size_t(nofElements));
+    bool ordered = true;
+    for (std::size_t n=0; n<received.size(); ++n) {
+        ordered = ordered && received[n] == int(n);
+    }
+    BOOST_CHECK (ordered);
+}
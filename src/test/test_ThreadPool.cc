@@ -0,0 +1,223 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_ThreadPool.cc
+ * \brief A collection of tests for the cgi::ThreadPool class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_ThreadPool
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <ThreadPool.h>
+
+//______________________________________________________________________________
+//                                                        ThreadPool_constructor
+
+/// Test creation of object
+BOOST_AUTO_TEST_CASE (ThreadPool_constructor)
+{
+    cgi::ThreadPool pool1 (1);
+    BOOST_CHECK_EQUAL (pool1.nofThreads(), 1u);
+
+    cgi::ThreadPool pool4 (4);
+    BOOST_CHECK_EQUAL (pool4.nofThreads(), 4u);
+
+    cgi::ThreadPool pool0;
+    BOOST_CHECK (pool0.nofThreads() >= 1u);
+    BOOST_CHECK (pool0.nofThreads() <= cgi::ThreadPool::maxNofThreads);
+}
+
+//______________________________________________________________________________
+//                                                        ThreadPool_parallelFor
+
+/// Test that every index is processed exactly once
+BOOST_AUTO_TEST_CASE (ThreadPool_parallelFor)
+{
+    for (std::size_t nofThreads=1; nofThreads<=4; ++nofThreads) {
+        cgi::ThreadPool pool (nofThreads);
+
+        std::vector<int> counts (10007, 0);
+        pool.parallelFor(0, counts.size(), [&] (std::size_t begin, std::size_t end) {
+                for (std::size_t n=begin; n<end; ++n) {
+                    ++counts[n];
+                }
+            }, 100);
+        BOOST_CHECK (std::count(counts.begin(), counts.end(), 1) == std::ptrdiff_t(counts.size()));
+
+        /* Empty range */
+        bool called = false;
+        pool.parallelFor(5, 5, [&] (std::size_t, std::size_t) { called = true; });
+        BOOST_CHECK (!called);
+    }
+}
+
+//______________________________________________________________________________
+//                                                         ThreadPool_singleThread
+
+/// Test that a single thread processes the chunks in order, on the caller
+BOOST_AUTO_TEST_CASE (ThreadPool_singleThread)
+{
+    cgi::ThreadPool pool (1);
+    std::thread::id caller = std::this_thread::get_id();
+
+    std::vector<std::pair<std::size_t,std::size_t> > chunks;
+    pool.parallelFor(0, 10, [&] (std::size_t begin, std::size_t end) {
+            BOOST_CHECK (std::this_thread::get_id() == caller);
+            chunks.push_back(std::make_pair(begin, end));
+        }, 3);
+
+    BOOST_CHECK_EQUAL (chunks.size(), 1u);
+    BOOST_CHECK_EQUAL (chunks[0].first, 0u);
+    BOOST_CHECK_EQUAL (chunks[0].second, 10u);
+}
+
+//______________________________________________________________________________
+//                                                     ThreadPool_parallelReduce
+
+/// Test reduction, including a non-commutative one
+BOOST_AUTO_TEST_CASE (ThreadPool_parallelReduce)
+{
+    cgi::ThreadPool pool (4);
+
+    long sum = pool.parallelReduce(1, 100001, 0L,
+                                   [] (std::size_t begin, std::size_t end) {
+                                       long result = 0;
+                                       for (std::size_t n=begin; n<end; ++n) {
+                                           result += n;
+                                       }
+                                       return result;
+                                   },
+                                   [] (long a, long b) { return a + b; });
+    BOOST_CHECK_EQUAL (sum, 5000050000L);
+
+    /* Chunks are combined in order */
+    std::vector<std::size_t> order = pool.parallelReduce(0, 1000, std::vector<std::size_t>(),
+                                   [] (std::size_t begin, std::size_t end) {
+                                       std::vector<std::size_t> result;
+                                       for (std::size_t n=begin; n<end; ++n) {
+                                           result.push_back(n);
+                                       }
+                                       return result;
+                                   },
+                                   [] (std::vector<std::size_t> a, const std::vector<std::size_t>& b) {
+                                       a.insert(a.end(), b.begin(), b.end());
+                                       return a;
+                                   }, 7);
+    BOOST_CHECK_EQUAL (order.size(), 1000u);
+    for (std::size_t n=0; n<order.size(); ++n) {
+        BOOST_CHECK_EQUAL (order[n], n);
+    }
+
+    BOOST_CHECK_EQUAL (pool.parallelReduce(3, 3, 17, [] (std::size_t, std::size_t) { return 0; },
+                                           [] (int a, int b) { return a + b; }), 17);
+}
+
+//______________________________________________________________________________
+//                                                          ThreadPool_nested
+
+/// Test parallel loops nested within the body of another one
+BOOST_AUTO_TEST_CASE (ThreadPool_nested)
+{
+    cgi::ThreadPool pool (3);
+
+    std::atomic<long> sum (0);
+    pool.parallelFor(0, 16, [&] (std::size_t begin, std::size_t end) {
+            for (std::size_t n=begin; n<end; ++n) {
+                pool.parallelFor(0, 1000, [&] (std::size_t b, std::size_t e) {
+                        sum += long(e - b);
+                    }, 10);
+            }
+        }, 1);
+
+    BOOST_CHECK_EQUAL (sum.load(), 16000L);
+}
+
+//______________________________________________________________________________
+//                                                         ThreadPool_exception
+
+/// Test that exceptions thrown by the loop body are passed on to the caller
+BOOST_AUTO_TEST_CASE (ThreadPool_exception)
+{
+    cgi::ThreadPool pool (4);
+
+    std::atomic<int> nofChunks (0);
+    BOOST_CHECK_THROW (pool.parallelFor(0, 100, [&] (std::size_t begin, std::size_t) {
+                ++nofChunks;
+                if (begin == 50) {
+                    throw "ERROR [test_ThreadPool] Chunk failed";
+                }
+            }, 10), const char*);
+    /* All chunks have completed before the exception is rethrown */
+    BOOST_CHECK_EQUAL (nofChunks.load(), 10);
+
+    /* The pool remains usable */
+    std::atomic<int> count (0);
+    pool.parallelFor(0, 100, [&] (std::size_t begin, std::size_t end) { count += int(end - begin); });
+    BOOST_CHECK_EQUAL (count.load(), 100);
+}
+
+//______________________________________________________________________________
+//                                                       ThreadPool_parallelSort
+
+/// Test that sorting is stable and agrees with std::stable_sort
+BOOST_AUTO_TEST_CASE (ThreadPool_parallelSort)
+{
+    std::srand(42);
+
+    std::vector<std::pair<int,std::size_t> > data;
+    for (std::size_t n=0; n<200000; ++n) {
+        data.push_back(std::make_pair(std::rand() % 1000, n));
+    }
+
+    auto byKey = [] (const std::pair<int,std::size_t>& a,
+                     const std::pair<int,std::size_t>& b) {
+        return a.first < b.first;
+    };
+
+    std::vector<std::pair<int,std::size_t> > expected (data);
+    std::stable_sort(expected.begin(), expected.end(), byKey);
+
+    for (std::size_t nofThreads=1; nofThreads<=5; nofThreads+=2) {
+        cgi::ThreadPool pool (nofThreads);
+        std::vector<std::pair<int,std::size_t> > sorted (data);
+        pool.parallelSort(sorted.begin(), sorted.end(), byKey);
+        BOOST_CHECK (sorted == expected);
+    }
+
+    /* Default comparison */
+    std::vector<int> values;
+    for (std::size_t n=0; n<100000; ++n) {
+        values.push_back(std::rand());
+    }
+    cgi::ThreadPool pool (4);
+    pool.parallelSort(values.begin(), values.end());
+    BOOST_CHECK (std::is_sorted(values.begin(), values.end()));
+}
+
+//______________________________________________________________________________
+//                                                           ThreadPool_global
+
+/// Test the process-wide pool
+BOOST_AUTO_TEST_CASE (ThreadPool_global)
+{
+    cgi::ThreadPool::setNofThreads(3);
+    BOOST_CHECK_EQUAL (cgi::ThreadPool::global().nofThreads(), 3u);
+
+    cgi::ThreadPool::setNofThreads(1);
+    BOOST_CHECK_EQUAL (cgi::ThreadPool::global().nofThreads(), 1u);
+
+    cgi::ThreadPool::setNofThreads(0);
+    BOOST_CHECK (cgi::ThreadPool::global().nofThreads() >= 1u);
+}
@@ -0,0 +1,192 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_TimeIndex.cc
+ * \brief A collection of tests for the cgi::TimeIndex class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_TimeIndex
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <LogData.h>
+#include <TimeIndex.h>
+
+#include "TestData.h"
+
+/// Get time of day in seconds, as used by the index
+std::int64_t seconds (const std::string& time)
+{
+    return cgi::DateTime(time, "%H:%M").rawtime();
+}
+
+/// Log sorted by time of entry, with a long visit in the first block
+std::vector<std::string> sorted_log ()
+{
+    std::vector<std::string> lines;
+    lines.push_back("08:00,09:00");
+    lines.push_back("08:10,12:00");
+    lines.push_back("09:00,09:30");
+    lines.push_back("09:10,09:40");
+    lines.push_back("10:00,10:30");
+    lines.push_back("10:10,10:40");
+    lines.push_back("11:00,11:30");
+    lines.push_back("11:10,11:40");
+    return lines;
+}
+
+//______________________________________________________________________________
+//                                                               TimeIndex_build
+
+/// Test building the index
+BOOST_AUTO_TEST_CASE(TimeIndex_build)
+{
+    std::string filename = write_test_data("test_TimeIndex_build.txt", sorted_log());
+
+    cgi::TimeIndex index (2);
+    BOOST_CHECK (index.build(filename));
+    BOOST_CHECK (index.isSorted());
+    BOOST_CHECK_EQUAL (index.nofBlocks(), 4u);
+    BOOST_CHECK_EQUAL (index.fileSize(), 8*12);
+
+    BOOST_CHECK_EQUAL (index[1].offset, 2*12);
+    BOOST_CHECK_EQUAL (index[1].firstEntry, seconds("09:00"));
+    BOOST_CHECK_EQUAL (index[0].maxExit, seconds("12:00"));
+    BOOST_CHECK_EQUAL (index[1].maxExit, seconds("09:40"));
+
+    BOOST_CHECK (!index.build("no_such_file.txt"));
+}
+
+//______________________________________________________________________________
+//                                                              TimeIndex_region
+
+/// Test selection of the region to read for a time window
+BOOST_AUTO_TEST_CASE(TimeIndex_region)
+{
+    std::string filename = write_test_data("test_TimeIndex_region.txt", sorted_log());
+
+    cgi::TimeIndex index (2);
+    index.build(filename);
+
+    /* Long visit in block 0 overlaps with the window */
+    std::pair<std::size_t,std::size_t> region
+        = index.region(cgi::TimeWindow(seconds("10:00"), seconds("10:20")));
+    BOOST_CHECK_EQUAL (region.first, 0u);
+    BOOST_CHECK_EQUAL (region.second, 6*12u);
+
+    /* Window after the long visit: leading blocks are skipped */
+    region = index.region(cgi::TimeWindow(seconds("12:00"), seconds("13:00")));
+    BOOST_CHECK_EQUAL (region.first, region.second);
+
+    cgi::TimeWindow window;
+    window.setEnd(seconds("09:00"));
+    region = index.region(window);
+    BOOST_CHECK_EQUAL (region.first, 0u);
+    BOOST_CHECK_EQUAL (region.second, 2*12u);
+
+    /* Unsorted log: always the whole file */
+    std::vector<std::string> lines = sorted_log();
+    std::swap(lines[0], lines[7]);
+    filename = write_test_data("test_TimeIndex_unsorted.txt", lines);
+    index.build(filename);
+    BOOST_CHECK (!index.isSorted());
+    region = index.region(cgi::TimeWindow(seconds("12:00"), seconds("13:00")));
+    BOOST_CHECK_EQUAL (region.first, 0u);
+    BOOST_CHECK_EQUAL (region.second, 8*12u);
+}
+
+//______________________________________________________________________________
+//                                                             TimeIndex_sidecar
+
+/// Test storing the index next to the log file
+BOOST_AUTO_TEST_CASE(TimeIndex_sidecar)
+{
+    std::string filename = write_test_data("test_TimeIndex_sidecar.txt", sorted_log());
+
+    cgi::TimeIndex index (2);
+    BOOST_CHECK (!index.load(filename));
+    BOOST_CHECK (cgi::TimeIndex::update(filename, 2));
+
+    BOOST_CHECK (index.load(filename));
+    BOOST_CHECK_EQUAL (index.stride(), 2u);
+    BOOST_CHECK_EQUAL (index.nofBlocks(), 4u);
+    BOOST_CHECK_EQUAL (index[3].firstEntry, seconds("11:00"));
+
+    /* Changing the log invalidates the sidecar */
+    {
+        std::ofstream outfile (filename, std::ios::app);
+        outfile << "12:00,12:30\n";
+    }
+    BOOST_CHECK (!index.load(filename));
+    BOOST_CHECK (cgi::TimeIndex::update(filename, 2));
+    BOOST_CHECK (index.load(filename));
+    BOOST_CHECK_EQUAL (index.nofBlocks(), 5u);
+}
+
+//______________________________________________________________________________
+//                                                             TimeIndex_corrupt
+
+/// Test rejecting a sidecar whose block count does not match its contents
+BOOST_AUTO_TEST_CASE(TimeIndex_corrupt)
+{
+    std::string filename = write_test_data("test_TimeIndex_corrupt.txt", sorted_log());
+    std::string sidecar  = cgi::TimeIndex::sidecarName(filename);
+    BOOST_CHECK (cgi::TimeIndex::update(filename, 2));
+
+    /* Block count, following the magic and five further header fields */
+    std::int64_t nofBlocks = std::int64_t(1) << 60;
+    {
+        std::fstream file (sidecar, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(8 + 5*sizeof(std::int64_t));
+        file.write(reinterpret_cast<const char*>(&nofBlocks), sizeof(nofBlocks));
+    }
+    cgi::TimeIndex index;
+    BOOST_CHECK (!index.load(filename));
+
+    /* Truncated list of blocks */
+    BOOST_CHECK (cgi::TimeIndex::update(filename, 2));
+    std::ifstream infile (sidecar, std::ios::binary);
+    std::string contents ((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+    infile.close();
+    {
+        std::ofstream outfile (sidecar, std::ios::binary | std::ios::trunc);
+        outfile.write(contents.data(), contents.size()-1);
+    }
+    BOOST_CHECK (!index.load(filename));
+}
+
+//______________________________________________________________________________
+//                                                             TimeIndex_logData
+
+/// Test reading a time window of an indexed log
+BOOST_AUTO_TEST_CASE(TimeIndex_logData)
+{
+    std::vector<std::string> lines = sorted_log();
+    std::string plain   = write_test_data("test_TimeIndex_plain.txt", lines);
+    std::string indexed = write_test_data("test_TimeIndex_indexed.txt", lines);
+    BOOST_CHECK (cgi::TimeIndex::update(indexed, 2));
+
+    cgi::LogData logPlain;
+    logPlain.setTimeWindow(cgi::DateTime("11:00", "%H:%M"), cgi::DateTime("11:20", "%H:%M"));
+    logPlain.readData(plain);
+
+    cgi::LogData logIndexed;
+    logIndexed.setTimeWindow(cgi::DateTime("11:00", "%H:%M"), cgi::DateTime("11:20", "%H:%M"));
+    logIndexed.readData(indexed);
+
+    BOOST_CHECK_EQUAL (logIndexed.size(), 3u);
+    BOOST_CHECK_EQUAL (logPlain.size(), logIndexed.size());
+    BOOST_CHECK (logPlain.timesEntry() == logIndexed.timesEntry());
+    BOOST_CHECK (logPlain.timesExit() == logIndexed.timesExit());
+}
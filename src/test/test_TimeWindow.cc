@@ -0,0 +1,56 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_TimeWindow.cc
+ * \brief A collection of tests for the cgi::TimeWindow class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_TimeWindow
+
+#include <iostream>
+#include <boost/test/unit_test.hpp>
+#include <TimeWindow.h>
+
+//______________________________________________________________________________
+//                                                         TimeWindow_unbounded
+
+/// Test default window, admitting everything
+BOOST_AUTO_TEST_CASE(TimeWindow_unbounded)
+{
+    cgi::TimeWindow window;
+
+    BOOST_CHECK (!window.isBounded());
+    BOOST_CHECK (window.admits(-100, 100));
+    BOOST_CHECK (window.admits(0, 0));
+
+    window.setEnd(50);
+    BOOST_CHECK (window.isBounded());
+    BOOST_CHECK (!window.hasBegin());
+    BOOST_CHECK (window.hasEnd());
+}
+
+//______________________________________________________________________________
+//                                                              TimeWindow_admits
+
+/// Test selection of visits overlapping with the window
+BOOST_AUTO_TEST_CASE(TimeWindow_admits)
+{
+    cgi::TimeWindow window (10, 20);
+
+    BOOST_CHECK (window.admits(5, 15));     /*  overlapping begin */
+    BOOST_CHECK (window.admits(15, 25));    /*  overlapping end */
+    BOOST_CHECK (window.admits(5, 25));     /*  spanning the window */
+    BOOST_CHECK (window.admits(12, 18));    /*  contained */
+    BOOST_CHECK (!window.admits(5, 10));    /*  leaving as the window opens */
+    BOOST_CHECK (!window.admits(20, 25));   /*  entering as the window closes */
+
+    /* Decision based on the time of entry alone */
+    BOOST_CHECK (!window.admitsEntry(20));
+    BOOST_CHECK (window.admitsEntry(-1000));
+
+    std::cout << window << std::endl;
+}
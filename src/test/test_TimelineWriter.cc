@@ -0,0 +1,244 @@
+/*----------------------------------------------------------------------------*/
+/* (c) Lars Baehren <lbaehren@gmail.com> (2015). All Rights Reserved.         */
+/* This software is distributed under the BSD 2-clause license.               */
+/*----------------------------------------------------------------------------*/
+
+/*!
+ * \file test_TimelineWriter.cc
+ * \brief A collection of tests for the cgi::TimelineWriter class.
+ */
+
+/// Name of Boost test module
+#define BOOST_TEST_MODULE test_TimelineWriter
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <TimelineWriter.h>
+
+//______________________________________________________________________________
+//                                                               write_test_data
+
+/// Write statistics in the given format to a file, returning its contents
+std::string write_test_data (const cgi::TimelineWriter::Format& format)
+{
+    /* 08:00 -> 1, 09:00 -> 2, 10:00 -> 1, 11:00 -> 0; maximum 09:00-10:00 */
+    std::time_t day = 1444600800;
+    std::vector<cgi::TimePoint> timeline;
+    timeline.push_back(cgi::TimePoint(cgi::DateTime(day +  8*3600), 1));
+    timeline.push_back(cgi::TimePoint(cgi::DateTime(day +  9*3600), 2));
+    timeline.push_back(cgi::TimePoint(cgi::DateTime(day + 10*3600), 1));
+    timeline.push_back(cgi::TimePoint(cgi::DateTime(day + 11*3600), 0));
+
+    cgi::IntervalSet<cgi::DateTime,int> maxima;
+    maxima.insert(cgi::DateTime(day + 9*3600), cgi::DateTime(day + 10*3600), 2);
+
+    std::string filename ("test_TimelineWriter.out");
+    int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    {
+        cgi::OutputBuffer output (fd);
+        cgi::TimelineWriter writer (output, format);
+        writer.write(timeline, maxima);
+    }
+    close(fd);
+
+    std::ifstream infile (filename.c_str(), std::ios::binary);
+    std::ostringstream os;
+    os << infile.rdbuf();
+    std::remove(filename.c_str());
+
+    return os.str();
+}
+
+//______________________________________________________________________________
+//                                                    TimelineWriter_parseFormat
+
+/// Test selection of the output format by name
+BOOST_AUTO_TEST_CASE (TimelineWriter_parseFormat)
+{
+    cgi::TimelineWriter::Format format = cgi::TimelineWriter::Challenge;
+
+    BOOST_CHECK (cgi::TimelineWriter::parseFormat("csv", format));
+    BOOST_CHECK_EQUAL (format, cgi::TimelineWriter::Csv);
+    BOOST_CHECK (cgi::TimelineWriter::parseFormat("json", format));
+    BOOST_CHECK_EQUAL (format, cgi::TimelineWriter::JsonLines);
+    BOOST_CHECK (cgi::TimelineWriter::parseFormat("binary", format));
+    BOOST_CHECK_EQUAL (format, cgi::TimelineWriter::Binary);
+    BOOST_CHECK (cgi::TimelineWriter::parseFormat("challenge", format));
+    BOOST_CHECK_EQUAL (format, cgi::TimelineWriter::Challenge);
+
+    BOOST_CHECK (!cgi::TimelineWriter::parseFormat("xml", format));
+    BOOST_CHECK_EQUAL (format, cgi::TimelineWriter::Challenge);
+}
+
+//______________________________________________________________________________
+//                                                      TimelineWriter_challenge
+
+/// Test the layout of the programming challenge
+BOOST_AUTO_TEST_CASE (TimelineWriter_challenge)
+{
+    std::string result = write_test_data(cgi::TimelineWriter::Challenge);
+    std::time_t day    = 1444600800;
+
+    std::string expected = "\n Visitors per time interval:\n\t"
+        + cgi::DateTime(day + 8*3600).asString("%H:%M") + "-"
+        + cgi::DateTime(day + 9*3600).asString("%H:%M") + ";1\n";
+
+    BOOST_CHECK_EQUAL (result.compare(0, expected.size(), expected), 0);
+    BOOST_CHECK (result.find("\n Maximum number of visitors:\n") != std::string::npos);
+    BOOST_CHECK (result.find("  =>  2\n") != std::string::npos);
+
+    /* Three intervals, plus two headers and one maximum */
+    BOOST_CHECK_EQUAL (std::count(result.begin(), result.end(), '\n'), 8);
+}
+
+//______________________________________________________________________________
+//                                                            TimelineWriter_csv
+
+/// Test output as comma-separated values and as JSON lines
+BOOST_AUTO_TEST_CASE (TimelineWriter_csv)
+{
+    BOOST_CHECK_EQUAL (write_test_data(cgi::TimelineWriter::Csv),
+                       "kind,begin,end,visitors\n"
+                       "step,1444629600,1444633200,1\n"
+                       "step,1444633200,1444636800,2\n"
+                       "step,1444636800,1444640400,1\n"
+                       "max,1444633200,1444636800,2\n");
+
+    BOOST_CHECK_EQUAL (write_test_data(cgi::TimelineWriter::JsonLines),
+                       "{\"kind\":\"step\",\"begin\":1444629600,\"end\":1444633200,\"visitors\":1}\n"
+                       "{\"kind\":\"step\",\"begin\":1444633200,\"end\":1444636800,\"visitors\":2}\n"
+                       "{\"kind\":\"step\",\"begin\":1444636800,\"end\":1444640400,\"visitors\":1}\n"
+                       "{\"kind\":\"max\",\"begin\":1444633200,\"end\":1444636800,\"visitors\":2}\n");
+}
+
+//______________________________________________________________________________
+//                                                         TimelineWriter_binary
+
+/// Test output of the raw binary timeline
+BOOST_AUTO_TEST_CASE (TimelineWriter_binary)
+{
+    std::string result = write_test_data(cgi::TimelineWriter::Binary);
+
+    /* Identifier, header, 4 times, 4 counts and one maximum */
+    BOOST_REQUIRE_EQUAL (result.size(), 8u + 3*8 + 4*8 + 4*4 + 2*8);
+    BOOST_CHECK_EQUAL (result.substr(0, 8), "CGITL001");
+
+    std::int64_t header[3];
+    std::int64_t times[4];
+    std::int32_t counts[4];
+    std::int64_t maxima[2];
+    const char* it = result.data() + 8;
+    std::memcpy(header, it, sizeof(header));  it += sizeof(header);
+    std::memcpy(times,  it, sizeof(times));   it += sizeof(times);
+    std::memcpy(counts, it, sizeof(counts));  it += sizeof(counts);
+    std::memcpy(maxima, it, sizeof(maxima));
+
+    BOOST_CHECK_EQUAL (header[0], 4);
+    BOOST_CHECK_EQUAL (header[1], 1);
+    BOOST_CHECK_EQUAL (header[2], 2);
+    BOOST_CHECK_EQUAL (times[0], 1444629600);
+    BOOST_CHECK_EQUAL (times[3], 1444640400);
+    BOOST_CHECK_EQUAL (counts[1], 2);
+    BOOST_CHECK_EQUAL (counts[3], 0);
+    BOOST_CHECK_EQUAL (maxima[0], 1444633200);
+    BOOST_CHECK_EQUAL (maxima[1], 1444636800);
+}
+
+//______________________________________________________________________________
+//                                                           TimelineWriter_bins
+
+/// Test output of the number of visitors downsampled to time bins
+BOOST_AUTO_TEST_CASE (TimelineWriter_bins)
+{
+    cgi::OccupancyBins bins (3600, 1444629600);
+    bins.add(1444629600, 1444631400, 1);
+    bins.add(1444631400, 1444633200, 2);
+    bins.add(1444633200, 1444636800, 2);
+
+    cgi::IntervalSet<cgi::DateTime,int> maxima;
+    maxima.insert(cgi::DateTime(1444631400), cgi::DateTime(1444636800), 2);
+
+    std::string filename ("test_TimelineWriter_bins.out");
+    int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    {
+        cgi::OutputBuffer output (fd);
+        cgi::TimelineWriter writer (output, cgi::TimelineWriter::Csv);
+        writer.write(bins, maxima);
+    }
+    close(fd);
+
+    std::ifstream infile (filename.c_str(), std::ios::binary);
+    std::ostringstream os;
+    os << infile.rdbuf();
+    std::remove(filename.c_str());
+
+    BOOST_CHECK_EQUAL (os.str(),
+                       "kind,begin,end,min,mean,max\n"
+                       "bin,1444629600,1444633200,1,1.50,2\n"
+                       "bin,1444633200,1444636800,2,2.00,2\n"
+                       "max,1444631400,1444636800,2,2,2\n");
+}
+
+//______________________________________________________________________________
+//                                                     TimelineWriter_binaryBins
+
+/// Test output of time bins as raw binary data, skipping uncovered bins
+BOOST_AUTO_TEST_CASE (TimelineWriter_binaryBins)
+{
+    /* Bins at 00:00 and 02:00 are covered, the one at 01:00 is not */
+    cgi::OccupancyBins bins (3600, 1444629600);
+    bins.add(1444629600, 1444633200, 1);
+    bins.add(1444636800, 1444640400, 3);
+
+    cgi::IntervalSet<cgi::DateTime,int> maxima;
+    maxima.insert(cgi::DateTime(1444636800), cgi::DateTime(1444640400), 3);
+
+    std::string filename ("test_TimelineWriter_binaryBins.out");
+    int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    {
+        cgi::OutputBuffer output (fd);
+        cgi::TimelineWriter writer (output, cgi::TimelineWriter::Binary);
+        writer.write(bins, maxima);
+    }
+    close(fd);
+
+    std::ifstream infile (filename.c_str(), std::ios::binary);
+    std::ostringstream os;
+    os << infile.rdbuf();
+    std::remove(filename.c_str());
+    std::string result = os.str();
+
+    /* Magic, header, 2 begins, 2 means, 2 minima, 2 maxima, 1 maximum */
+    BOOST_REQUIRE_EQUAL (result.size(), 8u + 4*8 + 2*8 + 2*8 + 2*4 + 2*4 + 2*8);
+    BOOST_CHECK_EQUAL (result.substr(0, 8), "CGIBN001");
+
+    std::int64_t header[4];
+    std::memcpy(header, result.data()+8, sizeof(header));
+    BOOST_CHECK_EQUAL (header[0], 2);
+    BOOST_CHECK_EQUAL (header[1], 1);
+    BOOST_CHECK_EQUAL (header[2], 3);
+    BOOST_CHECK_EQUAL (header[3], 3600);
+
+    std::int64_t begins[2];
+    std::int32_t extrema[4];
+    std::memcpy(begins, result.data()+40, sizeof(begins));
+    std::memcpy(extrema, result.data()+72, sizeof(extrema));
+    BOOST_CHECK_EQUAL (begins[0], 1444629600);
+    BOOST_CHECK_EQUAL (begins[1], 1444636800);
+    BOOST_CHECK_EQUAL (extrema[0], 1);
+    BOOST_CHECK_EQUAL (extrema[1], 3);
+    BOOST_CHECK_EQUAL (extrema[2], 1);
+    BOOST_CHECK_EQUAL (extrema[3], 3);
+}